@@ -0,0 +1,481 @@
+/**
+ * bench_pycnp.cpp
+ *
+ * Micro and macro benchmarks for the PyCNP C++ core.
+ *
+ * Every benchmark runs on a fixed instance with fixed seeds, so repeated
+ * runs time the same work and report the same objective values. Results are
+ * written as JSON: one record per benchmark with per-call timings, plus the
+ * objective value where the benchmark produces a solution, so quality
+ * regressions show up next to speed regressions.
+ *
+ * Build with ``-Dbenchmarks=true`` and run through meson:
+ *
+ *     meson test -C build --benchmark -v
+ *
+ * or directly:
+ *
+ *     pycnp_bench --instances Instances --output bench.json
+ *                 [--min-time 0.5] [--filter CNP/Bovine]
+ */
+
+#include "Graph/Graph.h"
+#include "ProblemData.h"
+#include "crossover/doubleBackboneBasedCrossover.h"
+#include "crossover/inherit_repair_recombination.h"
+#include "crossover/reduceSolveCombine.h"
+#include "search/Search.h"
+
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+constexpr int SEED = 42;
+
+/// Iterations every benchmark runs, however long they take.
+constexpr size_t MIN_ITERATIONS = 3;
+
+struct Options
+{
+    std::string instances = "Instances";
+    std::string output;
+    std::string filter;
+    double minTime = 0.5;  ///< Seconds of timed calls per benchmark
+};
+
+struct Measurement
+{
+    std::string name;
+    size_t iterations = 0;
+    double meanNs = 0;
+    double medianNs = 0;
+    double minNs = 0;
+    double maxNs = 0;
+    std::optional<ObjValue> objective;
+    std::optional<double> stepsPerSec;
+};
+
+/// Instances and budgets. CNP budgets are the usual ones from the
+/// literature; DCNP budgets are 10% of the nodes, with hop distance 3.
+struct Instance
+{
+    const char *problem;
+    const char *path;
+    int budget;
+    int hopDistance;
+};
+
+const Instance INSTANCES[] = {
+    {"CNP", "CNP/realworld/Bovine.txt", 3, 0},
+    {"CNP", "CNP/realworld/Circuit.txt", 25, 0},
+    {"CNP", "CNP/realworld/Ecoli.txt", 15, 0},
+    {"CNP", "CNP/realworld/USAir97.txt", 33, 0},
+    {"DCNP", "DCNP/R2/Bovine.txt", 12, 3},
+    {"DCNP", "DCNP/R2/Circuit.txt", 25, 3},
+    {"DCNP", "DCNP/R2/Ecoli.txt", 32, 3},
+};
+
+class Runner
+{
+public:
+    explicit Runner(Options options) : options_(std::move(options)) {}
+
+    /**
+     * Times ``body`` repeatedly; ``setup`` runs before every call and is not
+     * timed. ``body`` may return an objective value to record, and report
+     * local search steps through addSteps().
+     */
+    void run(const std::string &name,
+             const std::function<void()> &setup,
+             const std::function<std::optional<ObjValue>()> &body)
+    {
+        if (!options_.filter.empty()
+            && name.find(options_.filter) == std::string::npos)
+        {
+            return;
+        }
+
+        using Clock = std::chrono::steady_clock;
+        std::vector<double> samples;
+        double total = 0;
+        Measurement measurement;
+        measurement.name = name;
+        steps_ = 0;
+
+        while (samples.size() < MIN_ITERATIONS || total < options_.minTime * 1e9)
+        {
+            setup();
+            const auto start = Clock::now();
+            std::optional<ObjValue> objective = body();
+            const auto stop = Clock::now();
+
+            const double elapsed
+                = std::chrono::duration<double, std::nano>(stop - start).count();
+            samples.push_back(elapsed);
+            total += elapsed;
+            if (objective)
+            {
+                measurement.objective = objective;
+            }
+        }
+
+        std::sort(samples.begin(), samples.end());
+        measurement.iterations = samples.size();
+        measurement.meanNs = total / samples.size();
+        measurement.medianNs = samples[samples.size() / 2];
+        measurement.minNs = samples.front();
+        measurement.maxNs = samples.back();
+        if (steps_ > 0)
+        {
+            measurement.stepsPerSec = steps_ / (total * 1e-9);
+        }
+
+        std::cerr << name << ": " << measurement.medianNs << " ns median over "
+                  << measurement.iterations << " calls";
+        if (measurement.stepsPerSec)
+        {
+            std::cerr << ", " << *measurement.stepsPerSec << " steps/s";
+        }
+        std::cerr << '\n';
+        results_.push_back(std::move(measurement));
+    }
+
+    /// Convenience for benchmarks without per-call setup.
+    void run(const std::string &name, const std::function<std::optional<ObjValue>()> &body)
+    {
+        run(name, [] {}, body);
+    }
+
+    /// Adds local search steps made by the current call.
+    void addSteps(long steps) { steps_ += steps; }
+
+    const Options &options() const { return options_; }
+
+    void writeJson(std::ostream &out) const;
+
+private:
+    Options options_;
+    std::vector<Measurement> results_;
+    long steps_ = 0;  ///< Steps reported by the current benchmark
+};
+
+std::string quoted(const std::string &text)
+{
+    std::string result = "\"";
+    for (char c : text)
+    {
+        if (c == '"' || c == '\\')
+        {
+            result += '\\';
+        }
+        result += c;
+    }
+    return result + '"';
+}
+
+void Runner::writeJson(std::ostream &out) const
+{
+    char date[32];
+    const std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+    out << "{\n  \"context\": {\n";
+    out << "    \"date\": " << quoted(date) << ",\n";
+    out << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n";
+    out << "    \"seed\": " << SEED << ",\n";
+    out << "    \"min_time\": " << options_.minTime << ",\n";
+#if defined(__VERSION__)
+    out << "    \"compiler\": " << quoted(__VERSION__) << ",\n";
+#endif
+#if defined(NDEBUG)
+    out << "    \"assertions\": false\n";
+#else
+    out << "    \"assertions\": true\n";
+#endif
+    out << "  },\n  \"benchmarks\": [";
+
+    for (size_t i = 0; i < results_.size(); ++i)
+    {
+        const Measurement &m = results_[i];
+        out << (i ? ",\n" : "\n") << "    {";
+        out << "\"name\": " << quoted(m.name);
+        out << ", \"iterations\": " << m.iterations;
+        out << ", \"mean_ns\": " << m.meanNs;
+        out << ", \"median_ns\": " << m.medianNs;
+        out << ", \"min_ns\": " << m.minNs;
+        out << ", \"max_ns\": " << m.maxNs;
+        if (m.objective)
+        {
+            out << ", \"objective\": " << *m.objective;
+        }
+        if (m.stepsPerSec)
+        {
+            out << ", \"steps_per_sec\": " << *m.stepsPerSec;
+        }
+        out << "}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+/// Nodes that are not removed, in order.
+std::vector<Node> activeNodes(const Graph &graph)
+{
+    std::vector<Node> nodes;
+    for (Node node = 0; node < graph.getNumNodes(); ++node)
+    {
+        if (!graph.isNodeRemoved(node))
+        {
+            nodes.push_back(node);
+        }
+    }
+    return nodes;
+}
+
+void benchmarkInstance(Runner &runner, const Instance &instance)
+{
+    const std::string problem = instance.problem;
+    const bool isDCNP = problem == "DCNP";
+    const std::string file = instance.path;
+    const size_t stem = file.rfind('/') + 1;
+    const std::string prefix
+        = problem + "/" + file.substr(stem, file.rfind('.') - stem);
+
+    const ProblemData data
+        = ProblemData::readFromFile(runner.options().instances + "/" + file);
+    auto original = data.createOriginalGraph(
+        problem, instance.budget, SEED, instance.hopDistance);
+
+    // A feasible start shared by the graph-level benchmarks. Graph state
+    // changed by a benchmark is restored or rebuilt from this template.
+    const auto feasible = original->getRandomFeasibleGraph();
+    const std::vector<Node> nodes = activeNodes(*feasible);
+
+    std::vector<Solution> parents;
+    for (int i = 0; i < 3; ++i)
+    {
+        parents.push_back(original->getRandomFeasibleGraph()->getRemovedNodes());
+    }
+
+    // Moves: remove a node and add it back, cycling through the nodes.
+    {
+        auto graph = feasible->clone();
+        size_t next = 0;
+        runner.run(prefix + "/removeNode+addNode",
+                   [&]() -> std::optional<ObjValue>
+                   {
+                       const Node node = nodes[next++ % nodes.size()];
+                       graph->removeNode(node);
+                       graph->addNode(node);
+                       return std::nullopt;
+                   });
+    }
+
+    // Selections are cached inside the graph, so each call gets a fresh
+    // copy of the start state.
+    std::unique_ptr<Graph> graph;
+    auto fresh = [&] { graph = feasible->clone(); };
+
+    if (!isDCNP)
+    {
+        runner.run(prefix + "/greedySelectNodeToAdd",
+                   fresh,
+                   [&]() -> std::optional<ObjValue>
+                   {
+                       graph->greedySelectNodeToAdd();
+                       return std::nullopt;
+                   });
+
+        const ComponentIndex component = feasible->clone()->selectRemovedComponent();
+        runner.run(prefix + "/impactSelectNodeFromComponent",
+                   fresh,
+                   [&]() -> std::optional<ObjValue>
+                   {
+                       graph->impactSelectNodeFromComponent(component);
+                       return std::nullopt;
+                   });
+    }
+    else
+    {
+        runner.run(prefix + "/buildTree",
+                   fresh,
+                   [&]() -> std::optional<ObjValue>
+                   {
+                       graph->buildTree();
+                       return graph->getObjectiveValue();
+                   });
+
+        runner.run(prefix + "/findBestNodeToAdd",
+                   fresh,
+                   [&]() -> std::optional<ObjValue>
+                   {
+                       graph->findBestNodeToAdd();
+                       return std::nullopt;
+                   });
+
+        runner.run(prefix + "/calculateBetweennessCentrality",
+                   [&]() -> std::optional<ObjValue>
+                   {
+                       feasible->calculateBetweennessCentrality(
+                           instance.hopDistance);
+                       return std::nullopt;
+                   });
+    }
+
+    // Crossovers from fixed parents and seed.
+    runner.run(prefix + "/crossover/DBX",
+               [&]() -> std::optional<ObjValue>
+               {
+                   return doubleBackboneBasedCrossover(
+                              *original, {&parents[0], &parents[1]}, SEED)
+                       ->getObjectiveValue();
+               });
+
+    runner.run(prefix + "/crossover/RSC",
+               [&]() -> std::optional<ObjValue>
+               {
+                   return reduceSolveCombine(*original,
+                                             {&parents[0], &parents[1]},
+                                             isDCNP ? "BCLS" : "CHNS",
+                                             0.9,
+                                             SEED)
+                       ->getObjectiveValue();
+               });
+
+    runner.run(prefix + "/crossover/IRR",
+               [&]() -> std::optional<ObjValue>
+               {
+                   return inherit_repair_recombination(
+                              *original,
+                              {&parents[0], &parents[1], &parents[2]},
+                              SEED)
+                       ->getObjectiveValue();
+               });
+
+    // Full local searches from the feasible start.
+    const std::vector<std::string> strategies
+        = isDCNP ? std::vector<std::string>{"BCLS"}
+                 : std::vector<std::string>{"CBNS", "CHNS", "DLAS"};
+    for (const std::string &strategy : strategies)
+    {
+        std::unique_ptr<Search> search;
+        runner.run(prefix + "/Search/" + strategy,
+                   [&]
+                   {
+                       fresh();
+                       search = std::make_unique<Search>(*graph, SEED);
+                       search->setStrategy(strategy);
+                   },
+                   [&]() -> std::optional<ObjValue>
+                   {
+                       const SearchResult result = search->run();
+                       runner.addSteps(result.numSteps);
+                       return result.objValue;
+                   });
+    }
+
+    // DLAS with growing late acceptance histories; steps per second should
+    // not depend on the history length.
+    if (!isDCNP)
+    {
+        for (int historyLength : {5, 50, 500, 5000})
+        {
+            std::unique_ptr<Search> search;
+            runner.run(prefix + "/Search/DLAS/historyLength="
+                           + std::to_string(historyLength),
+                       [&]
+                       {
+                           fresh();
+                           search = std::make_unique<Search>(*graph, SEED);
+                           search->setStrategy("DLAS");
+                           search->setParam("historyLength", historyLength);
+                       },
+                       [&]() -> std::optional<ObjValue>
+                       {
+                           const SearchResult result = search->run();
+                           runner.addSteps(result.numSteps);
+                           return result.objValue;
+                       });
+        }
+    }
+}
+
+Options parseOptions(int argc, char **argv)
+{
+    Options options;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (i + 1 >= argc)
+        {
+            throw std::invalid_argument("missing value for " + arg);
+        }
+
+        const std::string value = argv[++i];
+        if (arg == "--instances")
+        {
+            options.instances = value;
+        }
+        else if (arg == "--output")
+        {
+            options.output = value;
+        }
+        else if (arg == "--filter")
+        {
+            options.filter = value;
+        }
+        else if (arg == "--min-time")
+        {
+            options.minTime = std::stod(value);
+        }
+        else
+        {
+            throw std::invalid_argument("unknown option " + arg);
+        }
+    }
+    return options;
+}
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    try
+    {
+        Runner runner(parseOptions(argc, argv));
+        for (const Instance &instance : INSTANCES)
+        {
+            benchmarkInstance(runner, instance);
+        }
+
+        if (runner.options().output.empty())
+        {
+            runner.writeJson(std::cout);
+        }
+        else
+        {
+            std::ofstream out(runner.options().output);
+            if (!out)
+            {
+                throw std::runtime_error("Cannot write " + runner.options().output);
+            }
+            runner.writeJson(out);
+        }
+    }
+    catch (const std::exception &error)
+    {
+        std::cerr << "pycnp_bench: " << error.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
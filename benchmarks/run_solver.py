@@ -0,0 +1,418 @@
+"""
+End-to-end solver benchmark runner.
+
+Sweeps instances x local search strategy x crossover x seed, solving each
+combination with a fixed time limit, and writes:
+
+``runs.jsonl``
+    One record per run: best objective, ``best_found_at_time``, iterations
+    and local search steps per second, peak RSS, and the trajectory of
+    improvements as ``[time, objective]`` pairs. A run that raised records
+    the exception in ``error`` instead, and the sweep carries on.
+``ttt.csv``
+    Time-to-target samples per configuration. The target of an instance is
+    the best objective over all its runs, relaxed by ``--target-gap`` (1% by
+    default, so the target is not reached by a single lucky run only). Each
+    row gives the sorted time-to-target of one run and its empirical
+    probability ``(i - 0.5) / n``; runs that miss the target or fail have
+    time ``inf``.
+``profile.csv``
+    Dolan-More performance profile over instances: for every configuration,
+    the fraction of instances whose median time-to-target is within a factor
+    ``tau`` of the best configuration.
+
+Runs execute in separate worker processes (``--jobs``), one process per run,
+so the peak RSS of a run is not inflated by earlier ones.
+
+Examples
+--------
+Run the default suite for 10 seconds per run and 5 seeds::
+
+    python benchmarks/run_solver.py --time-limit 10 --seeds 5 --jobs 4
+
+Benchmark a single instance, given as ``PROBLEM:PATH:BUDGET[:HOP_DISTANCE]``::
+
+    python benchmarks/run_solver.py \\
+        --instance CNP:Instances/CNP/realworld/Ecoli.txt:15 \\
+        --strategies CHNS,DLAS --crossovers RSC
+"""
+
+from __future__ import annotations
+
+import argparse
+import csv
+import json
+import math
+import multiprocessing
+import pathlib
+import statistics
+import sys
+import time
+from dataclasses import dataclass
+from itertools import product
+from typing import Optional
+
+ROOT = pathlib.Path(__file__).resolve().parent.parent
+
+STRATEGIES = {"CNP": ["CBNS", "CHNS", "DLAS"], "DCNP": ["BCLS"]}
+CROSSOVERS = ["DBX", "RSC", "IRR"]
+
+# Crossovers restricted to some problem types; the others apply to all.
+CROSSOVER_PROBLEMS = {"IRR": ["DCNP"]}
+
+# Same instances as the C++ benchmarks: the usual CNP budgets, and 10% of
+# the nodes with hop distance 3 for DCNP.
+DEFAULT_INSTANCES = [
+    "CNP:Instances/CNP/realworld/Bovine.txt:3",
+    "CNP:Instances/CNP/realworld/Circuit.txt:25",
+    "CNP:Instances/CNP/realworld/Ecoli.txt:15",
+    "CNP:Instances/CNP/realworld/USAir97.txt:33",
+    "DCNP:Instances/DCNP/R2/Bovine.txt:12:3",
+    "DCNP:Instances/DCNP/R2/Circuit.txt:25:3",
+    "DCNP:Instances/DCNP/R2/Ecoli.txt:32:3",
+]
+
+
+@dataclass(frozen=True)
+class Instance:
+    problem: str
+    path: str
+    budget: int
+    hop_distance: int
+
+    @property
+    def name(self) -> str:
+        return f"{self.problem}/{pathlib.Path(self.path).stem}"
+
+    @staticmethod
+    def parse(spec: str) -> "Instance":
+        # Numbers are taken from the end, so paths may contain colons.
+        problem, _, rest = spec.partition(":")
+        parts = rest.split(":")
+        numbers = []
+        while len(parts) > 1 and len(numbers) < 2 and parts[-1].isdigit():
+            numbers.insert(0, int(parts.pop()))
+        if problem not in STRATEGIES or not numbers:
+            raise argparse.ArgumentTypeError(
+                f"expected PROBLEM:PATH:BUDGET[:HOP_DISTANCE], got {spec!r}"
+            )
+
+        path = pathlib.Path(":".join(parts))
+        if not path.is_absolute():
+            path = ROOT / path
+        hop_distance = numbers[1] if len(numbers) == 2 else 0
+        return Instance(problem, str(path), numbers[0], hop_distance)
+
+
+@dataclass(frozen=True)
+class Task:
+    instance: Instance
+    strategy: str
+    crossover: str
+    seed: int
+    time_limit: float
+
+
+def _peak_rss_kb() -> Optional[int]:
+    try:
+        import resource
+    except ImportError:  # Windows
+        return None
+
+    peak = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+    # Linux reports kilobytes, macOS bytes.
+    return peak // 1024 if sys.platform == "darwin" else peak
+
+
+def run_task(task: Task) -> dict:
+    """
+    Solves one configuration and returns its run record.
+    """
+    from pycnp import MemeticSearch, MemeticSearchParams, read
+    from pycnp.stop import MaxRuntime
+
+    instance = task.instance
+    problem_data = read(instance.path)
+
+    if task.crossover == "RSC":
+        params = MemeticSearchParams(
+            search=task.strategy,
+            reduce_params={"search": task.strategy, "beta": 0.9},
+        )
+    elif task.crossover == "IRR":
+        # IRR recombines exactly three parents, so it needs a fixed-size
+        # population of three.
+        params = MemeticSearchParams(
+            search=task.strategy,
+            crossover=task.crossover,
+            is_problem_reduction=False,
+            is_pop_variable=False,
+            initial_pop_size=3,
+        )
+    else:
+        params = MemeticSearchParams(
+            search=task.strategy,
+            crossover=task.crossover,
+            is_problem_reduction=False,
+        )
+
+    kwargs = {"hop_distance": instance.hop_distance} if instance.hop_distance else {}
+    search = MemeticSearch(
+        problem_data, instance.problem, instance.budget, task.seed, params, **kwargs
+    )
+
+    start = time.perf_counter()
+    result = search.run(MaxRuntime(task.time_limit), collect_stats=True)
+    elapsed = time.perf_counter() - start
+
+    # Statistics store per-iteration durations; their running sum is the
+    # time since the run started. The last improvement is timed exactly.
+    trajectory = []
+    clock = 0.0
+    for datum in result.stats.data:
+        clock += datum.runtime
+        if not trajectory or datum.best_obj_value < trajectory[-1][1]:
+            trajectory.append([clock, datum.best_obj_value])
+    if not trajectory or trajectory[-1][1] > result.best_obj_value:
+        trajectory.append([result.best_found_at_time, result.best_obj_value])
+    else:
+        trajectory[-1][0] = min(trajectory[-1][0], result.best_found_at_time)
+
+    runtime = result.runtime or elapsed
+    return {
+        **_task_record(task),
+        "best_obj_value": result.best_obj_value,
+        "best_found_at_time": result.best_found_at_time,
+        "runtime": runtime,
+        "num_iterations": result.num_iterations,
+        "iterations_per_sec": result.num_iterations / runtime,
+        "num_search_steps": result.num_search_steps,
+        "search_steps_per_sec": result.num_search_steps / runtime,
+        "peak_rss_kb": _peak_rss_kb(),
+        "trajectory": trajectory,
+    }
+
+
+def _task_record(task: Task) -> dict:
+    instance = task.instance
+    return {
+        "instance": instance.name,
+        "problem": instance.problem,
+        "budget": instance.budget,
+        "hop_distance": instance.hop_distance,
+        "strategy": task.strategy,
+        "crossover": task.crossover,
+        "seed": task.seed,
+        "time_limit": task.time_limit,
+    }
+
+
+def run_task_safely(task: Task) -> dict:
+    """
+    Runs :func:`run_task`, turning an exception into a failed run record so
+    that one bad configuration does not abort the whole sweep.
+    """
+    try:
+        return run_task(task)
+    except Exception as exc:
+        return {
+            **_task_record(task),
+            "error": f"{type(exc).__name__}: {exc}",
+            "trajectory": [],
+        }
+
+
+def time_to_target(run: dict, target: float) -> float:
+    """
+    Returns the first time the run reached ``target``, or ``inf``.
+    """
+    for t, obj in run["trajectory"]:
+        if obj <= target:
+            return t
+    return math.inf
+
+
+def _config(run: dict) -> str:
+    return f"{run['strategy']}+{run['crossover']}"
+
+
+def analyse(runs: list[dict], target_gap: float) -> tuple[list[dict], list[dict]]:
+    """
+    Computes time-to-target rows and the performance profile.
+    """
+    by_instance: dict[str, list[dict]] = {}
+    for run in runs:
+        by_instance.setdefault(run["instance"], []).append(run)
+
+    ttt_rows = []
+    medians: dict[str, dict[str, float]] = {}  # instance -> config -> time
+    for name, instance_runs in by_instance.items():
+        # Failed runs have no objective; they never reach the target.
+        best = min(
+            (run["best_obj_value"] for run in instance_runs if "error" not in run),
+            default=math.inf,
+        )
+        target = best * (1 + target_gap)
+
+        by_config: dict[str, list[float]] = {}
+        for run in instance_runs:
+            by_config.setdefault(_config(run), []).append(
+                time_to_target(run, target)
+            )
+
+        for config, times in sorted(by_config.items()):
+            times.sort()
+            for idx, t in enumerate(times, 1):
+                ttt_rows.append(
+                    {
+                        "instance": name,
+                        "config": config,
+                        "target": target,
+                        "time": t,
+                        "probability": (idx - 0.5) / len(times),
+                    }
+                )
+            medians.setdefault(name, {})[config] = statistics.median(times)
+
+    configs = sorted({config for times in medians.values() for config in times})
+    ratios: dict[str, list[float]] = {config: [] for config in configs}
+    for times in medians.values():
+        fastest = min(times.values())
+        # Configurations that do not apply to an instance (a strategy for
+        # the other problem type) are left out of its profile.
+        for config, t in times.items():
+            if math.isinf(t):
+                ratios[config].append(math.inf)
+            elif fastest == 0:
+                ratios[config].append(1.0 if t == 0 else math.inf)
+            else:
+                ratios[config].append(t / fastest)
+
+    # The profile only changes at observed ratios; tau = 1 gives the share
+    # of instances on which a configuration is fastest.
+    finite = {r for rs in ratios.values() for r in rs if not math.isinf(r)}
+    taus = sorted(finite | {1.0})
+    profile_rows = []
+    for config in configs:
+        for tau in taus:
+            within = sum(r <= tau for r in ratios[config])
+            profile_rows.append(
+                {
+                    "config": config,
+                    "tau": tau,
+                    "fraction": within / len(ratios[config]),
+                }
+            )
+
+    return ttt_rows, profile_rows
+
+
+def _write_csv(path: pathlib.Path, rows: list[dict], fields: list[str]):
+    with open(path, "w", newline="") as fh:
+        writer = csv.DictWriter(fh, fieldnames=fields)
+        writer.writeheader()
+        writer.writerows(rows)
+
+
+def parse_args(argv=None):
+    parser = argparse.ArgumentParser(
+        prog="run_solver", description="End-to-end solver benchmark runner."
+    )
+    parser.add_argument(
+        "--instance",
+        dest="instances",
+        action="append",
+        type=Instance.parse,
+        help="PROBLEM:PATH:BUDGET[:HOP_DISTANCE]; repeatable. Default: built-in suite.",
+    )
+    parser.add_argument(
+        "--strategies",
+        default=None,
+        help="Comma-separated strategies. Default: all that fit each problem.",
+    )
+    parser.add_argument(
+        "--crossovers",
+        default=",".join(CROSSOVERS),
+        help="Comma-separated crossover operators.",
+    )
+    parser.add_argument(
+        "--seeds", type=int, default=3, help="Seeds 0..N-1 per configuration."
+    )
+    parser.add_argument(
+        "--time-limit", type=float, default=10.0, help="Seconds per run."
+    )
+    parser.add_argument(
+        "--target-gap",
+        type=float,
+        default=0.01,
+        help="Relative slack over the best objective found, defining the target.",
+    )
+    parser.add_argument(
+        "--jobs", type=int, default=1, help="Parallel worker processes."
+    )
+    parser.add_argument(
+        "--output-dir",
+        type=pathlib.Path,
+        default=ROOT / "results",
+        help="Directory for runs.jsonl, ttt.csv and profile.csv.",
+    )
+    return parser.parse_args(argv)
+
+
+def main(argv=None):
+    args = parse_args(argv)
+    instances = args.instances or [Instance.parse(spec) for spec in DEFAULT_INSTANCES]
+    crossovers = args.crossovers.split(",")
+    chosen = args.strategies.split(",") if args.strategies else None
+
+    tasks = []
+    for instance in instances:
+        strategies = [
+            strategy
+            for strategy in (chosen or STRATEGIES[instance.problem])
+            if strategy in STRATEGIES[instance.problem]
+        ]
+        applicable = [
+            crossover
+            for crossover in crossovers
+            if instance.problem in CROSSOVER_PROBLEMS.get(crossover, STRATEGIES)
+        ]
+        configs = product(strategies, applicable, range(args.seeds))
+        for strategy, crossover, seed in configs:
+            tasks.append(Task(instance, strategy, crossover, seed, args.time_limit))
+
+    args.output_dir.mkdir(parents=True, exist_ok=True)
+    runs = []
+    with open(args.output_dir / "runs.jsonl", "w") as fh:
+        with multiprocessing.Pool(args.jobs, maxtasksperchild=1) as pool:
+            results = pool.imap_unordered(run_task_safely, tasks)
+            for idx, run in enumerate(results, 1):
+                runs.append(run)
+                fh.write(json.dumps(run) + "\n")
+                fh.flush()
+
+                prefix = f"[{idx}/{len(tasks)}] {run['instance']} {_config(run)}"
+                if "error" in run:
+                    outcome = f"failed: {run['error']}"
+                else:
+                    outcome = (
+                        f"obj={run['best_obj_value']} "
+                        f"at {run['best_found_at_time']:.2f}s"
+                    )
+                print(f"{prefix} seed={run['seed']} {outcome}", flush=True)
+
+    ttt_rows, profile_rows = analyse(runs, args.target_gap)
+    _write_csv(
+        args.output_dir / "ttt.csv",
+        ttt_rows,
+        ["instance", "config", "target", "time", "probability"],
+    )
+    _write_csv(
+        args.output_dir / "profile.csv",
+        profile_rows,
+        ["config", "tau", "fraction"],
+    )
+
+
+if __name__ == "__main__":
+    main()
@@ -12,8 +12,10 @@ strategies to improve solutions.
 from __future__ import annotations
 
 import logging
+import os
 import random
 import time
+from concurrent.futures import ThreadPoolExecutor
 from typing import TYPE_CHECKING, Optional, Union
 
 from pycnp.ProgressPrinter import ProgressPrinter
@@ -34,8 +36,17 @@ from pycnp.validation import (
     validate_search_strategy,
 )
 
-from ._pycnp import Population, ProblemData, Search
+from ._pycnp import (
+    Checkpoint,
+    CheckpointWriter,
+    Population,
+    ProblemData,
+    RandomNumberGenerator,
+    Search,
+    SearchCache,
+)
 from .constants import (
+    DEFAULT_CHECKPOINT_INTERVAL,
     DEFAULT_DISPLAY_INTERVAL,
     DEFAULT_HOP_DISTANCE,
     PACKAGE_LOGGER_NAME,
@@ -44,6 +55,8 @@ from .constants import (
 if TYPE_CHECKING:
     from pycnp.stop import StoppingCriterion
 
+    from ._pycnp import SearchResult
+
 logger = logging.getLogger(PACKAGE_LOGGER_NAME)
 
 
@@ -69,7 +82,8 @@ class MemeticSearch:
     problem_data : ProblemData
         The graph problem data containing nodes and edges.
     problem_type : str
-        Either "CNP" for Critical Node Problem or "DCNP" for Distance-based CNP.
+        "CNP" for Critical Node Problem, one of its objective variants
+        "WCNP", "MINMAXC" and "MAXNUM", or "DCNP" for Distance-based CNP.
     budget : int
         Maximum number of nodes that can be removed.
     seed : int
@@ -95,8 +109,8 @@ class MemeticSearch:
         problem_data : ProblemData
             The problem data reference containing graph structure.
         problem_type : str or int
-            Problem type: "CNP" or "DCNP". Can also use pycnp.CNP or
-            pycnp.DCNP constants.
+            Problem type: "CNP", "WCNP", "MINMAXC", "MAXNUM" or "DCNP". Can
+            also use the pycnp.CNP, pycnp.DCNP, ... constants.
         budget : int
             Number of nodes to remove from the graph.
         seed : int
@@ -144,6 +158,10 @@ class MemeticSearch:
         self.seed = seed
         random.seed(seed)
 
+        # Offspring seeds are drawn from the first split of the run's
+        # stream, as on the first island of MemeticEngine.
+        self._seed_stream = RandomNumberGenerator(seed).split()
+
         self.is_problem_reduction = self._memetic_search_params.is_problem_reduction
         self.crossover_strategy = validate_crossover_strategy(
             self._memetic_search_params, self.problem_type
@@ -153,13 +171,35 @@ class MemeticSearch:
             self._memetic_search_params.reduce_params, self.problem_type
         )
 
+        self.num_offspring = self._memetic_search_params.num_offspring
+        if not isinstance(self.num_offspring, int) or self.num_offspring <= 0:
+            raise ValueError("num_offspring must be a positive integer.")
+
+        search_cache_size = self._memetic_search_params.search_cache_size
+        if not isinstance(search_cache_size, int) or search_cache_size < 0:
+            raise ValueError("search_cache_size must be a non-negative integer.")
+
+        # Local search results shared by all runs of this instance; its
+        # ``hits`` and ``misses`` count the offspring searches.
+        self.search_cache: Optional[SearchCache] = None
+        if search_cache_size > 0:
+            self.search_cache = SearchCache(search_cache_size)
+
+        # Perf-counter deadline of a run stopped by ``MaxRuntime``; local
+        # searches stop there too instead of overrunning the limit.
+        self._deadline: Optional[float] = None
+
         self.best_solution: set[int] = set()
         self.best_obj_value = float("inf")
         self.best_found_at_time = 0.0
 
         try:
             self.original_graph = self.problem_data.create_original_graph(
-                self.problem_type, self.budget, self.seed, self.hop_distance
+                self.problem_type,
+                self.budget,
+                self.seed,
+                self.hop_distance,
+                kernelize=self._memetic_search_params.kernelize,
             )
         except Exception as e:
             raise RuntimeError(f"Failed to create original graph: {e}") from e
@@ -171,6 +211,9 @@ class MemeticSearch:
         stopping_criterion: StoppingCriterion,
         collect_stats: bool = True,
         display: bool = False,
+        checkpoint_path: Optional[str] = None,
+        checkpoint_interval: int = DEFAULT_CHECKPOINT_INTERVAL,
+        resume: bool = False,
     ) -> "Result":
         """
         Execute the memetic search algorithm.
@@ -189,6 +232,21 @@ class MemeticSearch:
             Whether to collect iteration-by-iteration statistics.
         display : bool, default=False
             Whether to display progress information during the search.
+        checkpoint_path : str, optional
+            File the state of the run is checkpointed to: after the initial
+            population, every ``checkpoint_interval`` generations and at the
+            end. Checkpoints are written on a background thread, so the
+            generations do not wait for them.
+        checkpoint_interval : int, default=DEFAULT_CHECKPOINT_INTERVAL
+            Generations between two checkpoints.
+        resume : bool, default=False
+            Whether to continue from the checkpoint at ``checkpoint_path``
+            if there is one. The population is restored instead of searched
+            again, and the run continues exactly as the checkpointed one
+            would have. This instance must be configured as the checkpointed
+            one; a checkpoint with another problem type, budget, search or
+            crossover raises ``ValueError``. Stopping criteria count from the
+            resume, and the statistics cover the resumed generations only.
 
         Returns
         -------
@@ -200,6 +258,7 @@ class MemeticSearch:
             * ``runtime`` - Total runtime in seconds
             * ``best_found_at_time`` - Time when best solution was found
             * ``stats`` - Statistics object if ``collect_stats=True``
+            * ``num_search_steps`` - Local search moves over all offspring
 
         Examples
         --------
@@ -218,8 +277,15 @@ class MemeticSearch:
         ...     display=True
         ... )
         """
+        if not isinstance(checkpoint_interval, int) or checkpoint_interval <= 0:
+            raise ValueError("checkpoint_interval must be a positive integer.")
+
         start_time_run = time.perf_counter()
 
+        checkpoint = None
+        if resume and checkpoint_path is not None and os.path.exists(checkpoint_path):
+            checkpoint = Checkpoint.load(checkpoint_path)
+
         stats = Statistics(collect_stats=collect_stats)
         printer = ProgressPrinter(
             should_print=display,
@@ -229,8 +295,6 @@ class MemeticSearch:
 
         printer.start(self.problem_type, self.budget, self.seed)
 
-        printer.initializing_population_message()
-
         self.population = Population(
             self.original_graph,
             self.search_name,
@@ -243,17 +307,66 @@ class MemeticSearch:
         )
 
         init_stopping_criterion = None
+        self._deadline = None
         if stopping_criterion.get_name() == "MaxRuntime":
             init_stopping_criterion = stopping_criterion
+            self._deadline = (
+                stopping_criterion.start_time + stopping_criterion.max_runtime
+            )
+            # Bounds every search of the population, so initializing a
+            # large graph does not overshoot the runtime.
+            self.population.set_time_limit(self._remaining_time())
 
-        best_solution_init, best_obj_value_init = self.population.initialize(
-            display, init_stopping_criterion
-        )
+        num_idle_generations = 0
+        iterations = 0
+        num_search_steps = 0
 
-        if best_obj_value_init < self.best_obj_value:
-            self.best_obj_value = best_obj_value_init
-            self.best_solution = best_solution_init
-            self.best_found_at_time = time.perf_counter() - start_time_run
+        if checkpoint is not None:
+            printer.resuming_message(checkpoint.num_generations)
+            checkpoint.restore(
+                self.population, self.original_graph, *self._checkpoint_config()
+            )
+            self._seed_stream.state = checkpoint.seed_stream
+            self.best_solution = checkpoint.best_solution
+            self.best_obj_value = checkpoint.best_obj_value
+            self.best_found_at_time = checkpoint.best_found_at_time
+            iterations = checkpoint.num_generations
+            num_idle_generations = checkpoint.num_idle_generations
+            num_search_steps = checkpoint.num_search_steps
+            start_time_run -= checkpoint.runtime
+        else:
+            printer.initializing_population_message()
+            best_solution_init, best_obj_value_init = self.population.initialize(
+                display, init_stopping_criterion
+            )
+
+            if best_obj_value_init < self.best_obj_value:
+                self.best_obj_value = best_obj_value_init
+                self.best_solution = best_solution_init
+                self.best_found_at_time = time.perf_counter() - start_time_run
+
+        writer = None
+        if checkpoint_path is not None:
+            writer = CheckpointWriter()
+
+        def save_checkpoint():
+            state = Checkpoint.capture(
+                self.population, self.original_graph, *self._checkpoint_config()
+            )
+            state.seed_stream = self._seed_stream.state
+            state.best_solution = self.best_solution
+            state.best_obj_value = self.best_obj_value
+            state.best_found_at_time = self.best_found_at_time
+            state.num_generations = iterations
+            state.num_idle_generations = num_idle_generations
+            state.num_search_steps = num_search_steps
+            state.runtime = time.perf_counter() - start_time_run
+            writer.submit(state, checkpoint_path)
+
+        # The initial population is the costliest state to recompute, as in
+        # DCNP runs that build K-hop trees for every start solution.
+        if writer is not None and checkpoint is None:
+            save_checkpoint()
 
         if stopping_criterion.get_name() == "MaxRuntime":
             if not stopping_criterion(self.best_obj_value):
@@ -261,66 +374,73 @@ class MemeticSearch:
         else:
             printer.print_iterations_start_banner_and_header()
 
-        num_idle_generations = 0
-        iterations = 0
+        # Crossovers and local searches release the GIL, so the offspring of
+        # a batch are bred on parallel threads.
+        executor = None
+        if self.num_offspring > 1:
+            executor = ThreadPoolExecutor(max_workers=self.num_offspring)
 
-        while not stopping_criterion(self.best_obj_value):
-            iterations += 1
-
-            if self.crossover_strategy == "RSC":
-                parent1, parent2 = self.population.select()
-                parent_ptrs = [parent1, parent2]
-                offspring_graph = reduce_solve_combine(
-                    self.original_graph,
-                    parent_ptrs,
-                    self.reduce_params["search"],
-                    self.reduce_params["beta"],
-                    self.seed,
-                )
-                self.seed += 1
-            elif self.crossover_strategy == "DBX":
-                parent1, parent2 = self.population.select()
-                parent_ptrs = [parent1, parent2]
-                offspring_graph = double_backbone_based_crossover(
-                    self.original_graph, parent_ptrs, self.seed
-                )
-                self.seed += 1
-            elif self.crossover_strategy == "IRR":
-                parent1, parent2, parent3 = self.population.get_all_three_solutions()
-                parent_ptrs = [parent1, parent2, parent3]
-                offspring_graph = inherit_repair_recombination(
-                    self.original_graph, parent_ptrs, self.seed
-                )
-                self.seed += 1
-            else:
-                raise ValueError(
-                    f"Unknown crossover strategy: {self.crossover_strategy}"
+        try:
+            while not stopping_criterion(self.best_obj_value):
+                iterations += 1
+
+                # Parents and seeds are drawn in order, so a batch breeds the
+                # same offspring however its searches are scheduled.
+                matings = []
+                for _ in range(self.num_offspring):
+                    parents = self._select_parents()
+                    crossover_seed = self._seed_stream.next_seed()
+                    search_seed = self._seed_stream.next_seed()
+                    matings.append((parents, crossover_seed, search_seed))
+
+                if executor is None:
+                    ls_results = [self._breed(*mating) for mating in matings]
+                else:
+                    ls_results = list(executor.map(lambda m: self._breed(*m), matings))
+
+                if len(ls_results) == 1:
+                    self.population.update(
+                        ls_results[0].solution,
+                        ls_results[0].obj_value,
+                        num_idle_generations,
+                        display,
+                    )
+                else:
+                    self.population.update_batch(
+                        [r.solution for r in ls_results],
+                        [r.obj_value for r in ls_results],
+                        num_idle_generations,
+                        display,
+                    )
+
+                num_search_steps += sum(r.num_steps for r in ls_results)
+                best_ls_result = min(ls_results, key=lambda r: r.obj_value)
+                if best_ls_result.obj_value < self.best_obj_value:
+                    self.best_solution = best_ls_result.solution
+                    self.best_obj_value = best_ls_result.obj_value
+                    self.best_found_at_time = time.perf_counter() - start_time_run
+                    num_idle_generations = 0
+                else:
+                    num_idle_generations += 1
+
+                stats.collect(
+                    best_obj_value=self.best_obj_value,
+                    population_size=self.population.get_size(),
+                    num_idle_generations=num_idle_generations,
                 )
 
-            local_search = Search(offspring_graph, self.seed)
-            self.seed += 1
-            local_search.set_strategy(self.search_strategy)
-            ls_result = local_search.run()
+                printer.iteration(stats)
 
-            self.population.update(
-                ls_result.solution, ls_result.obj_value, num_idle_generations, display
-            )
+                if writer is not None and iterations % checkpoint_interval == 0:
+                    save_checkpoint()
 
-            if ls_result.obj_value < self.best_obj_value:
-                self.best_solution = ls_result.solution
-                self.best_obj_value = ls_result.obj_value
-                self.best_found_at_time = time.perf_counter() - start_time_run
-                num_idle_generations = 0
-            else:
-                num_idle_generations += 1
-
-            stats.collect(
-                best_obj_value=self.best_obj_value,
-                population_size=self.population.get_size(),
-                num_idle_generations=num_idle_generations,
-            )
-
-            printer.iteration(stats)
+            if writer is not None:
+                save_checkpoint()
+        finally:
+            if executor is not None:
+                executor.shutdown()
+            if writer is not None:
+                writer.wait()
 
         final_runtime = time.perf_counter() - start_time_run
         result = Result(
@@ -330,8 +450,76 @@ class MemeticSearch:
             runtime=final_runtime,
             best_found_at_time=self.best_found_at_time,
             stats=stats,
+            num_search_steps=num_search_steps,
         )
 
         printer.end(result)
 
         return result
+
+    def _checkpoint_config(self) -> tuple:
+        """
+        Configuration a checkpoint is resumed with only by a matching run:
+        problem type, budget, search and crossover.
+        """
+        return (
+            self.problem_type,
+            self.budget,
+            self.search_strategy,
+            self.crossover_strategy,
+        )
+
+    def _select_parents(self) -> list:
+        """
+        Selects the parents of one offspring for the configured crossover.
+        """
+        if self.crossover_strategy == "IRR":
+            return list(self.population.get_all_three_solutions())
+        return list(self.population.select())
+
+    def _remaining_time(self) -> float:
+        """
+        Seconds until the deadline of the run, or 0 for a run without one.
+        """
+        if self._deadline is None:
+            return 0.0
+        # A search started past the deadline still returns its start.
+        return max(self._deadline - time.perf_counter(), 1e-6)
+
+    def _breed(self, parents: list, seed: int, search_seed: int) -> SearchResult:
+        """
+        Creates one offspring from ``parents`` and improves it by local search.
+
+        The crossover uses ``seed`` and the local search ``search_seed``.
+        """
+        if self.crossover_strategy == "RSC":
+            offspring_graph = reduce_solve_combine(
+                self.original_graph,
+                parents,
+                self.reduce_params["search"],
+                self.reduce_params["beta"],
+                seed,
+                self._remaining_time(),
+            )
+        elif self.crossover_strategy == "DBX":
+            offspring_graph = double_backbone_based_crossover(
+                self.original_graph, parents, seed
+            )
+        elif self.crossover_strategy == "IRR":
+            offspring_graph = inherit_repair_recombination(
+                self.original_graph, parents, seed
+            )
+        else:
+            raise ValueError(f"Unknown crossover strategy: {self.crossover_strategy}")
+
+        time_limit = self._remaining_time()
+        if self.search_cache is not None:
+            return self.search_cache.run(
+                offspring_graph, self.search_strategy, search_seed, time_limit
+            )
+
+        local_search = Search(offspring_graph, search_seed)
+        local_search.set_strategy(self.search_strategy)
+        if time_limit > 0:
+            local_search.set_param("timeLimit", time_limit)
+        return local_search.run()
@@ -212,8 +212,11 @@ class Model:
         Parameters
         ----------
         problem_type : str
-            The type of problem to solve. Either ``"CNP"`` for the standard
-            Critical Node Problem or ``"DCNP"`` for the Distance-based variant.
+            The type of problem to solve: ``"CNP"`` for the standard
+            Critical Node Problem, its objective variants ``"WCNP"``
+            (node-weighted pairs), ``"MINMAXC"`` (largest component) and
+            ``"MAXNUM"`` (number of components), or ``"DCNP"`` for the
+            Distance-based variant.
         budget : int
             The maximum number of nodes that can be removed. Must be non-negative
             and not exceed the total number of nodes.
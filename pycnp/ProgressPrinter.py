@@ -146,6 +146,17 @@ class ProgressPrinter:
         )
         self._last_print_time = time.perf_counter()
 
+    def resuming_message(self, num_generations: int):
+        """
+        Prints a message before a run resumes from a checkpoint.
+        """
+        if not self._print:
+            return
+        self._logger.info(
+            f"-------------Resuming from checkpoint at generation {num_generations}-------------"
+        )
+        self._last_print_time = time.perf_counter()
+
     def print_iterations_start_banner_and_header(self):
         """
         Prints a message before the main iteration loop starts and the header.
@@ -51,3 +51,4 @@ class Result:
     runtime: float = 0.0
     best_found_at_time: float = 0.0
     stats: Optional["Statistics"] = None
+    num_search_steps: int = 0
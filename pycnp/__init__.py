@@ -10,36 +10,54 @@ from .Result import Result
 from ._pycnp import (  # noqa: F401
     BCLSStrategy,
     CBNSStrategy,
+    CancelToken,
+    Checkpoint,
+    CheckpointWriter,
     CHNSStrategy,
     CNP_Graph,
     DCNP_Graph,
     DLASStrategy,
     Graph,
+    MemeticEngine,
+    MemeticEngineResult,
     Population,
     ProblemData,
+    ProgressEvent,
+    ProgressQueue,
+    RandomNumberGenerator,
     Search,
+    SearchCache,
     SearchResult,
     SearchStrategy,
+    get_metrics,
+    reset_metrics,
 )
 from .constants import (
     BCLS,
     CBNS,
     CHNS,
     CNP,
+    CNP_PROBLEM_TYPES,
     DBX,
     DCNP,
     DEFAULT_DISPLAY_INTERVAL,
     DEFAULT_HOP_DISTANCE,
     DLAS,
     IRR,
+    MAXNUM,
+    MINMAXC,
     PACKAGE_LOGGER_NAME,
     PROBLEM_TYPE_CNP,
     PROBLEM_TYPE_DCNP,
+    PROBLEM_TYPE_MAXNUM,
+    PROBLEM_TYPE_MINMAXC,
+    PROBLEM_TYPE_WCNP,
     RSC,
     SEARCH_STRATEGY_BCLS,
     SEARCH_STRATEGY_CBNS,
     SEARCH_STRATEGY_CHNS,
     SEARCH_STRATEGY_DLAS,
+    WCNP,
 )
 from .crossover import (
     double_backbone_based_crossover,
@@ -79,22 +97,32 @@ __all__ = [
     "CBNS",
     "CHNS",
     "CNP",
+    "CNP_PROBLEM_TYPES",
     "DBX",
     "DCNP",
     "DEFAULT_DISPLAY_INTERVAL",
     "DEFAULT_HOP_DISTANCE",
     "DLAS",
     "IRR",
+    "MAXNUM",
+    "MINMAXC",
     "PROBLEM_TYPE_CNP",
     "PROBLEM_TYPE_DCNP",
+    "PROBLEM_TYPE_MAXNUM",
+    "PROBLEM_TYPE_MINMAXC",
+    "PROBLEM_TYPE_WCNP",
     "RSC",
     "SEARCH_STRATEGY_BCLS",
     "SEARCH_STRATEGY_CBNS",
     "SEARCH_STRATEGY_CHNS",
     "SEARCH_STRATEGY_DLAS",
+    "WCNP",
     "BCLSStrategy",
     "CBNSStrategy",
     "CHNSStrategy",
+    "CancelToken",
+    "Checkpoint",
+    "CheckpointWriter",
     "CNP_Graph",
     "DCNP_Graph",
     "DLASStrategy",
@@ -104,6 +132,8 @@ __all__ = [
     "InvalidSearchStrategyError",
     "MaxIterations",
     "MaxRuntime",
+    "MemeticEngine",
+    "MemeticEngineResult",
     # Population search
     "MemeticSearch",
     "MemeticSearchParams",
@@ -113,18 +143,24 @@ __all__ = [
     "Population",
     # C++ binding classes
     "ProblemData",
+    "ProgressEvent",
+    "ProgressQueue",
+    "RandomNumberGenerator",
     # Result class
     "Result",
+    "SearchCache",
     "SearchStrategy",
     # Stopping criteria
     "StoppingCriterion",
     "VariablePopulationParams",
     "double_backbone_based_crossover",
+    "get_metrics",
     "inherit_repair_recombination",
     # Utility functions
     "read",
     "read_adjacency_list_format",
     "read_edge_list_format",
     "reduce_solve_combine",
+    "reset_metrics",
     "visualize_graph",
 ]
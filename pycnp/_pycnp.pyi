@@ -1,4 +1,4 @@
-from typing import overload
+from typing import Any, Callable, overload
 
 BCLS: str
 CBNS: str
@@ -8,7 +8,32 @@ DBX: str
 DCNP: str
 DLAS: str
 IRR: str
+MAXNUM: str
+MINMAXC: str
 RSC: str
+TRACING_ENABLED: bool
+WCNP: str
+
+def get_metrics() -> dict[str, Any]:
+    """
+    Returns solver counters, phase timers and recent events.
+
+    Values are summed over all threads. They are only recorded when pycnp is
+    built with the ``trace`` option; otherwise ``enabled`` is False and all
+    values are zero.
+
+    Returns
+    -------
+    dict
+        ``enabled``, ``counters`` (name to count), ``phases`` (name to a dict
+        with ``calls`` and ``seconds``) and ``events`` (a list of dicts with
+        ``time``, ``thread``, ``event`` and ``args``, oldest first).
+    """
+    ...
+
+def reset_metrics() -> None:
+    """Zeroes all counters and timers and clears the event logs."""
+    ...
 
 class CNP_Graph:
     """
@@ -28,6 +53,18 @@ class CNP_Graph:
     def remove_node(self, node_to_remove: int) -> None:
         """Removes a node from the graph."""
         ...
+    def set_gain_cache_enabled(self, enabled: bool) -> None:
+        """Enables or disables the cached gain table of greedy node insertion."""
+        ...
+    def set_impact_cache_enabled(self, enabled: bool) -> None:
+        """Enables or disables the per-component block-cut index."""
+        ...
+    def removal_split_sizes(self, node: int) -> list[int]:
+        """
+        Returns the sizes of the components that removing ``node`` leaves
+        in place of its own, from the block-cut index of its component.
+        """
+        ...
     @property
     def removed_nodes(self) -> set[int]:
         """Returns the set of removed nodes."""
@@ -79,6 +116,167 @@ class Graph:
     Lightweight wrapper over concrete graph implementations (CNP_Graph / DCNP_Graph).
     """
     def __init__(self, *args, **kwargs) -> None: ...
+    def remove_node(self, node: int) -> None: ...
+    def add_node(self, node: int) -> None: ...
+    def is_node_removed(self, node: int) -> bool: ...
+    def get_removed_nodes(self) -> set[int]: ...
+    def get_objective_value(self) -> int: ...
+    def greedy_select_node_to_add(self) -> int: ...
+    def random_select_node_to_remove(self) -> int: ...
+    def checkpoint(self) -> None:
+        """
+        Starts a move that can be undone with ``rollback``; removals and
+        additions until ``commit`` or ``rollback`` are logged.
+        """
+        ...
+    def commit(self) -> None:
+        """Keeps the moves since ``checkpoint`` and ends it."""
+        ...
+    def rollback(self) -> None:
+        """
+        Undoes the moves since ``checkpoint``, newest first, and ends it.
+        The removed set and objective value return to their checkpoint
+        state.
+        """
+        ...
+    def set_gain_cache_enabled(self, enabled: bool) -> None:
+        """Enables or disables the gain cache of a CNP graph."""
+        ...
+    def set_impact_cache_enabled(self, enabled: bool) -> None:
+        """Enables or disables the impact cache of a CNP graph."""
+        ...
+
+class MemeticEngine:
+    """
+    Island-model memetic search with the generation loop in C++.
+
+    Every island owns an original graph and a Population and runs the
+    generation loop of MemeticSearch on its own thread. Every
+    ``migration_interval`` generations an island publishes its best solution
+    and takes in the best one of its predecessor on a ring. A single island
+    reproduces MemeticSearch for the same seed; with several islands runs
+    are not reproducible.
+    """
+    def __init__(
+        self,
+        problem_data: ProblemData,
+        problem_type: str,
+        budget: int,
+        seed: int,
+        search: str = "CHNS",
+        crossover: str = "RSC",
+        reduce_search: str = "CHNS",
+        reduce_beta: float = 0.9,
+        is_pop_variable: bool = True,
+        initial_pop_size: int = 5,
+        max_pop_size: int = 20,
+        increase_pop_size: int = 3,
+        max_idle_gens: int = 20,
+        hop_distance: int = ...,
+        tree_storage: str = "auto",
+        num_offspring: int = 1,
+        num_islands: int = 1,
+        migration_interval: int = 20,
+        tabu_archive_size: int = 0,
+        search_cache_size: int = 0,
+        time_limit: float = 0.0,
+        kernelize: bool = False,
+        num_shards: int = 1,
+    ) -> None:
+        """
+        Creates an engine for the given problem.
+
+        Parameters
+        ----------
+        problem_data : ProblemData
+            The graph.
+        problem_type : str
+            "CNP" or "DCNP".
+        budget : int
+            Number of nodes to remove.
+        seed : int
+            Random seed of the run. Island ``i`` draws its offspring seeds
+            from the ``i``-th split of ``RandomNumberGenerator(seed)``; the
+            first island's graph and population use ``seed`` itself, like
+            MemeticSearch, and the others a seed drawn from their stream.
+        num_offspring : int, default=1
+            Offspring bred per generation; their crossovers and local
+            searches run in parallel before one batched population update.
+        num_islands : int, default=1
+            Number of islands, each on its own thread.
+        migration_interval : int, default=20
+            Generations between migrations; 0 disables them.
+        tabu_archive_size : int, default=0
+            Number of crossover results each island remembers; offspring
+            starting from one of them skip the local search. 0 disables
+            the archive.
+        search_cache_size : int, default=0
+            Number of local search results kept in a cache shared by the
+            islands; 0 disables it.
+        time_limit : float, default=0.0
+            Wall-clock limit of a run in seconds. Local searches running at
+            the limit are cancelled, so the run stops promptly. 0 sets no
+            limit.
+        kernelize : bool, default=False
+            Whether to search a reduced graph, see
+            ``ProblemData.create_original_graph``.
+        num_shards : int, default=1
+            Shards each CNP local search is split into, searched in
+            parallel; see the ``"numShards"`` parameter of ``Search``. 1
+            searches unsharded.
+
+        The remaining arguments match MemeticSearchParams and
+        VariablePopulationParams.
+        """
+        ...
+    def run(
+        self,
+        stopping_criterion: Callable[[int], bool],
+        progress_queue: ProgressQueue | None = None,
+    ) -> MemeticEngineResult:
+        """
+        Runs all islands until the stopping criterion holds.
+
+        The criterion gets the best objective value so far and is called
+        before every generation of every island, one call at a time, so the
+        criteria of pycnp.stop count generations over all islands. The GIL
+        is released while the islands run.
+
+        Parameters
+        ----------
+        stopping_criterion : Callable[[int], bool]
+            Returns True once the run should stop.
+        progress_queue : ProgressQueue, optional
+            Receives an event for every improvement of the run's best
+            solution, with the reporting island as ``source`` and the run's
+            generation count as ``iteration``. Drain it from another thread
+            while the run goes on.
+
+        Returns
+        -------
+        MemeticEngineResult
+            Best solution found and run statistics.
+        """
+        ...
+
+class MemeticEngineResult:
+    """Outcome of a MemeticEngine run."""
+    @property
+    def best_found_at_time(self) -> float: ...
+    @property
+    def best_obj_value(self) -> int: ...
+    @property
+    def best_solution(self) -> set[int]: ...
+    @property
+    def num_generations(self) -> int: ...
+    @property
+    def num_migrations(self) -> int: ...
+    @property
+    def runtime(self) -> float: ...
+    @property
+    def search_cache_hits(self) -> int: ...
+    @property
+    def search_cache_misses(self) -> int: ...
 
 class Population:
     """
@@ -199,6 +397,22 @@ class Population:
             True if an identical solution is in the population
         """
         ...
+    def mark_evaluated(self, solution: set[int]) -> bool:
+        """
+        Record a solution as evaluated in the tabu archive.
+
+        Parameters
+        ----------
+        solution : set[int]
+            The solution about to be evaluated
+
+        Returns
+        -------
+        bool
+            False if the solution is already in the archive, true otherwise,
+            including when the archive is disabled.
+        """
+        ...
     def rebuild(self) -> None:
         """
         Rebuild the population from scratch.
@@ -220,6 +434,37 @@ class Population:
             Pair of (first parent, second parent) as solution sets
         """
         ...
+    def set_num_threads(self, num_threads: int) -> None:
+        """
+        Set the number of threads used to generate new solutions.
+
+        The generated solutions are the same for every thread count.
+
+        Parameters
+        ----------
+        num_threads : int
+            Thread count; values below one (the default) use all hardware
+            threads.
+        """
+        ...
+    def set_time_limit(self, time_limit: float) -> None:
+        """
+        Bound the local searches that generate solutions.
+
+        Initialization, expansion and rebuilding searches stop at the
+        deadline ``time_limit`` seconds from now; 0 removes the bound.
+        """
+        ...
+    def set_tabu_archive_size(self, size: int) -> None:
+        """
+        Set the capacity of the tabu archive of evaluated solutions.
+
+        Parameters
+        ----------
+        size : int
+            Number of fingerprints kept; 0 (the default) disables the archive.
+        """
+        ...
     def update(
         self,
         solution: set,
@@ -246,6 +491,33 @@ class Population:
             Whether to print detailed information
         """
         ...
+    def update_batch(
+        self,
+        solutions: list[set[int]],
+        obj_values: list[int],
+        num_idle_generations: int,
+        verbose: bool = ...,
+    ) -> None:
+        """
+        Update population with a batch of offspring solutions.
+
+        All offspring join the population before the worst individuals are
+        removed, one per offspring, and the population size is adapted once
+        for the batch. A batch of one is the same as ``update``; an empty
+        batch only adapts the size.
+
+        Parameters
+        ----------
+        solutions : list[set[int]]
+            The offspring solutions
+        obj_values : list[int]
+            Objective value of each offspring
+        num_idle_generations : int
+            Number of generations without improvement
+        verbose : bool, default=False
+            Whether to print detailed information
+        """
+        ...
 
 class ProblemData:
     """
@@ -285,9 +557,33 @@ class ProblemData:
             The ID of the node to add.
         """
         ...
-    def add_node_weight(self, node_id: int, weight: float) -> None: ...
+    def add_node_weight(self, node_id: int, weight: int) -> None:
+        """
+        Sets the weight of a node, used by the weighted ("WCNP") objective.
+
+        Nodes without a weight weigh one.
+
+        Parameters
+        ----------
+        node_id : int
+            The ID of the node.
+        weight : int
+            The non-negative weight of the node.
+
+        Raises
+        ------
+        ValueError
+            If the node is out of range or the weight negative.
+        """
+        ...
     def create_original_graph(
-        self, problem_type: str, budget: int, seed: int, hop_distance: int = ...
+        self,
+        problem_type: str,
+        budget: int,
+        seed: int,
+        hop_distance: int = ...,
+        tree_storage: str = "auto",
+        kernelize: bool = False,
     ) -> Graph:
         """
         Creates an original graph from the problem data.
@@ -297,13 +593,25 @@ class ProblemData:
         Parameters
         ----------
         problem_type : str
-            The type of problem ("CNP" or "DCNP").
+            The type of problem: "DCNP", or one of the CNP objectives "CNP",
+            "WCNP" (node-weighted pairs), "MINMAXC" (largest component) and
+            "MAXNUM" (number of components).
         budget : int
             The number of nodes to remove.
         seed : int
             Random seed for reproducibility.
         hop_distance : int, optional
             Maximum hop distance for DCNP.
+        tree_storage : str, optional
+            K-hop tree storage for DCNP: "auto", "dense", "bitset" or
+            "sparse". Defaults to "auto", which picks the smaller of sparse
+            and bitset.
+        kernelize : bool, optional
+            Whether to drop nodes that never improve a solution before the
+            search: isolated nodes, and for CNP leaves, which are folded
+            into the weight of their neighbour. Node ids are unchanged, so
+            solutions need no mapping back. Ignored for the CNP variants
+            other than "CNP". Defaults to False.
 
         Returns
         -------
@@ -321,7 +629,16 @@ class ProblemData:
             Adjacency list where each index contains the neighbors of that node.
         """
         ...
-    def get_node_weight(self, node_id: int) -> float: ...
+    def get_node_weight(self, node_id: int) -> int:
+        """
+        Returns the weight of a node, or one if none was set.
+
+        Parameters
+        ----------
+        node_id : int
+            The ID of the node.
+        """
+        ...
     def get_nodes_set(self) -> set[int]:
         """
         Returns the set of all nodes.
@@ -332,6 +649,32 @@ class ProblemData:
             Set of node IDs.
         """
         ...
+    @classmethod
+    def load_binary(cls, filename: str) -> ProblemData:
+        """
+        Loads problem data from a binary graph file.
+
+        The file is memory-mapped and its adjacency is used in place, so
+        loading is nearly free and processes loading the same file share
+        one copy through the page cache. The GIL is released while loading.
+
+        Parameters
+        ----------
+        filename : str
+            Path to a file written by ``save_binary``.
+
+        Returns
+        -------
+        ProblemData
+            The loaded problem data.
+
+        Raises
+        ------
+        RuntimeError
+            If the file cannot be read, has another version or byte order,
+            or is malformed.
+        """
+        ...
     def num_nodes(self) -> int:
         """
         Returns the number of nodes in the problem data.
@@ -348,6 +691,7 @@ class ProblemData:
         Reads problem data from an adjacency list format file.
 
         Adjacency list format: each line represents a node and its neighbors.
+        The file may be gzip-compressed.
 
         Parameters
         ----------
@@ -366,7 +710,7 @@ class ProblemData:
         Reads problem data from an edge list format file.
 
         Edge list format: contains a header line with node/edge counts,
-        followed by edge definitions.
+        followed by edge definitions. The file may be gzip-compressed.
 
         Parameters
         ----------
@@ -379,7 +723,313 @@ class ProblemData:
             The loaded problem data.
         """
         ...
-    def read_node_weights_from_file(self, filename: str) -> None: ...
+    @classmethod
+    def read_from_file(cls, filename: str) -> ProblemData:
+        """
+        Reads problem data from a graph file, detecting its format.
+
+        Understands adjacency lists (node count on the first line, then
+        ``node: neighbors``), DIMACS edge lists (``p edge n m`` and
+        ``e u v`` lines) and plain ``u v`` edge lists such as SNAP files,
+        each optionally gzip-compressed. Lines starting with ``#``, ``%``
+        or ``c`` are comments. The GIL is released while the file loads.
+
+        Parameters
+        ----------
+        filename : str
+            Path to the graph file.
+
+        Returns
+        -------
+        ProblemData
+            The loaded problem data.
+
+        Raises
+        ------
+        RuntimeError
+            If the file cannot be read or a node id is out of range.
+        """
+        ...
+    def read_node_weights_from_file(self, filename: str) -> None:
+        """
+        Reads node weights from a text file of ``node weight`` lines.
+
+        Lines starting with ``#``, ``%`` or ``c`` are comments. Nodes not
+        listed keep their weight.
+
+        Parameters
+        ----------
+        filename : str
+            Path to the weight file.
+
+        Raises
+        ------
+        RuntimeError
+            If the file cannot be read or is malformed.
+        """
+        ...
+    def save_binary(self, filename: str, hop_distance: int = 0) -> None:
+        """
+        Writes the problem data to a binary graph file.
+
+        The file holds a versioned header, the CSR adjacency, the node ids,
+        the node weights of weighted data and, with ``hop_distance``, the
+        K-hop tree size of every node.
+        DCNP graphs created from the loaded data with that hop distance and
+        ``"auto"`` tree storage use the sizes to choose their tree layout
+        up front. ``read`` recognises the format.
+
+        Parameters
+        ----------
+        filename : str
+            Path of the file to write.
+        hop_distance : int, default=0
+            Hop distance to precompute the K-hop tree sizes for; 0 stores
+            none.
+        """
+        ...
+
+class CancelToken:
+    """
+    Flag that asks running searches to stop.
+
+    Pass it to ``Search.set_param("cancelToken", token)`` and call
+    ``cancel()`` from another thread; the search returns its best solution
+    so far after a few more moves.
+    """
+    def __init__(self) -> None: ...
+    def cancel(self) -> None:
+        """Asks every search holding the token to stop."""
+        ...
+    def reset(self) -> None:
+        """Clears the request, so the token can be reused."""
+        ...
+    @property
+    def cancelled(self) -> bool:
+        """Whether ``cancel()`` was called since the last reset."""
+        ...
+
+class Checkpoint:
+    """
+    State of a memetic search between two generations.
+
+    Holds the population with its cached similarities, the generators, the
+    generation counters and the best solution, so a resumed run continues
+    exactly as the checkpointed one without searching the population again.
+    Saved as a compact binary file; a file is written next to its
+    destination and renamed over it, so the previous checkpoint survives a
+    run stopped while saving.
+    """
+    @staticmethod
+    def capture(
+        population: Population,
+        graph: Graph,
+        problem_type: str,
+        budget: int,
+        search: str,
+        crossover: str,
+    ) -> Checkpoint:
+        """
+        Takes the configuration, population and graph parts of a
+        checkpoint; the other fields are set by the caller.
+        """
+        ...
+    def restore(
+        self,
+        population: Population,
+        graph: Graph,
+        problem_type: str,
+        budget: int,
+        search: str,
+        crossover: str,
+    ) -> None:
+        """
+        Restores the population and graph parts of this checkpoint.
+        Nothing is changed when the checkpoint does not fit the run.
+
+        Raises
+        ------
+        ValueError
+            If the checkpoint was taken with another problem type, budget,
+            search or crossover, on a graph with another node count, or its
+            population is inconsistent.
+        """
+        ...
+    def save(self, filename: str) -> None:
+        """Saves the checkpoint to a binary file."""
+        ...
+    @staticmethod
+    def load(filename: str) -> Checkpoint:
+        """
+        Loads a checkpoint saved by ``save``.
+
+        Raises
+        ------
+        RuntimeError
+            If the file cannot be read or is not a valid checkpoint.
+        """
+        ...
+    seed_stream: list[int]
+    """State of the generator of offspring seeds."""
+    best_solution: set[int]
+    best_obj_value: int
+    num_generations: int
+    num_idle_generations: int
+    num_search_steps: int
+    runtime: float
+    """Seconds run before the checkpoint."""
+    best_found_at_time: float
+    @property
+    def num_nodes(self) -> int:
+        """Nodes of the graph searched."""
+        ...
+    @property
+    def problem_type(self) -> str: ...
+    @property
+    def budget(self) -> int: ...
+    @property
+    def search(self) -> str:
+        """Local search strategy of the run."""
+        ...
+    @property
+    def crossover(self) -> str:
+        """Crossover strategy of the run."""
+        ...
+    @property
+    def population_size(self) -> int: ...
+
+class CheckpointWriter:
+    """
+    Saves checkpoints on a background thread.
+
+    ``submit`` only queues a checkpoint; one still queued when a newer one
+    arrives is replaced by it. Errors of a write are raised by the next
+    ``wait``.
+    """
+    def __init__(self) -> None: ...
+    def submit(self, checkpoint: Checkpoint, filename: str) -> None:
+        """Queues a copy of ``checkpoint`` to be saved to ``filename``."""
+        ...
+    def wait(self) -> None:
+        """
+        Waits until every queued checkpoint is saved.
+
+        Raises
+        ------
+        RuntimeError
+            The error of a failed write since the last call.
+        """
+        ...
+    @property
+    def num_written(self) -> int:
+        """Number of checkpoints saved so far."""
+        ...
+
+class ProgressEvent:
+    """One improvement of the best solution of a search or engine run."""
+
+    @property
+    def obj_value(self) -> int:
+        """Objective value of the new best solution."""
+        ...
+    @property
+    def time(self) -> float:
+        """Seconds since the run or search started."""
+        ...
+    @property
+    def fingerprint(self) -> int:
+        """Order-independent hash of the solution's node set."""
+        ...
+    @property
+    def source(self) -> int:
+        """Reporting island; 0 for a single search."""
+        ...
+    @property
+    def iteration(self) -> int:
+        """Generation (engine) or move (search) of the improvement."""
+        ...
+
+class ProgressQueue:
+    """
+    Bounded queue of improvement events, filled by a running search.
+
+    Pass it to ``Search.set_param("progressQueue", queue)`` or
+    ``MemeticEngine.run(..., progress_queue=queue)``, start the run in a
+    thread, and call ``drain()`` from another one. Filling and draining take
+    no locks and never need the GIL, so a slow consumer does not hold up
+    the search; when the queue is full, new events are dropped and counted
+    in ``dropped``. One queue takes events from one search or run at a
+    time.
+    """
+    def __init__(self, capacity: int = 1024) -> None: ...
+    def drain(self, max_events: int = 0) -> list[ProgressEvent]:
+        """
+        Takes the queued events, oldest first.
+
+        Parameters
+        ----------
+        max_events : int
+            Most events to take; zero takes all.
+        """
+        ...
+    def best(self) -> tuple[set[int], int] | None:
+        """Best solution and objective value published so far, if any."""
+        ...
+    @property
+    def capacity(self) -> int:
+        """Number of undrained events kept."""
+        ...
+    @property
+    def dropped(self) -> int:
+        """Number of events dropped because the queue was full."""
+        ...
+    def __len__(self) -> int: ...
+
+class RandomNumberGenerator:
+    """
+    Small-state xoshiro256++ generator with stream derivation.
+
+    Independent streams are derived with ``split()`` or ``jump()``; drawing
+    them in a fixed order keeps runs reproducible however their consumers
+    are scheduled.
+    """
+    def __init__(self, seed: int) -> None: ...
+    def next_seed(self) -> int:
+        """
+        Draws a seed for a component that takes an integer seed.
+
+        Returns
+        -------
+        int
+            A positive seed; search strategies ignore seeds below one.
+        """
+        ...
+    def split(self) -> RandomNumberGenerator:
+        """
+        Derives an independent generator from this one.
+
+        The child is seeded from the next output, so this generator advances
+        by one draw. Children of children are independent as well.
+        """
+        ...
+    def jump(self) -> None:
+        """Advances the generator by 2^128 draws."""
+        ...
+    def generate_index(self, max: int) -> int:
+        """Generates a random index in range [0, max - 1]."""
+        ...
+    def generate_probability(self) -> float:
+        """Generates a random probability value in [0, 1)."""
+        ...
+    @property
+    def state(self) -> list[int]:
+        """
+        The four state words; setting a saved state continues its sequence.
+        An all-zero state raises ValueError.
+        """
+        ...
+    @state.setter
+    def state(self, state: list[int]) -> None: ...
 
 class Search:
     """
@@ -404,12 +1054,47 @@ class Search:
         """
         Run search algorithm.
 
+        The GIL is released while the search runs, so searches on different
+        graphs can run in concurrent threads.
+
         Returns
         -------
         SearchResult
             Search result containing optimal solution and objective function value.
         """
         ...
+    def set_param(
+        self, name: str, value: int | float | CancelToken | ProgressQueue
+    ) -> None:
+        """
+        Set search algorithm parameter.
+
+        Besides the strategy parameters, "numThreads" sets the number of
+        threads the graph uses for parallel work, such as rebuilding DCNP
+        K-hop trees. Values below one use all hardware threads.
+
+        A search can also be budgeted: "timeLimit" (seconds), "maxSteps"
+        (moves) and "cancelToken" (a CancelToken) stop it early, checked
+        every "budgetCheckInterval" moves (default 16). A stopped search is
+        marked ``interrupted`` in its result. With "progressQueue" (a
+        ProgressQueue), every new best solution is published to the queue.
+
+        With "numShards" above one, a CNP search splits the residual graph
+        into up to that many groups of components and searches them in
+        parallel, moving removed nodes to the group where they gain most
+        between "shardRounds" rounds (default 4); a last unsharded pass
+        finishes the search. Sharding pays off on graphs that fall apart
+        into many components; DCNP and the MINMAXC objective ignore it.
+        Parameters apply from the next ``run()``.
+
+        Parameters
+        ----------
+        name : str
+            Parameter name.
+        value : int | float | CancelToken | ProgressQueue
+            Parameter value.
+        """
+        ...
     def set_strategy(self, strategy: str) -> None:
         """
         Set search strategy.
@@ -421,6 +1106,65 @@ class Search:
         """
         ...
 
+class SearchCache:
+    """
+    Bounded least-recently-used cache of local search results.
+
+    Results are keyed by the removed set a search starts from, the strategy
+    and, with ``match_seed``, the search seed. A search also depends on the
+    random state inside the graph, so runs with a cache are not bitwise
+    identical to runs without one. Use one cache per original graph and
+    search configuration.
+    """
+    def __init__(self, capacity: int, match_seed: bool = False) -> None:
+        """
+        Creates an empty cache.
+
+        Parameters
+        ----------
+        capacity : int
+            Maximum number of results kept; 0 disables caching.
+        match_seed : bool, default=False
+            Whether lookups must match the search seed.
+        """
+        ...
+    @property
+    def capacity(self) -> int: ...
+    @property
+    def hits(self) -> int:
+        """Lookups answered from the cache."""
+        ...
+    @property
+    def misses(self) -> int:
+        """Lookups that ran a search."""
+        ...
+    def __len__(self) -> int: ...
+    def clear(self) -> None:
+        """Removes all results; the counters are kept."""
+        ...
+    def run(
+        self, graph: Graph, strategy: str, seed: int, time_limit: float = 0.0
+    ) -> SearchResult:
+        """
+        Runs a local search on ``graph``, or returns the cached result of an
+        earlier search from the same removed set.
+
+        The GIL is released while the search runs.
+
+        Parameters
+        ----------
+        graph : Graph
+            Start graph; modified by the search on a miss only.
+        strategy : str
+            Search strategy name.
+        seed : int
+            Search seed.
+        time_limit : float, default=0.0
+            Time limit of the search in seconds; 0 sets none. A search
+            stopped by it is not cached.
+        """
+        ...
+
 class SearchResult:
     """
     Result container for search algorithms.
@@ -430,6 +1174,10 @@ class SearchResult:
     """
     obj_value: int
     """Objective value of the solution."""
+    num_steps: int
+    """Local search moves performed; 0 for a result served from a cache."""
+    interrupted: bool
+    """Whether a time, step or cancellation limit stopped the search."""
     def __init__(self) -> None: ...
     @property
     def solution(self) -> set:
@@ -16,6 +16,17 @@ hop distance when not explicitly set.
 # Problem types
 PROBLEM_TYPE_CNP = "CNP"
 PROBLEM_TYPE_DCNP = "DCNP"
+PROBLEM_TYPE_WCNP = "WCNP"
+PROBLEM_TYPE_MINMAXC = "MINMAXC"
+PROBLEM_TYPE_MAXNUM = "MAXNUM"
+
+CNP_PROBLEM_TYPES = (
+    PROBLEM_TYPE_CNP,
+    PROBLEM_TYPE_WCNP,
+    PROBLEM_TYPE_MINMAXC,
+    PROBLEM_TYPE_MAXNUM,
+)
+"""Problem types solved on the component graph, with its search strategies."""
 
 # Search strategies
 SEARCH_STRATEGY_CBNS = "CBNS"
@@ -23,6 +34,10 @@ SEARCH_STRATEGY_CHNS = "CHNS"
 SEARCH_STRATEGY_DLAS = "DLAS"
 SEARCH_STRATEGY_BCLS = "BCLS"
 
+# Checkpoints
+DEFAULT_CHECKPOINT_INTERVAL = 50
+"""Generations between two checkpoints of a :class:`MemeticSearch` run."""
+
 # Progress and logging
 DEFAULT_DISPLAY_INTERVAL = 1.0
 PACKAGE_LOGGER_NAME = "pycnp"
@@ -43,6 +58,26 @@ DCNP = "DCNP"
 CNP variant with hop distance constraints.
 """
 
+WCNP = "WCNP"
+"""Node-weighted Critical Node Problem (WCNP).
+
+Minimize the sum of ``w_i * w_j`` over connected node pairs, with node
+weights set through ``ProblemData.add_node_weight``.
+"""
+
+MINMAXC = "MINMAXC"
+"""Min-max component CNP variant.
+
+Minimize the size of the largest connected component.
+"""
+
+MAXNUM = "MAXNUM"
+"""Max-number component CNP variant.
+
+Maximize the number of connected components. The reported objective is the
+number of nodes minus the number of components, so it is minimized.
+"""
+
 CBNS = "CBNS"
 """Component-Based Neighborhood Search.
 
@@ -0,0 +1,414 @@
+#include "Checkpoint.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+namespace
+{
+struct CheckpointHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrderMark;
+    uint64_t numNodes;
+    int64_t budget;
+    uint64_t payloadBytes;  ///< Bytes of the fields after the header
+};
+
+static_assert(sizeof(CheckpointHeader) == 40);
+
+constexpr char CHECKPOINT_MAGIC[8] = {'P', 'Y', 'C', 'N', 'P', 'C', 'K', 'P'};
+constexpr uint32_t CHECKPOINT_VERSION = 2;  // 2: run configuration
+constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+/// Appends fields to a payload; arrays are prefixed by their length.
+class PayloadWriter
+{
+public:
+    template <typename T> void put(const T &value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        bytes_.append(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+    template <typename T> void putArray(const std::vector<T> &values)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        put<uint64_t>(values.size());
+        bytes_.append(reinterpret_cast<const char *>(values.data()),
+                      values.size() * sizeof(T));
+    }
+
+    void putString(const std::string &value)
+    {
+        put<uint64_t>(value.size());
+        bytes_.append(value);
+    }
+
+    const std::string &bytes() const noexcept { return bytes_; }
+
+private:
+    std::string bytes_;
+};
+
+/// Reads the fields of a payload in order, checking every read fits.
+class PayloadReader
+{
+public:
+    PayloadReader(std::string_view bytes, std::string filename)
+        : bytes_(bytes), filename_(std::move(filename))
+    {
+    }
+
+    std::runtime_error invalid(const std::string &reason) const
+    {
+        return std::runtime_error("Invalid checkpoint file " + filename_ + ": " + reason);
+    }
+
+    template <typename T> T get()
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        if (sizeof(T) > bytes_.size() - pos_)
+        {
+            throw invalid("truncated");
+        }
+        T value;
+        std::memcpy(&value, bytes_.data() + pos_, sizeof(T));
+        pos_ += sizeof(T);
+        return value;
+    }
+
+    template <typename T> std::vector<T> getArray()
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        const auto count = get<uint64_t>();
+        if (count > (bytes_.size() - pos_) / sizeof(T))
+        {
+            throw invalid("truncated");
+        }
+        std::vector<T> values(count);
+        std::memcpy(values.data(), bytes_.data() + pos_, count * sizeof(T));
+        pos_ += count * sizeof(T);
+        return values;
+    }
+
+    std::string getString()
+    {
+        const auto values = getArray<char>();
+        return std::string(values.begin(), values.end());
+    }
+
+    bool atEnd() const noexcept { return pos_ == bytes_.size(); }
+
+private:
+    std::string_view bytes_;
+    std::string filename_;
+    size_t pos_ = 0;
+};
+
+/// Raises when a checkpoint field differs from the run resuming from it.
+template <typename T>
+void checkMatch(const char *field, const T &saved, const T &current)
+{
+    if (saved != current)
+    {
+        auto text = [](const T &value)
+        {
+            if constexpr (std::is_same_v<T, std::string>)
+            {
+                return value;
+            }
+            else
+            {
+                return std::to_string(value);
+            }
+        };
+        throw std::invalid_argument(std::string("Checkpoint was taken with ") + field
+                                    + " " + text(saved) + ", not " + text(current));
+    }
+}
+}  // namespace
+
+Checkpoint
+Checkpoint::capture(Config config, const Population &population, const Graph &graph)
+{
+    Checkpoint checkpoint;
+    checkpoint.config = std::move(config);
+    checkpoint.population = population.snapshot();
+    checkpoint.graphGenerator = graph.generator().state();
+    checkpoint.numNodes = static_cast<uint64_t>(graph.getNumNodes());
+    return checkpoint;
+}
+
+void Checkpoint::restore(const Config &config,
+                         Population &population,
+                         const Graph &graph) const
+{
+    checkMatch("problem type", this->config.problemType, config.problemType);
+    checkMatch("budget", this->config.budget, config.budget);
+    checkMatch("search", this->config.search, config.search);
+    checkMatch("crossover", this->config.crossover, config.crossover);
+    checkMatch("node count", numNodes, static_cast<uint64_t>(graph.getNumNodes()));
+    if (!RandomNumberGenerator::isValidState(graphGenerator))
+    {
+        throw std::invalid_argument("Checkpoint has an all-zero generator state");
+    }
+
+    population.restore(this->population);
+    graph.generator().setState(graphGenerator);
+}
+
+void Checkpoint::save(const std::string &filename) const
+{
+    PayloadWriter payload;
+    payload.putString(config.problemType);
+    payload.putString(config.search);
+    payload.putString(config.crossover);
+    payload.put<uint64_t>(population.solutions.size());
+    for (const auto &solution : population.solutions)
+    {
+        payload.putArray(solution);
+    }
+    payload.putArray(population.objValues);
+    payload.putArray(population.fitness);
+    payload.putArray(population.ids);
+    payload.putArray(population.similaritySums);
+    payload.putArray(population.similarities);
+    payload.put<uint8_t>(population.fitnessStale);
+    payload.put(population.nextItemId);
+    payload.put(population.rng);
+    payload.put(population.searchSeeds);
+    payload.putArray(population.tabuQueue);
+    payload.put(population.tabuArchiveSize);
+
+    payload.put(graphGenerator);
+    payload.put(seedStream);
+    payload.putArray(bestSolution);
+    payload.put(bestObjValue);
+    payload.put(numGenerations);
+    payload.put(numIdleGenerations);
+    payload.put(numSearchSteps);
+    payload.put(runtime);
+    payload.put(bestFoundAtTime);
+
+    CheckpointHeader header{};
+    std::memcpy(header.magic, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+    header.version = CHECKPOINT_VERSION;
+    header.byteOrderMark = BYTE_ORDER_MARK;
+    header.numNodes = numNodes;
+    header.budget = config.budget;
+    header.payloadBytes = payload.bytes().size();
+
+    // Renaming replaces the destination at once; until then a reader sees
+    // the previous checkpoint.
+    const std::string temporary = filename + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            throw std::runtime_error("Cannot open file for writing: " + temporary);
+        }
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        file.write(payload.bytes().data(),
+                   static_cast<std::streamsize>(payload.bytes().size()));
+        file.close();
+        if (!file)
+        {
+            throw std::runtime_error("Cannot write file: " + temporary);
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporary, filename, error);
+    if (error)
+    {
+        throw std::runtime_error("Cannot write file: " + filename + ": " + error.message());
+    }
+}
+
+Checkpoint Checkpoint::load(const std::string &filename)
+{
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open())
+    {
+        throw std::runtime_error("Cannot open file: " + filename);
+    }
+    const std::string data((std::istreambuf_iterator<char>(file)),
+                           std::istreambuf_iterator<char>());
+
+    PayloadReader headerReader(data, filename);
+    if (data.size() < sizeof(CheckpointHeader)
+        || std::memcmp(data.data(), CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC)) != 0)
+    {
+        throw headerReader.invalid("missing header");
+    }
+
+    const auto header = headerReader.get<CheckpointHeader>();
+    if (header.byteOrderMark != BYTE_ORDER_MARK)
+    {
+        throw headerReader.invalid("written with another byte order");
+    }
+    if (header.version != CHECKPOINT_VERSION)
+    {
+        throw headerReader.invalid("unsupported version "
+                                   + std::to_string(header.version));
+    }
+    if (header.numNodes > static_cast<uint64_t>(std::numeric_limits<Node>::max())
+        || header.payloadBytes != data.size() - sizeof(CheckpointHeader))
+    {
+        throw headerReader.invalid("bad header");
+    }
+
+    PayloadReader payload(std::string_view(data).substr(sizeof(CheckpointHeader)),
+                          filename);
+    const auto numNodes = static_cast<Node>(header.numNodes);
+    auto nodes = [&]() {
+        auto values = payload.getArray<Node>();
+        for (Node node : values)
+        {
+            if (node < 0 || node >= numNodes)
+            {
+                throw payload.invalid("node out of range");
+            }
+        }
+        return values;
+    };
+
+    Checkpoint checkpoint;
+    checkpoint.numNodes = header.numNodes;
+    checkpoint.config.budget = header.budget;
+    checkpoint.config.problemType = payload.getString();
+    checkpoint.config.search = payload.getString();
+    checkpoint.config.crossover = payload.getString();
+
+    Population::Snapshot &population = checkpoint.population;
+    const auto popSize = payload.get<uint64_t>();
+    if (popSize > header.payloadBytes / sizeof(uint64_t))
+    {
+        throw payload.invalid("truncated");
+    }
+    population.solutions.reserve(popSize);
+    for (uint64_t i = 0; i < popSize; ++i)
+    {
+        population.solutions.push_back(nodes());
+    }
+    population.objValues = payload.getArray<ObjValue>();
+    population.fitness = payload.getArray<double>();
+    population.ids = payload.getArray<uint64_t>();
+    population.similaritySums = payload.getArray<double>();
+    population.similarities = payload.getArray<double>();
+    population.fitnessStale = payload.get<uint8_t>() != 0;
+    population.nextItemId = payload.get<uint64_t>();
+    population.rng = payload.get<RandomNumberGenerator::State>();
+    population.searchSeeds = payload.get<RandomNumberGenerator::State>();
+    population.tabuQueue = payload.getArray<uint64_t>();
+    population.tabuArchiveSize = payload.get<uint64_t>();
+
+    if (population.objValues.size() != popSize || population.fitness.size() != popSize
+        || population.ids.size() != popSize || population.similaritySums.size() != popSize
+        || population.similarities.size() != popSize * (popSize - 1) / 2)
+    {
+        throw payload.invalid("inconsistent population");
+    }
+
+    checkpoint.graphGenerator = payload.get<RandomNumberGenerator::State>();
+    checkpoint.seedStream = payload.get<RandomNumberGenerator::State>();
+    checkpoint.bestSolution = nodes();
+    checkpoint.bestObjValue = payload.get<ObjValue>();
+    checkpoint.numGenerations = payload.get<int64_t>();
+    checkpoint.numIdleGenerations = payload.get<int64_t>();
+    checkpoint.numSearchSteps = payload.get<int64_t>();
+    checkpoint.runtime = payload.get<double>();
+    checkpoint.bestFoundAtTime = payload.get<double>();
+
+    if (!payload.atEnd())
+    {
+        throw payload.invalid("trailing data");
+    }
+    return checkpoint;
+}
+
+CheckpointWriter::CheckpointWriter() : thread_([this] { writeLoop(); }) {}
+
+CheckpointWriter::~CheckpointWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    changed_.notify_all();
+    thread_.join();
+}
+
+void CheckpointWriter::submit(Checkpoint checkpoint, std::string filename)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_.emplace(std::move(checkpoint), std::move(filename));
+    }
+    changed_.notify_all();
+}
+
+void CheckpointWriter::wait()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    changed_.wait(lock, [this] { return !pending_ && !writing_; });
+    if (error_)
+    {
+        std::exception_ptr error = std::exchange(error_, nullptr);
+        std::rethrow_exception(error);
+    }
+}
+
+size_t CheckpointWriter::numWritten() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return numWritten_;
+}
+
+void CheckpointWriter::writeLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true)
+    {
+        // A queued checkpoint is still written when stopping.
+        changed_.wait(lock, [this] { return pending_ || stopping_; });
+        if (!pending_)
+        {
+            return;
+        }
+
+        auto [checkpoint, filename] = std::move(*pending_);
+        pending_.reset();
+        writing_ = true;
+        lock.unlock();
+
+        std::exception_ptr error;
+        try
+        {
+            checkpoint.save(filename);
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+
+        lock.lock();
+        writing_ = false;
+        if (error)
+        {
+            error_ = error;
+        }
+        else
+        {
+            ++numWritten_;
+        }
+        changed_.notify_all();
+    }
+}
@@ -0,0 +1,194 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include "Graph/Graph.h"
+#include "Graph/Types.h"
+#include "Population.h"
+#include "RandomNumberGenerator.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * Checkpoint
+ *
+ * State of a memetic search between two generations: the population with
+ * its cached similarities, the generators, the generation counters and the
+ * best solution. A run resumed from a checkpoint continues exactly as the
+ * run it was taken from, without searching the population again.
+ *
+ * Checkpoints are saved in a compact binary file: a fixed header (magic,
+ * version, byte-order mark, node count, budget and payload size) followed
+ * by the fields in declaration order, node lists as int32. The run
+ * configuration is saved with the state, so a checkpoint is only restored
+ * into a run configured the same way. A file is written next
+ * to its destination and renamed over it, so a run stopped while saving
+ * leaves the previous checkpoint intact.
+ */
+struct Checkpoint
+{
+    /// Configuration of a run that must match for a checkpoint to resume.
+    struct Config
+    {
+        std::string problemType;
+        int64_t budget = 0;
+        std::string search;     ///< Local search strategy
+        std::string crossover;  ///< Crossover strategy
+
+        bool operator==(const Config &other) const = default;
+    };
+
+    Config config;                                   ///< Run checkpointed
+    Population::Snapshot population;                 ///< Individuals and caches
+    RandomNumberGenerator::State graphGenerator{};   ///< Draws random start graphs
+    RandomNumberGenerator::State seedStream{};       ///< Draws offspring seeds
+    std::vector<Node> bestSolution;
+    ObjValue bestObjValue = 0;
+    int64_t numGenerations = 0;
+    int64_t numIdleGenerations = 0;
+    int64_t numSearchSteps = 0;
+    double runtime = 0.0;          ///< Seconds run before the checkpoint
+    double bestFoundAtTime = 0.0;  ///< Seconds into the run of the best
+    uint64_t numNodes = 0;         ///< Nodes of the graph searched
+
+    /**
+     * Takes the configuration, population and graph parts of a checkpoint.
+     *
+     * The copy is cheap next to a generation; the remaining fields are set
+     * by the caller.
+     *
+     * Parameters
+     * ----------
+     * config
+     *     Configuration of the run.
+     * population
+     *     Population of the search.
+     * graph
+     *     Original graph of the search, whose generator draws start graphs.
+     */
+    static Checkpoint
+    capture(Config config, const Population &population, const Graph &graph);
+
+    /**
+     * Restores the population and graph parts of this checkpoint.
+     *
+     * Nothing is changed when the checkpoint does not fit the run.
+     *
+     * Parameters
+     * ----------
+     * config
+     *     Configuration of the run resuming from the checkpoint.
+     * population
+     *     A population constructed with the configuration of the run.
+     * graph
+     *     Original graph of the run.
+     *
+     * Raises
+     * ------
+     * std::invalid_argument
+     *     If the checkpoint was taken with another problem type, budget,
+     *     search or crossover, on a graph with another node count, or its
+     *     population is inconsistent.
+     */
+    void restore(const Config &config, Population &population, const Graph &graph) const;
+
+    /**
+     * Saves the checkpoint to a binary file.
+     *
+     * Parameters
+     * ----------
+     * filename
+     *     Destination; ``filename + ".tmp"`` is written first.
+     *
+     * Raises
+     * ------
+     * std::runtime_error
+     *     If the file cannot be written.
+     */
+    void save(const std::string &filename) const;
+
+    /**
+     * Loads a checkpoint saved by :meth:`save`.
+     *
+     * Parameters
+     * ----------
+     * filename
+     *     Checkpoint file.
+     *
+     * Raises
+     * ------
+     * std::runtime_error
+     *     If the file cannot be read or is not a valid checkpoint.
+     */
+    static Checkpoint load(const std::string &filename);
+};
+
+/**
+ * CheckpointWriter
+ *
+ * Saves checkpoints on a background thread, so the generation loop does not
+ * wait for the file system.
+ *
+ * :meth:`submit` only queues a checkpoint. A checkpoint still queued when
+ * a newer one arrives is replaced by it, so a slow disk delays checkpoints
+ * but never piles them up. Errors of a write are rethrown by the next
+ * :meth:`wait`.
+ */
+class CheckpointWriter
+{
+public:
+    CheckpointWriter();
+
+    /// Finishes the queued write, discarding its error.
+    ~CheckpointWriter();
+
+    CheckpointWriter(const CheckpointWriter &) = delete;
+    CheckpointWriter &operator=(const CheckpointWriter &) = delete;
+
+    /**
+     * Queues a checkpoint to be saved.
+     *
+     * Parameters
+     * ----------
+     * checkpoint
+     *     Checkpoint to save.
+     * filename
+     *     Destination file.
+     */
+    void submit(Checkpoint checkpoint, std::string filename);
+
+    /**
+     * Waits until every queued checkpoint is saved.
+     *
+     * Raises
+     * ------
+     * std::runtime_error
+     *     The error of a failed write since the last call.
+     */
+    void wait();
+
+    /// Number of checkpoints saved so far.
+    size_t numWritten() const;
+
+private:
+    mutable std::mutex mutex_;
+    std::condition_variable changed_;
+    std::optional<std::pair<Checkpoint, std::string>> pending_;
+    bool writing_ = false;
+    bool stopping_ = false;
+    size_t numWritten_ = 0;
+    std::exception_ptr error_;
+    std::thread thread_;  ///< Last, so it starts after the members above
+
+    void writeLoop();
+};
+
+#endif  // CHECKPOINT_H
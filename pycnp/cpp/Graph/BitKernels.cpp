@@ -0,0 +1,240 @@
+#include "BitKernels.h"
+#include <bit>
+
+#if !defined(PYCNP_NO_SIMD) && defined(__x86_64__)                               \
+    && (defined(__GNUC__) || defined(__clang__))
+#define PYCNP_X86_KERNELS 1
+#include <immintrin.h>
+#elif !defined(PYCNP_NO_SIMD) && defined(__aarch64__) && defined(__ARM_NEON)
+#define PYCNP_NEON_KERNELS 1
+#include <arm_neon.h>
+#endif
+
+namespace
+{
+struct Kernels
+{
+    size_t (*popcount)(const uint64_t *, size_t) noexcept;
+    size_t (*andPopcount)(const uint64_t *, const uint64_t *, size_t) noexcept;
+    const char *name;
+};
+
+size_t popcountScalar(const uint64_t *words, size_t count) noexcept
+{
+    size_t total = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        total += std::popcount(words[i]);
+    }
+    return total;
+}
+
+size_t andPopcountScalar(const uint64_t *lhs,
+                         const uint64_t *rhs,
+                         size_t count) noexcept
+{
+    size_t total = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        total += std::popcount(lhs[i] & rhs[i]);
+    }
+    return total;
+}
+
+#ifdef PYCNP_X86_KERNELS
+// Same loops as the portable ones, but compiled to the POPCNT instruction,
+// which the x86-64 baseline does not include.
+__attribute__((target("popcnt"))) size_t
+popcountPopcnt(const uint64_t *words, size_t count) noexcept
+{
+    size_t total = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        total += __builtin_popcountll(words[i]);
+    }
+    return total;
+}
+
+__attribute__((target("popcnt"))) size_t
+andPopcountPopcnt(const uint64_t *lhs, const uint64_t *rhs, size_t count) noexcept
+{
+    size_t total = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        total += __builtin_popcountll(lhs[i] & rhs[i]);
+    }
+    return total;
+}
+
+// Per-byte counts through a nibble lookup table, summed per 64-bit lane.
+__attribute__((target("avx2"))) inline __m256i laneCounts(__m256i v) noexcept
+{
+    const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3,
+                                            1, 2, 2, 3, 2, 3, 3, 4,
+                                            0, 1, 1, 2, 1, 2, 2, 3,
+                                            1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i lowNibbles = _mm256_set1_epi8(0x0f);
+
+    const __m256i lo = _mm256_and_si256(v, lowNibbles);
+    const __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), lowNibbles);
+    const __m256i bytes = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo),
+                                          _mm256_shuffle_epi8(lookup, hi));
+    return _mm256_sad_epu8(bytes, _mm256_setzero_si256());
+}
+
+__attribute__((target("avx2"))) inline size_t
+horizontalSum(__m256i lanes) noexcept
+{
+    alignas(32) uint64_t sums[4];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(sums), lanes);
+    return sums[0] + sums[1] + sums[2] + sums[3];
+}
+
+__attribute__((target("avx2"))) size_t
+popcountAvx2(const uint64_t *words, size_t count) noexcept
+{
+    __m256i total = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m256i v = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i *>(words + i));
+        total = _mm256_add_epi64(total, laneCounts(v));
+    }
+    return horizontalSum(total) + popcountScalar(words + i, count - i);
+}
+
+__attribute__((target("avx2"))) size_t
+andPopcountAvx2(const uint64_t *lhs, const uint64_t *rhs, size_t count) noexcept
+{
+    __m256i total = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m256i v = _mm256_and_si256(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lhs + i)),
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(rhs + i)));
+        total = _mm256_add_epi64(total, laneCounts(v));
+    }
+    return horizontalSum(total)
+           + andPopcountScalar(lhs + i, rhs + i, count - i);
+}
+
+// Summed through memory: _mm512_reduce_add_epi64 trips -Wuninitialized in
+// the intrinsic headers of some GCC releases.
+__attribute__((target("avx512f"))) inline size_t
+horizontalSum(__m512i lanes) noexcept
+{
+    alignas(64) uint64_t sums[8];
+    _mm512_store_si512(sums, lanes);
+    size_t total = 0;
+    for (uint64_t sum : sums)
+    {
+        total += sum;
+    }
+    return total;
+}
+
+__attribute__((target("avx512f,avx512vpopcntdq"))) size_t
+popcountAvx512(const uint64_t *words, size_t count) noexcept
+{
+    __m512i total = _mm512_setzero_si512();
+    for (size_t i = 0; i < count; i += 8)
+    {
+        // The mask covers the partial last block, so no scalar tail.
+        const __mmask8 mask
+            = count - i >= 8 ? 0xff : static_cast<__mmask8>((1u << (count - i)) - 1);
+        const __m512i v = _mm512_maskz_loadu_epi64(mask, words + i);
+        total = _mm512_add_epi64(total, _mm512_popcnt_epi64(v));
+    }
+    return horizontalSum(total);
+}
+
+__attribute__((target("avx512f,avx512vpopcntdq"))) size_t
+andPopcountAvx512(const uint64_t *lhs, const uint64_t *rhs, size_t count) noexcept
+{
+    __m512i total = _mm512_setzero_si512();
+    for (size_t i = 0; i < count; i += 8)
+    {
+        const __mmask8 mask
+            = count - i >= 8 ? 0xff : static_cast<__mmask8>((1u << (count - i)) - 1);
+        const __m512i v = _mm512_and_si512(_mm512_maskz_loadu_epi64(mask, lhs + i),
+                                           _mm512_maskz_loadu_epi64(mask, rhs + i));
+        total = _mm512_add_epi64(total, _mm512_popcnt_epi64(v));
+    }
+    return horizontalSum(total);
+}
+#endif  // PYCNP_X86_KERNELS
+
+#ifdef PYCNP_NEON_KERNELS
+size_t popcountNeon(const uint64_t *words, size_t count) noexcept
+{
+    size_t total = 0;
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        const uint8x16_t v = vreinterpretq_u8_u64(vld1q_u64(words + i));
+        total += vaddlvq_u8(vcntq_u8(v));
+    }
+    return total + popcountScalar(words + i, count - i);
+}
+
+size_t andPopcountNeon(const uint64_t *lhs, const uint64_t *rhs, size_t count) noexcept
+{
+    size_t total = 0;
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        const uint64x2_t v = vandq_u64(vld1q_u64(lhs + i), vld1q_u64(rhs + i));
+        total += vaddlvq_u8(vcntq_u8(vreinterpretq_u8_u64(v)));
+    }
+    return total + andPopcountScalar(lhs + i, rhs + i, count - i);
+}
+#endif  // PYCNP_NEON_KERNELS
+
+Kernels selectKernels() noexcept
+{
+#if defined(PYCNP_X86_KERNELS)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")
+        && __builtin_cpu_supports("avx512vpopcntdq"))
+    {
+        return {popcountAvx512, andPopcountAvx512, "avx512"};
+    }
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return {popcountAvx2, andPopcountAvx2, "avx2"};
+    }
+    if (__builtin_cpu_supports("popcnt"))
+    {
+        return {popcountPopcnt, andPopcountPopcnt, "popcnt"};
+    }
+#elif defined(PYCNP_NEON_KERNELS)
+    return {popcountNeon, andPopcountNeon, "neon"};
+#endif
+    return {popcountScalar, andPopcountScalar, "scalar"};
+}
+
+const Kernels &kernels() noexcept
+{
+    static const Kernels selected = selectKernels();
+    return selected;
+}
+}  // namespace
+
+size_t BitKernels::popcount(const uint64_t *words, size_t count) noexcept
+{
+    return kernels().popcount(words, count);
+}
+
+size_t BitKernels::andPopcount(const uint64_t *lhs,
+                               const uint64_t *rhs,
+                               size_t count) noexcept
+{
+    return kernels().andPopcount(lhs, rhs, count);
+}
+
+const char *BitKernels::activeKernel() noexcept
+{
+    return kernels().name;
+}
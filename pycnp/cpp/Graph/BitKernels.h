@@ -0,0 +1,61 @@
+#ifndef BIT_KERNELS_H
+#define BIT_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * BitKernels
+ *
+ * Population counts over rows of 64-bit words, as used by the bitset K-hop
+ * tree storage.
+ *
+ * On x86-64 the fastest of AVX-512 VPOPCNTDQ, AVX2, POPCNT and a portable
+ * loop is picked at run time from the CPU, so binaries built for the
+ * baseline architecture still use the wide kernels where they exist. ARM64
+ * always has NEON and uses it directly. Defining ``PYCNP_NO_SIMD`` (meson
+ * option ``simd=false``) keeps only the portable loop.
+ */
+namespace BitKernels
+{
+/**
+ * Counts the set bits of ``words[0, count)``.
+ *
+ * Parameters
+ * ----------
+ * words : list[int]
+ *     The words to count.
+ * count : int
+ *     Number of words.
+ *
+ * Returns
+ * -------
+ * int
+ *     Number of set bits.
+ */
+size_t popcount(const uint64_t *words, size_t count) noexcept;
+
+/**
+ * Counts the bits set in both ``lhs[0, count)`` and ``rhs[0, count)``.
+ *
+ * Parameters
+ * ----------
+ * lhs : list[int]
+ *     First row of words.
+ * rhs : list[int]
+ *     Second row of words.
+ * count : int
+ *     Number of words in each row.
+ *
+ * Returns
+ * -------
+ * int
+ *     Number of set bits of the word-wise AND.
+ */
+size_t andPopcount(const uint64_t *lhs, const uint64_t *rhs, size_t count) noexcept;
+
+/// Returns the name of the selected kernel set, e.g. ``"avx2"``.
+const char *activeKernel() noexcept;
+}  // namespace BitKernels
+
+#endif  // BIT_KERNELS_H
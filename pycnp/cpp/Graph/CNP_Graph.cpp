@@ -1,62 +1,247 @@
 #include "CNP_Graph.h"
+#include "Trace.h"
+
 #include <algorithm>
+#include <limits>
 #include <numeric>  // Include for std::iota
 
-CNP_Graph::CNP_Graph(NodeSet nodes,
-                     std::vector<NodeSet> adjList,
+CNP_Graph::CNP_Graph(const NodeSet &nodes,
+                     std::shared_ptr<const CSRGraph> topology,
                      int budget,
-                     int seed)
+                     int seed,
+                     std::shared_ptr<const std::vector<int>> nodeWeights,
+                     ObjectiveKind objective)
+    : topology_(std::move(topology)),
+      nodeWeights_(std::move(nodeWeights)),
+      objective_(objective)
 {
-    numNodes_ = nodes.size();
-    originalNodesSet_ = nodes;
-    initialNodesSet_ = nodes;
+    numNodes_ = topology_->numNodes();
     nodeAge_.resize(numNodes_, 0);
-    currentAdjList_ = adjList;
-    originalAdjList_ = adjList;
-    initialAdjList_ = adjList;
+    nodeFlags_.assign(numNodes_, NODE_EXCLUDED);
+    for (Node node : nodes)
+    {
+        nodeFlags_[node] = NODE_ACTIVE;
+    }
     numToRemove_ = budget;
-    initialNumToRemove_ = budget;
+    removedNodes = Solution(numNodes_);
+    removedNodes.reserve(budget);
     nodeToComponentIndex_.resize(numNodes_, -1);
     rng_.setSeed(seed);
-    initialSeed_ = seed;
-    componentVisited_.resize(numNodes_, 0);
-    dfsVisitEpoch_.resize(numNodes_, 0);
-    dfsStack_.reserve(numNodes_);
+    workspace_.componentVisited.resize(numNodes_, 0);
+    workspace_.dfsVisitEpoch.resize(numNodes_, 0);
+    workspace_.dfsStack.reserve(numNodes_);
+}
+
+CNP_Graph::CNP_Graph(const CNP_Graph &other, const Solution &nodesToRemove)
+    : numNodes_(other.numNodes_),
+      nodeAge_(other.nodeAge_),
+      topology_(other.topology_),
+      nodeFlags_(other.nodeFlags_),
+      nodeWeights_(other.nodeWeights_),
+      objective_(other.objective_),
+      numToRemove_(other.numToRemove_),
+      nodeToComponentIndex_(other.numNodes_, -1),
+      rng_(other.rng_),
+      removedNodes(other.numNodes_)
+{
+    removedNodes.reserve(std::max(numToRemove_, 0));
+    updateGraphByRemovedNodes(nodesToRemove);
+}
+
+int CNP_Graph::nextVisitEpoch() const
+{
+    if (workspace_.dfsVisitEpoch.size() < static_cast<size_t>(numNodes_))
+    {
+        workspace_.dfsVisitEpoch.assign(numNodes_, 0);
+        workspace_.dfsCurrentEpoch = 0;
+    }
+
+    if (workspace_.dfsCurrentEpoch == std::numeric_limits<int>::max())
+    {
+        workspace_.dfsCurrentEpoch = 0;
+        std::fill(workspace_.dfsVisitEpoch.begin(),
+                  workspace_.dfsVisitEpoch.end(),
+                  0);
+        std::fill(workspace_.componentEpoch.begin(),
+                  workspace_.componentEpoch.end(),
+                  0);
+    }
+
+    return ++workspace_.dfsCurrentEpoch;
+}
+
+ComponentIndex CNP_Graph::allocateComponent()
+{
+    ComponentIndex componentIndex;
+    if (!freeComponentSlots_.empty())
+    {
+        componentIndex = freeComponentSlots_.back();
+        freeComponentSlots_.pop_back();
+    }
+    else
+    {
+        componentIndex = static_cast<ComponentIndex>(connectedComponents_.size());
+        connectedComponents_.emplace_back();
+        componentLivePos_.push_back(0);
+    }
+
+    componentLivePos_[componentIndex] = liveComponents_.size();
+    liveComponents_.push_back(componentIndex);
+    return componentIndex;
+}
+
+void CNP_Graph::releaseComponent(ComponentIndex componentIndex)
+{
+    Component &component = connectedComponents_[componentIndex];
+    component.nodes.clear();
+    component.size = 0;
+    component.weight = 0;
+    component.squaredWeight = 0;
+
+    stampComponent(componentIndex);
+
+    const size_t pos = componentLivePos_[componentIndex];
+    const ComponentIndex last = liveComponents_.back();
+    liveComponents_[pos] = last;
+    componentLivePos_[last] = pos;
+    liveComponents_.pop_back();
+
+    freeComponentSlots_.push_back(componentIndex);
+}
+
+void CNP_Graph::appendToComponent(ComponentIndex componentIndex, Node node)
+{
+    Component &component = connectedComponents_[componentIndex];
+    nodePosition_[node] = component.nodes.size();
+    nodeToComponentIndex_[node] = componentIndex;
+    component.nodes.push_back(node);
+    component.size++;
+    component.weight += nodeWeight(node);
+    component.squaredWeight += int64_t{nodeWeight(node)} * nodeWeight(node);
+
+    stampComponent(componentIndex);
+    invalidateNeighborGains(node);
+}
+
+void CNP_Graph::eraseFromComponent(ComponentIndex componentIndex, Node node)
+{
+    Component &component = connectedComponents_[componentIndex];
+    const size_t pos = nodePosition_[node];
+    const Node last = component.nodes.back();
+    component.nodes[pos] = last;
+    nodePosition_[last] = pos;
+    component.nodes.pop_back();
+    component.size--;
+    component.weight -= nodeWeight(node);
+    component.squaredWeight -= int64_t{nodeWeight(node)} * nodeWeight(node);
+    nodeToComponentIndex_[node] = -1;
+
+    stampComponent(componentIndex);
+}
+
+ObjValue CNP_Graph::componentCost(ComponentIndex componentIndex) const
+{
+    const Component &component = connectedComponents_[componentIndex];
+    return visitObjective(objective_, [&](auto policy) {
+        return decltype(policy)::cost(component.weight, component.squaredWeight);
+    });
+}
+
+void CNP_Graph::addComponentCost(ComponentIndex componentIndex)
+{
+    // The largest component is not a running sum; getObjectiveValue()
+    // scans for it instead.
+    if (objective_ != ObjectiveKind::LargestComponent)
+    {
+        componentCostSum_ += componentCost(componentIndex);
+    }
+}
+
+void CNP_Graph::subtractComponentCost(ComponentIndex componentIndex)
+{
+    if (objective_ != ObjectiveKind::LargestComponent)
+    {
+        componentCostSum_ -= componentCost(componentIndex);
+    }
+}
+
+void CNP_Graph::stampComponent(ComponentIndex componentIndex)
+{
+    if (gainCache_.entries.empty() && impactCache_.entries.empty())
+    {
+        return;
+    }
+
+    auto &slotStamps = gainCache_.slotStamps;
+    if (static_cast<size_t>(componentIndex) >= slotStamps.size())
+    {
+        slotStamps.resize(connectedComponents_.size(), 0);
+    }
+    slotStamps[componentIndex] = gainCache_.move;
+}
+
+void CNP_Graph::invalidateNeighborGains(Node node)
+{
+    if (gainCache_.entries.empty())
+    {
+        return;
+    }
+
+    for (Node neighbor : topology_->neighbors(node))
+    {
+        gainCache_.entries[neighbor].valid = false;
+    }
 }
 
 void CNP_Graph::initializeComponentsAndMapping()
 {
     std::fill(nodeToComponentIndex_.begin(), nodeToComponentIndex_.end(), -1);
+    nodePosition_.resize(numNodes_, 0);
 
     connectedComponents_.clear();
-    connectedPairs_ = 0;
+    liveComponents_.clear();
+    componentLivePos_.clear();
+    freeComponentSlots_.clear();
+    componentCostSum_ = 0;
 
-    ComponentIndex componentIndex = 0;
-    if (componentVisited_.size() < static_cast<size_t>(numNodes_))
+    gainCache_.move++;
+    for (auto &entry : gainCache_.entries)
     {
-        componentVisited_.resize(numNodes_, 0);
+        entry.valid = false;
     }
-    std::fill(componentVisited_.begin(),
-              componentVisited_.begin() + numNodes_,
+    // Slots are renumbered, so cached impacts no longer match their slot.
+    for (auto &entry : impactCache_.entries)
+    {
+        entry.valid = false;
+    }
+
+    if (workspace_.componentVisited.size() < static_cast<size_t>(numNodes_))
+    {
+        workspace_.componentVisited.resize(numNodes_, 0);
+    }
+    std::fill(workspace_.componentVisited.begin(),
+              workspace_.componentVisited.begin() + numNodes_,
               static_cast<char>(0));
 
-    for (Node node : originalNodesSet_)
+    for (Node node = 0; node < numNodes_; ++node)
     {
-        if (!componentVisited_[node] && !isNodeRemoved(node))
+        if (!workspace_.componentVisited[node] && isNodeActive(node))
         {
             Component component = dfsFindComponent(node);
             if (!component.nodes.empty())
             {
-                connectedComponents_.push_back(component);
+                const ComponentIndex componentIndex = allocateComponent();
 
-                for (Node componentNode : component.nodes)
+                for (size_t i = 0; i < component.nodes.size(); ++i)
                 {
-                    componentVisited_[componentNode] = 1;
+                    const Node componentNode = component.nodes[i];
+                    workspace_.componentVisited[componentNode] = 1;
                     nodeToComponentIndex_[componentNode] = componentIndex;
+                    nodePosition_[componentNode] = i;
                 }
-                componentIndex++;
 
-                connectedPairs_ += (component.size * (component.size - 1)) / 2;
+                connectedComponents_[componentIndex] = std::move(component);
+                addComponentCost(componentIndex);
             }
         }
     }
@@ -65,43 +250,32 @@ void CNP_Graph::initializeComponentsAndMapping()
 Component CNP_Graph::dfsFindComponent(Node startNode) const
 {
     Component newComponent;
-    newComponent.nodes.reserve(numNodes_);
-
-    if (dfsVisitEpoch_.size() < static_cast<size_t>(numNodes_))
-    {
-        dfsVisitEpoch_.resize(numNodes_, 0);
-        dfsCurrentEpoch_ = 0;
-    }
+    const int epoch = nextVisitEpoch();
+    auto &visitEpoch = workspace_.dfsVisitEpoch;
 
-    if (++dfsCurrentEpoch_ == 0)
-    {
-        dfsCurrentEpoch_ = 1;
-        std::fill(dfsVisitEpoch_.begin(), dfsVisitEpoch_.begin() + numNodes_, 0);
-    }
+    workspace_.dfsStack.clear();
+    workspace_.dfsStack.push_back(startNode);
 
-    dfsStack_.clear();
-    dfsStack_.push_back(startNode);
-
-    while (!dfsStack_.empty())
+    while (!workspace_.dfsStack.empty())
     {
-        Node node = dfsStack_.back();
-        dfsStack_.pop_back();
+        Node node = workspace_.dfsStack.back();
+        workspace_.dfsStack.pop_back();
 
-        if (dfsVisitEpoch_[node] == dfsCurrentEpoch_ || isNodeRemoved(node))
+        if (visitEpoch[node] == epoch || !isNodeActive(node))
         {
             continue;
         }
 
-        dfsVisitEpoch_[node] = dfsCurrentEpoch_;
+        visitEpoch[node] = epoch;
         newComponent.nodes.push_back(node);
+        newComponent.weight += nodeWeight(node);
+        newComponent.squaredWeight += int64_t{nodeWeight(node)} * nodeWeight(node);
 
-        const auto &neighbors = currentAdjList_[node];
-        for (const Node &neighbor : neighbors)
+        for (Node neighbor : topology_->neighbors(node))
         {
-            if (dfsVisitEpoch_[neighbor] != dfsCurrentEpoch_
-                && !isNodeRemoved(neighbor))
+            if (visitEpoch[neighbor] != epoch && isNodeActive(neighbor))
             {
-                dfsStack_.push_back(neighbor);
+                workspace_.dfsStack.push_back(neighbor);
             }
         }
     }
@@ -110,299 +284,364 @@ Component CNP_Graph::dfsFindComponent(Node startNode) const
     return newComponent;
 }
 
-void CNP_Graph::updateGraphByRemovedNodes(const NodeSet &nodesToRemove)
+void CNP_Graph::updateGraphByRemovedNodes(const Solution &nodesToRemove)
 {
     removedNodes.clear();
-    currentAdjList_ = originalAdjList_;
-
-    for (Node node : nodesToRemove)
+    for (NodeFlags &flags : nodeFlags_)
     {
-        removedNodes.insert(node);
+        flags &= ~NODE_REMOVED;
     }
 
     for (Node node : nodesToRemove)
     {
-        for (Node neighbor : originalAdjList_[node])
-        {
-            currentAdjList_[neighbor].erase(node);
-        }
-        currentAdjList_[node].clear();
+        removedNodes.insert(node);
+        nodeFlags_[node] |= NODE_REMOVED;
     }
 
     initializeComponentsAndMapping();
 }
 
-void CNP_Graph::getReducedGraphByRemovedNodes(const NodeSet &removeSet)
+void CNP_Graph::getReducedGraphByRemovedNodes(const Solution &removeSet)
 {
     removedNodes.clear();
     numToRemove_ -= removeSet.size();
 
-    for (Node node : removeSet)
+    for (NodeFlags &flags : nodeFlags_)
     {
-        originalNodesSet_.erase(node);
+        flags &= ~NODE_REMOVED;
+    }
 
-        for (Node neighbor : originalAdjList_[node])
-        {
-            originalAdjList_[neighbor].erase(node);
-        }
-        originalAdjList_[node].clear();
+    for (Node node : removeSet)
+    {
+        nodeFlags_[node] |= NODE_EXCLUDED;
     }
 
-    currentAdjList_ = originalAdjList_;
     initializeComponentsAndMapping();
 }
 
 void CNP_Graph::addNode(Node nodeToAdd)
 {
+    PYCNP_TRACE_COUNT(NodeAdditions);
+    gainCache_.move++;
     removedNodes.erase(nodeToAdd);
-    ComponentIndex componentIndex = -1;
+    nodeFlags_[nodeToAdd] &= ~NODE_REMOVED;
 
-    for (Node neighbor : originalAdjList_[nodeToAdd])
+    // The largest neighbouring component absorbs the others, so only the
+    // smaller sides are relabelled.
+    auto &mergeComponents = workspace_.mergeComponents;
+    collectNeighborComponents(nodeToAdd, mergeComponents);
+
+    ComponentIndex target = -1;
+    for (ComponentIndex componentIndex : mergeComponents)
     {
-        if (nodeToComponentIndex_[neighbor] != -1)
+        if (target == -1
+            || connectedComponents_[componentIndex].size
+                   > connectedComponents_[target].size)
         {
-            currentAdjList_[nodeToAdd].insert(neighbor);
-            currentAdjList_[neighbor].insert(nodeToAdd);
-
-            if (componentIndex == -1)
-            {
-                componentIndex = nodeToComponentIndex_[neighbor];
-            }
+            target = componentIndex;
         }
     }
 
-    if (componentIndex != -1)
+    if (target == -1)
     {
-        connectedComponents_[componentIndex].nodes.push_back(nodeToAdd);
-        connectedComponents_[componentIndex].size++;
-        nodeToComponentIndex_[nodeToAdd] = componentIndex;
-
-        Component newComponent = dfsFindComponent(nodeToAdd);
+        // A lone node still connects the leaves folded into it.
+        const ComponentIndex componentIndex = allocateComponent();
+        appendToComponent(componentIndex, nodeToAdd);
+        addComponentCost(componentIndex);
+        return;
+    }
 
-        if (newComponent.size > connectedComponents_[componentIndex].size)
+    subtractComponentCost(target);
+    for (ComponentIndex componentIndex : mergeComponents)
+    {
+        if (componentIndex == target)
         {
-            connectedComponents_[componentIndex].size--;
-
-            std::set<ComponentIndex> componentsIndexesToMerge;
-            for (Node node : newComponent.nodes)
-            {
-                if (nodeToComponentIndex_[node] != -1)
-                {
-                    componentsIndexesToMerge.insert(nodeToComponentIndex_[node]);
-                }
-            }
-
-            std::vector<int> indexMapping(connectedComponents_.size());
-            std::iota(indexMapping.begin(), indexMapping.end(), 0);
-
-            for (ComponentIndex idx : componentsIndexesToMerge)
-            {
-                for (size_t i = idx + 1; i < indexMapping.size(); ++i)
-                {
-                    indexMapping[i]--;
-                }
-            }
-
-            for (Node node : originalNodesSet_)
-            {
-                if (nodeToComponentIndex_[node] != -1)
-                {
-                    nodeToComponentIndex_[node]
-                        = indexMapping[nodeToComponentIndex_[node]];
-                }
-            }
-
-            for (auto it = componentsIndexesToMerge.rbegin();
-                it != componentsIndexesToMerge.rend();
-                ++it)
-            {
-                connectedPairs_ -= (connectedComponents_[*it].size
-                                   * (connectedComponents_[*it].size - 1))
-                                / 2;
-                connectedComponents_.erase(connectedComponents_.begin() + *it);
-            }
-
-            connectedComponents_.push_back(newComponent);
-
-            connectedPairs_ += (newComponent.size * (newComponent.size - 1)) / 2;
-
-            for (Node node : newComponent.nodes)
-            {
-                nodeToComponentIndex_[node] = connectedComponents_.size() - 1;
-            }
+            continue;
         }
-        else if (newComponent.size == connectedComponents_[componentIndex].size)
+
+        PYCNP_TRACE_COUNT(ComponentMerges);
+        subtractComponentCost(componentIndex);
+        for (Node node : connectedComponents_[componentIndex].nodes)
         {
-            connectedPairs_ += (connectedComponents_[componentIndex].size - 1);
+            appendToComponent(target, node);
         }
+        releaseComponent(componentIndex);
     }
-    else
-    {
-        Component newComponent;
-        newComponent.nodes.push_back(nodeToAdd);
-        newComponent.size = 1;
 
-        connectedComponents_.push_back(newComponent);
-
-        nodeToComponentIndex_[nodeToAdd] = connectedComponents_.size() - 1;
-    }
+    appendToComponent(target, nodeToAdd);
+    addComponentCost(target);
 }
 
 void CNP_Graph::removeNode(Node nodeToRemove)
 {
-    ComponentIndex componentIndex = nodeToComponentIndex_[nodeToRemove];
-    Component originalComponent = connectedComponents_[componentIndex];
+    PYCNP_TRACE_COUNT(NodeRemovals);
+    gainCache_.move++;
+    const ComponentIndex componentIndex = nodeToComponentIndex_[nodeToRemove];
+    // Read before the removal stamps the slot.
+    const ImpactCache::Entry *index = currentBlockCut(componentIndex);
 
     removedNodes.insert(nodeToRemove);
+    nodeFlags_[nodeToRemove] |= NODE_REMOVED;
+    invalidateNeighborGains(nodeToRemove);
+    if (!gainCache_.entries.empty())
+    {
+        gainCache_.entries[nodeToRemove].valid = false;
+    }
 
-    nodeToComponentIndex_[nodeToRemove] = -1;
+    subtractComponentCost(componentIndex);
+    eraseFromComponent(componentIndex, nodeToRemove);
 
-    const auto &neighbors = currentAdjList_[nodeToRemove];
-    for (Node neighbor : neighbors)
+    if (connectedComponents_[componentIndex].size == 0)
     {
-        currentAdjList_[neighbor].erase(nodeToRemove);
+        releaseComponent(componentIndex);
+        return;
     }
-    currentAdjList_[nodeToRemove].clear();
 
-    if (originalComponent.size == 1)
+    if (index != nullptr)
     {
-        for (size_t i = componentIndex + 1; i < connectedComponents_.size(); i++)
-        {
-            for (Node node : connectedComponents_[i].nodes)
-            {
-                nodeToComponentIndex_[node]--;
-            }
-        }
-        connectedComponents_.erase(connectedComponents_.begin() + componentIndex);
+        splitAlongBlockCut(componentIndex, nodeToRemove, *index);
         return;
     }
+    splitComponent(componentIndex, nodeToRemove);
+}
 
-    if (originalComponent.size > 1)
+size_t CNP_Graph::findSearchGroup(size_t search) const
+{
+    auto &parent = workspace_.searchParent;
+    while (parent[search] != search)
     {
-        std::erase(connectedComponents_[componentIndex].nodes, nodeToRemove);
-        connectedComponents_[componentIndex].size--;
+        parent[search] = parent[parent[search]];
+        search = parent[search];
+    }
+    return search;
+}
 
-        std::vector<bool> isVisited(numNodes_, false);
+void CNP_Graph::splitComponent(ComponentIndex componentIndex, Node removedNode)
+{
+    auto &owner = workspace_.searchOwner;
+    auto &frontier = workspace_.searchFrontier;
+    auto &claimed = workspace_.searchClaimed;
+    auto &parent = workspace_.searchParent;
+    auto &active = workspace_.searchActive;
+    auto &slot = workspace_.searchSlot;
+
+    if (owner.size() < static_cast<size_t>(numNodes_))
+    {
+        owner.resize(numNodes_, 0);
+    }
+    const int epoch = nextVisitEpoch();
+    auto &visitEpoch = workspace_.dfsVisitEpoch;
 
-        Node startNode = -1;
-        for (Node node : originalComponent.nodes)
+    // Start one DFS from every remaining neighbour of the removed node.
+    size_t numSearches = 0;
+    for (Node neighbor : topology_->neighbors(removedNode))
+    {
+        if (!isNodeActive(neighbor))
         {
-            if (node != nodeToRemove)
-            {
-                startNode = node;
-                break;
-            }
+            continue;
         }
 
-        Component newComponent = dfsFindComponent(startNode);
-
-        if (newComponent.size < connectedComponents_[componentIndex].size)
+        if (numSearches == frontier.size())
         {
-            connectedPairs_ -= (connectedComponents_[componentIndex].size
-                               * (connectedComponents_[componentIndex].size + 1))
-                              / 2;
+            frontier.emplace_back();
+            claimed.emplace_back();
+        }
+        frontier[numSearches].assign(1, neighbor);
+        claimed[numSearches].assign(1, neighbor);
+        visitEpoch[neighbor] = epoch;
+        owner[neighbor] = static_cast<int>(numSearches);
+        numSearches++;
+    }
 
-            connectedComponents_[componentIndex] = newComponent;
+    if (numSearches <= 1)
+    {
+        addComponentCost(componentIndex);
+        return;
+    }
 
-            connectedPairs_ += (newComponent.size * (newComponent.size - 1)) / 2;
+    parent.resize(numSearches);
+    std::iota(parent.begin(), parent.end(), 0);
+    active.assign(numSearches, 1);
 
-            for (Node node : newComponent.nodes)
+    // Advance the searches in lockstep. Searches that meet are merged into
+    // one group; a group whose searches all run dry has enumerated a whole
+    // fragment. Once a single group is still running, everything it has not
+    // reached belongs to it, so the largest fragment is never walked fully.
+    size_t unfinishedGroups = numSearches;
+    while (unfinishedGroups > 1)
+    {
+        for (size_t search = 0; search < numSearches && unfinishedGroups > 1;
+             ++search)
+        {
+            if (frontier[search].empty())
             {
-                isVisited[node] = true;
-                nodeToComponentIndex_[node] = componentIndex;
+                continue;
             }
 
-            for (Node node : originalComponent.nodes)
+            const Node node = frontier[search].back();
+            frontier[search].pop_back();
+
+            for (Node neighbor : topology_->neighbors(node))
             {
-                if (isVisited[node] || node == nodeToRemove)
+                if (!isNodeActive(neighbor))
+                {
                     continue;
+                }
 
-                Component splitComponent = dfsFindComponent(node);
-                ComponentIndex newIndex = connectedComponents_.size();
-
-                connectedComponents_.push_back(splitComponent);
-
-                connectedPairs_
-                    += (splitComponent.size * (splitComponent.size - 1)) / 2;
+                if (visitEpoch[neighbor] != epoch)
+                {
+                    visitEpoch[neighbor] = epoch;
+                    owner[neighbor] = static_cast<int>(search);
+                    frontier[search].push_back(neighbor);
+                    claimed[search].push_back(neighbor);
+                    continue;
+                }
 
-                for (Node componentNode : splitComponent.nodes)
+                const size_t group = findSearchGroup(search);
+                const size_t other = findSearchGroup(owner[neighbor]);
+                if (group != other)
                 {
-                    nodeToComponentIndex_[componentNode] = newIndex;
-                    isVisited[componentNode] = true;
+                    if (active[group] > 0 && active[other] > 0)
+                    {
+                        unfinishedGroups--;
+                    }
+                    parent[other] = group;
+                    active[group] += active[other];
                 }
             }
+
+            if (frontier[search].empty()
+                && --active[findSearchGroup(search)] == 0)
+            {
+                unfinishedGroups--;
+            }
         }
-        else
+    }
+
+    // The group still running keeps the slot; if every group finished, the
+    // largest one does.
+    slot.assign(numSearches, -1);
+    size_t keptGroup = numSearches;
+    if (unfinishedGroups == 1)
+    {
+        for (size_t search = 0; search < numSearches; ++search)
+        {
+            const size_t group = findSearchGroup(search);
+            if (active[group] > 0)
+            {
+                keptGroup = group;
+                break;
+            }
+        }
+    }
+    else
+    {
+        // All counters are zero here; reuse them as group sizes.
+        for (size_t search = 0; search < numSearches; ++search)
         {
-            connectedPairs_ -= newComponent.size;
+            active[findSearchGroup(search)] += claimed[search].size();
+        }
+        keptGroup = std::distance(
+            active.begin(), std::max_element(active.begin(), active.end()));
+    }
+
+    for (size_t search = 0; search < numSearches; ++search)
+    {
+        const size_t group = findSearchGroup(search);
+        if (group == keptGroup)
+        {
+            continue;
+        }
+
+        if (slot[group] == -1)
+        {
+            PYCNP_TRACE_COUNT(ComponentSplits);
+            slot[group] = allocateComponent();
+        }
+        for (Node node : claimed[search])
+        {
+            eraseFromComponent(componentIndex, node);
+            appendToComponent(slot[group], node);
+        }
+    }
+
+    addComponentCost(componentIndex);
+    for (size_t group = 0; group < numSearches; ++group)
+    {
+        if (slot[group] != -1)
+        {
+            addComponentCost(slot[group]);
         }
     }
 }
 
 ComponentIndex CNP_Graph::selectRemovedComponent() const
 {
-    size_t numComponents = connectedComponents_.size();
-    std::vector<ComponentIndex> largeComponents;
-    largeComponents.reserve(numComponents);
-    if (FILE* dbg = std::fopen("/tmp/pycnp_debug.log", "a"))
-    {
-        std::fprintf(dbg, "[DEBUG] selectRemovedComponent numComponents=%zu removed=%zu\n",
-                     numComponents, removedNodes.size());
-        std::fclose(dbg);
-    }
+    size_t numComponents = liveComponents_.size();
+    PYCNP_TRACE_COUNT(ComponentSelections);
+    PYCNP_TRACE_EVENT(ComponentSelected, numComponents, removedNodes.size());
 
     if (numComponents > 50)
     {
         return selectRemovedLargerComponent();
     }
 
-    int minSize = numNodes_;
-    int maxSize = 0;
+    // Component weights equal their sizes for unit weights; the threshold
+    // and the comparisons below are all in weight units.
+    ObjValue totalWeight = 0;
+    ObjValue minWeight = MAX_OBJ_VALUE;
+    ObjValue maxWeight = 0;
 
-    for (size_t i = 0; i < numComponents; ++i)
+    for (ComponentIndex index : liveComponents_)
     {
-        const size_t size = connectedComponents_[i].size;
-        if (size > 2)
+        const ObjValue weight = connectedComponents_[index].weight;
+        totalWeight += weight;
+        if (weight > 2)
         {
-            minSize = std::min(minSize, static_cast<int>(size));
-            maxSize = std::max(maxSize, static_cast<int>(size));
+            minWeight = std::min(minWeight, weight);
+            maxWeight = std::max(maxWeight, weight);
         }
     }
+    if (maxWeight == 0)
+    {
+        minWeight = totalWeight;
+    }
 
-    const double sizeThreshold
-        = maxSize - (maxSize - minSize) * 0.5 - rng_.generateIndex(3);
+    const double weightThreshold
+        = maxWeight - (maxWeight - minWeight) * 0.5 - rng_.generateIndex(3);
 
-    for (size_t i = 0; i < numComponents; ++i)
+    auto &largeComponents = workspace_.componentCandidates;
+    largeComponents.clear();
+    for (ComponentIndex index : liveComponents_)
     {
-        if (connectedComponents_[i].size >= sizeThreshold)
+        const ObjValue weight = connectedComponents_[index].weight;
+        if (weight >= weightThreshold)
         {
-            largeComponents.push_back(i);
+            largeComponents.push_back(index);
         }
     }
 
     if (largeComponents.empty())
     {
-        // Fallback: choose the largest existing component to avoid hard failure.
+        // Fallback: choose the heaviest existing component to avoid hard
+        // failure.
         ComponentIndex fallbackIndex = 0;
-        size_t fallbackSize = 0;
-        for (size_t i = 0; i < numComponents; ++i)
+        ObjValue fallbackWeight = 0;
+        for (ComponentIndex index : liveComponents_)
         {
-            const size_t size = connectedComponents_[i].size;
-            if (size > fallbackSize)
+            const ObjValue weight = connectedComponents_[index].weight;
+            if (weight > fallbackWeight)
             {
-                fallbackSize = size;
-                fallbackIndex = static_cast<ComponentIndex>(i);
+                fallbackWeight = weight;
+                fallbackIndex = index;
             }
         }
-        if (fallbackSize == 0)
+        if (fallbackWeight == 0)
         {
-        if (FILE* dbg = std::fopen("/tmp/pycnp_debug.log", "a"))
-        {
-            std::fprintf(dbg, "[DEBUG] selectRemovedComponent fallback no components available\n");
-            std::fclose(dbg);
+            PYCNP_TRACE_EVENT(
+                NoComponentAvailable, numComponents, removedNodes.size());
+            throw std::runtime_error("no components available for selection");
         }
-        throw std::runtime_error("no components available for selection");
-    }
         return fallbackIndex;
     }
 
@@ -411,44 +650,53 @@ ComponentIndex CNP_Graph::selectRemovedComponent() const
 
 ComponentIndex CNP_Graph::selectRemovedLargerComponent() const
 {
-    size_t totalSize = numNodes_ - removedNodes.size();
-    size_t numComponents = connectedComponents_.size();
-    size_t avgComponentSize = std::max(
-        static_cast<size_t>(2),
-        static_cast<size_t>(std::round(static_cast<float>(totalSize)
-                                    / static_cast<float>(numComponents))));
-
-    std::vector<ComponentIndex> largeComponents;
-    std::vector<size_t> componentSizes;
-    largeComponents.reserve(numComponents);
-    componentSizes.reserve(numComponents);
-
-    size_t totalNodesInBigComponents = 0;
-    size_t maxSize = 0;
-    size_t maxIndex = 0;
-    size_t secondMaxSize = 0;
-    size_t secondMaxIndex = 0;
+    size_t numComponents = liveComponents_.size();
+    if (numComponents == 0)
+    {
+        throw std::runtime_error("no components available for selection");
+    }
 
-    for (size_t i = 0; i < numComponents; ++i)
+    ObjValue totalWeight = 0;
+    for (ComponentIndex i : liveComponents_)
     {
-        const size_t currentSize = connectedComponents_[i].size;
+        totalWeight += connectedComponents_[i].weight;
+    }
+    const ObjValue avgComponentWeight = std::max(
+        ObjValue{2},
+        static_cast<ObjValue>(std::round(static_cast<double>(totalWeight)
+                                         / static_cast<double>(numComponents))));
+
+    auto &largeComponents = workspace_.componentCandidates;
+    auto &componentWeights = workspace_.componentWeights;
+    largeComponents.clear();
+    componentWeights.clear();
+
+    ObjValue totalWeightInBigComponents = 0;
+    ObjValue maxWeight = 0;
+    ComponentIndex maxIndex = liveComponents_.front();
+    ObjValue secondMaxWeight = 0;
+    ComponentIndex secondMaxIndex = liveComponents_.front();
+
+    for (ComponentIndex i : liveComponents_)
+    {
+        const ObjValue currentWeight = connectedComponents_[i].weight;
 
-        if (currentSize > avgComponentSize)
+        if (currentWeight > avgComponentWeight)
         {
             largeComponents.push_back(i);
-            componentSizes.push_back(currentSize);
-            totalNodesInBigComponents += currentSize;
+            componentWeights.push_back(currentWeight);
+            totalWeightInBigComponents += currentWeight;
 
-            if (currentSize > maxSize)
+            if (currentWeight > maxWeight)
             {
-                secondMaxSize = maxSize;
+                secondMaxWeight = maxWeight;
                 secondMaxIndex = maxIndex;
-                maxSize = currentSize;
+                maxWeight = currentWeight;
                 maxIndex = i;
             }
-            else if (currentSize > secondMaxSize)
+            else if (currentWeight > secondMaxWeight)
             {
-                secondMaxSize = currentSize;
+                secondMaxWeight = currentWeight;
                 secondMaxIndex = i;
             }
         }
@@ -456,23 +704,23 @@ ComponentIndex CNP_Graph::selectRemovedLargerComponent() const
 
     if (largeComponents.empty())
     {
-        // Fallback to component with maximum size when heuristic set is empty.
-        size_t fallbackIdx = 0;
-        size_t fallbackSize = 0;
-        for (size_t i = 0; i < connectedComponents_.size(); ++i)
+        // Fallback to the heaviest component when heuristic set is empty.
+        ComponentIndex fallbackIdx = 0;
+        ObjValue fallbackWeight = 0;
+        for (ComponentIndex i : liveComponents_)
         {
-            const size_t currentSize = connectedComponents_[i].size;
-            if (currentSize > fallbackSize)
+            const ObjValue currentWeight = connectedComponents_[i].weight;
+            if (currentWeight > fallbackWeight)
             {
-                fallbackSize = currentSize;
+                fallbackWeight = currentWeight;
                 fallbackIdx = i;
             }
         }
-        if (fallbackSize == 0)
+        if (fallbackWeight == 0)
         {
             throw std::runtime_error("no components available for selection");
         }
-        return static_cast<ComponentIndex>(fallbackIdx);
+        return fallbackIdx;
     }
 
     if (largeComponents.size() == 1)
@@ -480,12 +728,18 @@ ComponentIndex CNP_Graph::selectRemovedLargerComponent() const
         return rng_.generateBool(0.5) ? secondMaxIndex : largeComponents[0];
     }
 
-    const int index = rng_.generateIndex(totalNodesInBigComponents);
-    int sum = 0;
+    // Roulette wheel over the component weights. Totals past the int range
+    // of generateIndex draw a fraction of the total instead.
+    const ObjValue index
+        = totalWeightInBigComponents <= std::numeric_limits<int>::max()
+              ? rng_.generateIndex(static_cast<int>(totalWeightInBigComponents))
+              : static_cast<ObjValue>(rng_.generateProbability()
+                                      * totalWeightInBigComponents);
+    ObjValue sum = 0;
 
     for (size_t i = 0; i < largeComponents.size(); ++i)
     {
-        sum += componentSizes[i];
+        sum += componentWeights[i];
         if (index < sum)
         {
             return largeComponents[i];
@@ -514,8 +768,8 @@ Node CNP_Graph::ageSelectNodeFromComponent(ComponentIndex componentIndex) const
         throw std::runtime_error("component is empty, can not select node");
     }
 
-    std::vector<Node> candidateNodes;
-    candidateNodes.reserve(component.size);
+    auto &candidateNodes = workspace_.nodeCandidates;
+    candidateNodes.clear();
 
     const Node firstNode = component.nodes[0];
     int minAge = nodeAge_[firstNode];
@@ -550,115 +804,358 @@ Node CNP_Graph::impactSelectNodeFromComponent(
         throw std::runtime_error("component is empty, can not select node");
     }
 
-    std::vector<int> nodeToIdx(numNodes_, -1);
-    for (size_t i = 0; i < component.size; ++i)
+    const std::vector<Node> *candidateNodes = &workspace_.impactCandidates;
+    if (impactCacheEnabled_)
     {
-        nodeToIdx[component.nodes[i]] = i;
+        candidateNodes = &blockCut(componentIndex).candidates;
+    }
+    else
+    {
+        tarjanInComponent(componentIndex, workspace_.impactOrder);
     }
 
-    const int size = component.size;
-    dfn_.assign(size + 1, 0);
-    lowVec_.assign(size + 1, 0);
-    stSizeVec_.assign(size + 1, 1);
-    cutSizeVec_.assign(size + 1, 1);
-    impactVec_.assign(size + 1, 0);
-    flagVec_.assign(size + 1, 0);
-    isCutVec_.assign(size + 1, false);
+    return candidateNodes->size() == 1
+               ? (*candidateNodes)[0]
+               : (*candidateNodes)[rng_.generateIndex(candidateNodes->size())];
+}
 
-    std::vector<Node> candidateNodes;
-    candidateNodes.reserve(size);
+const CNP_Graph::ImpactCache::Entry *
+CNP_Graph::currentBlockCut(ComponentIndex componentIndex) const
+{
+    const auto &entries = impactCache_.entries;
+    if (!impactCacheEnabled_
+        || static_cast<size_t>(componentIndex) >= entries.size())
+    {
+        return nullptr;
+    }
 
-    timeStamp_ = 0;
-    nodeRoot_ = 1;
+    const ImpactCache::Entry &entry = entries[componentIndex];
+    const auto &slotStamps = gainCache_.slotStamps;
+    const bool touched = static_cast<size_t>(componentIndex) < slotStamps.size()
+                         && slotStamps[componentIndex] > entry.stamp;
+    return entry.valid && !touched ? &entry : nullptr;
+}
 
-    tarjanInComponent(componentIndex, nodeRoot_, nodeToIdx);
+const CNP_Graph::ImpactCache::Entry &
+CNP_Graph::blockCut(ComponentIndex componentIndex) const
+{
+    auto &entries = impactCache_.entries;
+    if (entries.size() < connectedComponents_.size())
+    {
+        entries.resize(connectedComponents_.size());
+    }
+    auto &slotStamps = gainCache_.slotStamps;
+    if (slotStamps.size() < connectedComponents_.size())
+    {
+        slotStamps.resize(connectedComponents_.size(), 0);
+    }
 
-    int minImpact = std::numeric_limits<int>::max();
-    candidateNodes.clear();
+    ImpactCache::Entry &entry = entries[componentIndex];
+    if (!entry.valid || slotStamps[componentIndex] > entry.stamp)
+    {
+        tarjanInComponent(componentIndex, entry.order);
+        entry.candidates = workspace_.impactCandidates;
+        entry.stamp = gainCache_.move;
+        entry.valid = true;
+    }
+    return entry;
+}
+
+void CNP_Graph::collectSeparatedChildren(ComponentIndex componentIndex,
+                                         Node node,
+                                         std::vector<Node> &children) const
+{
+    const auto &tarjan = impactCache_.nodes;
 
-    for (int i = 1; i <= size; ++i)
+    // Parallel edges list a child twice.
+    children.clear();
+    for (Node neighbor : topology_->neighbors(node))
     {
-        int currentImpact = impactVec_[i];
+        if (!isNodeActive(neighbor)
+            || nodeToComponentIndex_[neighbor] != componentIndex
+            || tarjan[neighbor].parent != node
+            || tarjan[neighbor].low < tarjan[node].dfn
+            || std::find(children.begin(), children.end(), neighbor)
+                   != children.end())
+        {
+            continue;
+        }
+        children.push_back(neighbor);
+    }
+}
 
-        if (isCutVec_[i])
+std::vector<size_t> CNP_Graph::removalSplitSizes(Node node) const
+{
+    if (!isNodeActive(node))
+    {
+        throw std::invalid_argument("node is not active");
+    }
+
+    const ComponentIndex componentIndex = nodeToComponentIndex_[node];
+    const Component &component = connectedComponents_[componentIndex];
+    const size_t rest = component.weight - nodeWeight(node);
+    if (component.size == 1)
+    {
+        return {};
+    }
+
+    if (impactCacheEnabled_)
+    {
+        blockCut(componentIndex);
+    }
+    else
+    {
+        tarjanInComponent(componentIndex, workspace_.impactOrder);
+    }
+
+    const TarjanEntry &info = impactCache_.nodes[node];
+    if (!info.isCut)
+    {
+        return {rest};
+    }
+
+    auto &children = workspace_.impactChildren;
+    collectSeparatedChildren(componentIndex, node, children);
+
+    std::vector<size_t> sizes;
+    sizes.reserve(children.size() + 1);
+    size_t splitOff = 0;
+    for (Node child : children)
+    {
+        sizes.push_back(impactCache_.nodes[child].subtreeSize);
+        splitOff += sizes.back();
+    }
+    if (splitOff < rest)
+    {
+        sizes.push_back(rest - splitOff);
+    }
+    return sizes;
+}
+
+void CNP_Graph::splitAlongBlockCut(ComponentIndex componentIndex,
+                                   Node removedNode,
+                                   const ImpactCache::Entry &entry)
+{
+    const auto &tarjan = impactCache_.nodes;
+    const TarjanEntry &info = tarjan[removedNode];
+    if (!info.isCut)
+    {
+        addComponentCost(componentIndex);
+        return;
+    }
+
+    auto &children = workspace_.impactChildren;
+    collectSeparatedChildren(componentIndex, removedNode, children);
+
+    // The piece holding the DFS root, if any, is everything not split off;
+    // the largest piece stays in the slot, the others move out.
+    size_t restNodes = connectedComponents_[componentIndex].size;
+    Node largest = INVALID_NODE;
+    for (Node child : children)
+    {
+        restNodes -= tarjan[child].subtreeNodes;
+        if (largest == INVALID_NODE
+            || tarjan[child].subtreeNodes > tarjan[largest].subtreeNodes)
         {
-            currentImpact += ((timeStamp_ - cutSizeVec_[i])
-                              * (timeStamp_ - cutSizeVec_[i] - 1))
-                             / 2;
+            largest = child;
         }
-        else
+    }
+
+    auto &slots = workspace_.searchSlot;
+    slots.clear();
+    auto moveRange = [&](int begin, int end)
+    {
+        PYCNP_TRACE_COUNT(ComponentSplits);
+        slots.push_back(allocateComponent());
+        for (int pos = begin; pos < end; ++pos)
         {
-            currentImpact += ((timeStamp_ - 1) * (timeStamp_ - 2)) / 2;
+            const Node node = entry.order[pos];
+            eraseFromComponent(componentIndex, node);
+            appendToComponent(slots.back(), node);
         }
+    };
 
-        if (currentImpact < minImpact)
+    const bool keepRest = restNodes >= static_cast<size_t>(tarjan[largest].subtreeNodes);
+    for (Node child : children)
+    {
+        if (keepRest || child != largest)
         {
-            minImpact = currentImpact;
-            candidateNodes.clear();
-            candidateNodes.push_back(component.nodes[i - 1]);
+            const int begin = tarjan[child].dfn - 1;
+            moveRange(begin, begin + tarjan[child].subtreeNodes);
         }
-        else if (currentImpact == minImpact)
+    }
+
+    if (!keepRest && restNodes > 0)
+    {
+        // Move the rest instead: the preorder outside the kept subtree,
+        // minus the other subtrees, which have already left.
+        PYCNP_TRACE_COUNT(ComponentSplits);
+        slots.push_back(allocateComponent());
+        const int keptBegin = tarjan[largest].dfn - 1;
+        const int keptEnd = keptBegin + tarjan[largest].subtreeNodes;
+        for (int pos = 0; pos < static_cast<int>(entry.order.size()); ++pos)
         {
-            candidateNodes.push_back(component.nodes[i - 1]);
+            if (pos == keptBegin)
+            {
+                pos = keptEnd - 1;
+                continue;
+            }
+            const Node node = entry.order[pos];
+            if (nodeToComponentIndex_[node] == componentIndex)
+            {
+                eraseFromComponent(componentIndex, node);
+                appendToComponent(slots.back(), node);
+            }
         }
     }
 
-    return candidateNodes.size() == 1
-               ? candidateNodes[0]
-               : candidateNodes[rng_.generateIndex(candidateNodes.size())];
+    addComponentCost(componentIndex);
+    for (ComponentIndex slot : slots)
+    {
+        addComponentCost(slot);
+    }
 }
 
-void CNP_Graph::tarjanInComponent(ComponentIndex compIndex,
-                                int nodeIdx,
-                                const std::vector<int> &nodeToIdx) const
+template <class Policy>
+void CNP_Graph::tarjanInComponentOf(ComponentIndex compIndex,
+                                    std::vector<Node> &order) const
 {
-    dfn_[nodeIdx] = lowVec_[nodeIdx] = ++timeStamp_;
+    const auto &component = connectedComponents_[compIndex];
+    auto &tarjan = impactCache_.nodes;
+    if (tarjan.size() < static_cast<size_t>(numNodes_))
+    {
+        tarjan.resize(numNodes_);
+    }
 
-    Node nodeId = connectedComponents_[compIndex].nodes[nodeIdx - 1];
+    const int epoch = nextVisitEpoch();
+    auto &visitEpoch = workspace_.dfsVisitEpoch;
+    int timeStamp = 0;
+    order.clear();
 
-    for (Node neighbor : currentAdjList_[nodeId])
+    auto discover = [&](Node node, Node parent)
     {
-        if (!isNodeRemoved(neighbor)
-            && nodeToComponentIndex_[neighbor] == compIndex)
+        visitEpoch[node] = epoch;
+        tarjan[node] = TarjanEntry();
+        tarjan[node].dfn = tarjan[node].low = ++timeStamp;
+        tarjan[node].subtreeSize = tarjan[node].cutSize = nodeWeight(node);
+        tarjan[node].subtreeSquared = tarjan[node].cutSquared
+            = int64_t{nodeWeight(node)} * nodeWeight(node);
+        tarjan[node].parent = parent;
+        order.push_back(node);
+        workspace_.tarjanStack.push_back({node, 0});
+    };
+
+    const Node root = component.nodes[0];
+    auto &stack = workspace_.tarjanStack;
+    stack.clear();
+    discover(root, INVALID_NODE);
+
+    while (!stack.empty())
+    {
+        const Node node = stack.back().node;
+        const auto neighbors = topology_->neighbors(node);
+
+        if (stack.back().nextEdge < neighbors.size())
         {
-            int neighborIdx = nodeToIdx[neighbor] + 1;
+            const Node neighbor = neighbors[stack.back().nextEdge++];
+            if (!isNodeActive(neighbor)
+                || nodeToComponentIndex_[neighbor] != compIndex)
+            {
+                continue;
+            }
 
-            if (dfn_[neighborIdx] == 0)
+            if (visitEpoch[neighbor] != epoch)
+            {
+                discover(neighbor, node);
+            }
+            else
             {
-                tarjanInComponent(compIndex, neighborIdx, nodeToIdx);
+                tarjan[node].low = std::min(tarjan[node].low, tarjan[neighbor].dfn);
+            }
+            continue;
+        }
 
-                lowVec_[nodeIdx]
-                    = std::min(lowVec_[nodeIdx], lowVec_[neighborIdx]);
+        // All edges of ``node`` are done: fold it into its DFS parent.
+        stack.pop_back();
+        if (stack.empty())
+        {
+            break;
+        }
 
-                if (dfn_[nodeIdx] < dfn_[neighborIdx])
-                {
-                    stSizeVec_[nodeIdx] += stSizeVec_[neighborIdx];
-                }
+        const TarjanEntry &child = tarjan[node];
+        const Node parentNode = stack.back().node;
+        TarjanEntry &parent = tarjan[parentNode];
 
-                if (lowVec_[neighborIdx] >= dfn_[nodeIdx])
-                {
-                    flagVec_[nodeIdx]++;
+        parent.low = std::min(parent.low, child.low);
+        parent.subtreeSize += child.subtreeSize;
+        parent.subtreeNodes += child.subtreeNodes;
+        parent.subtreeSquared += child.subtreeSquared;
 
-                    if (nodeIdx != nodeRoot_)
-                    {
-                        isCutVec_[nodeIdx] = true;
-                        cutSizeVec_[nodeIdx] += stSizeVec_[neighborIdx];
-                        impactVec_[nodeIdx] += (stSizeVec_[neighborIdx]
-                                               * (stSizeVec_[neighborIdx] - 1))
-                                              / 2;
-                    }
-                    else if (nodeIdx == nodeRoot_ && flagVec_[nodeIdx] > 1)
-                    {
-                        isCutVec_[nodeIdx] = true;
-                    }
-                }
+        if (child.low >= parent.dfn)
+        {
+            parent.separated++;
+
+            if (parentNode != root)
+            {
+                parent.isCut = true;
+                parent.cutSize += child.subtreeSize;
+                parent.cutSquared += child.subtreeSquared;
+                parent.impact = combineCosts<Policy>(
+                    parent.impact,
+                    Policy::cost(child.subtreeSize, child.subtreeSquared));
             }
-            else
+            else if (parent.separated > 1)
             {
-                lowVec_[nodeIdx] = std::min(lowVec_[nodeIdx], dfn_[neighborIdx]);
+                parent.isCut = true;
             }
         }
     }
+
+    const int64_t total = component.weight;
+    const int64_t totalSquared = component.squaredWeight;
+    int64_t minImpact = std::numeric_limits<int64_t>::max();
+    auto &candidateNodes = workspace_.impactCandidates;
+    candidateNodes.clear();
+
+    for (size_t i = 0; i < component.size; ++i)
+    {
+        const Node node = component.nodes[i];
+        const TarjanEntry &entry = tarjan[node];
+        int64_t currentImpact = entry.impact;
+
+        if (entry.isCut)
+        {
+            currentImpact = combineCosts<Policy>(
+                currentImpact,
+                Policy::cost(total - entry.cutSize, totalSquared - entry.cutSquared));
+        }
+        else
+        {
+            const int64_t weight = nodeWeight(node);
+            currentImpact = combineCosts<Policy>(
+                currentImpact,
+                Policy::cost(total - weight, totalSquared - weight * weight));
+        }
+
+        if (currentImpact < minImpact)
+        {
+            minImpact = currentImpact;
+            candidateNodes.clear();
+            candidateNodes.push_back(node);
+        }
+        else if (currentImpact == minImpact)
+        {
+            candidateNodes.push_back(node);
+        }
+    }
+}
+
+void CNP_Graph::tarjanInComponent(ComponentIndex compIndex,
+                                  std::vector<Node> &order) const
+{
+    visitObjective(objective_, [&](auto policy) {
+        tarjanInComponentOf<decltype(policy)>(compIndex, order);
+    });
 }
 
 Node CNP_Graph::greedySelectNodeToAdd() const
@@ -668,27 +1165,32 @@ Node CNP_Graph::greedySelectNodeToAdd() const
         throw std::runtime_error("no removed nodes can be added");
     }
 
-    std::vector<Node> candidateNodes;
-    candidateNodes.reserve(removedNodes.size());
+    auto &candidateNodes = workspace_.nodeCandidates;
+    candidateNodes.clear();
 
     auto it = removedNodes.begin();
     const Node firstNode = *it;
-    int minDelta = calculateConnectionGain(firstNode);
+    auto connectionGain = [this](Node node) {
+        return gainCacheEnabled_ ? cachedConnectionGain(node)
+                                 : calculateConnectionGain(node);
+    };
+
+    ObjValue minDelta = connectionGain(firstNode);
     candidateNodes.push_back(firstNode);
 
     ++it;
     for (; it != removedNodes.end(); ++it)
     {
         Node currentNode = *it;
-        int connectionGain = calculateConnectionGain(currentNode);
+        ObjValue gain = connectionGain(currentNode);
 
-        if (connectionGain < minDelta)
+        if (gain < minDelta)
         {
-            minDelta = connectionGain;
+            minDelta = gain;
             candidateNodes.clear();
             candidateNodes.push_back(currentNode);
         }
-        else if (connectionGain == minDelta)
+        else if (gain == minDelta)
         {
             candidateNodes.push_back(currentNode);
         }
@@ -701,7 +1203,13 @@ Node CNP_Graph::greedySelectNodeToAdd() const
 
 Node CNP_Graph::randomSelectNodeToRemove() const
 {
-    ComponentIndex compIndex = rng_.generateIndex(connectedComponents_.size());
+    if (liveComponents_.empty())
+    {
+        throw std::runtime_error("no components available for selection");
+    }
+
+    ComponentIndex compIndex
+        = liveComponents_[rng_.generateIndex(liveComponents_.size())];
     const Component &selectedComponent = connectedComponents_[compIndex];
 
     if (selectedComponent.size == 0 || selectedComponent.nodes.empty())
@@ -712,47 +1220,132 @@ Node CNP_Graph::randomSelectNodeToRemove() const
     return selectedComponent.nodes[rng_.generateIndex(selectedComponent.size)];
 }
 
-int CNP_Graph::calculateConnectionGain(Node node) const
+void CNP_Graph::collectNeighborComponents(
+    Node node, std::vector<ComponentIndex> &components) const
 {
-    std::vector<size_t> componentSizes(connectedComponents_.size(), 0);
+    auto &componentEpoch = workspace_.componentEpoch;
+    if (componentEpoch.size() < connectedComponents_.size())
+    {
+        componentEpoch.resize(connectedComponents_.size(), 0);
+    }
+    const int epoch = nextVisitEpoch();
 
-    int totalSize = 1;
+    components.clear();
+    for (Node neighbor : topology_->neighbors(node))
+    {
+        const ComponentIndex componentIndex = nodeToComponentIndex_[neighbor];
+        if (componentIndex != -1 && componentEpoch[componentIndex] != epoch)
+        {
+            componentEpoch[componentIndex] = epoch;
+            components.push_back(componentIndex);
+        }
+    }
+}
 
-    const auto &neighbors = originalAdjList_[node];
-    for (Node neighbor : neighbors)
+template <class Policy>
+ObjValue CNP_Graph::mergeGainOf(Node node,
+                                const std::vector<ComponentIndex> &components) const
+{
+    int64_t totalWeight = nodeWeight(node);
+    int64_t totalSquared = totalWeight * totalWeight;
+    ObjValue oldCostSum = 0;
+    for (ComponentIndex componentIndex : components)
     {
-        if (nodeToComponentIndex_[neighbor] != -1)
+        const Component &component = connectedComponents_[componentIndex];
+        totalWeight += component.weight;
+        totalSquared += component.squaredWeight;
+        if constexpr (Policy::additive)
         {
-            ComponentIndex compIndex = nodeToComponentIndex_[neighbor];
+            oldCostSum += Policy::cost(component.weight, component.squaredWeight);
+        }
+    }
+
+    return Policy::cost(totalWeight, totalSquared) - oldCostSum;
+}
+
+ObjValue CNP_Graph::mergeGain(Node node,
+                              const std::vector<ComponentIndex> &components) const
+{
+    return visitObjective(objective_, [&](auto policy) {
+        return mergeGainOf<decltype(policy)>(node, components);
+    });
+}
 
-            if (componentSizes[compIndex] == 0)
+ObjValue CNP_Graph::calculateConnectionGain(Node node) const
+{
+    collectNeighborComponents(node, workspace_.mergeComponents);
+    return mergeGain(node, workspace_.mergeComponents);
+}
+
+ObjValue CNP_Graph::cachedConnectionGain(Node node) const
+{
+    auto &cache = gainCache_;
+    if (cache.entries.size() < static_cast<size_t>(numNodes_))
+    {
+        cache.entries.assign(numNodes_, GainCache::Entry());
+    }
+    if (cache.slotStamps.size() < connectedComponents_.size())
+    {
+        cache.slotStamps.resize(connectedComponents_.size(), 0);
+    }
+
+    GainCache::Entry &entry = cache.entries[node];
+    if (entry.valid)
+    {
+        bool fresh = true;
+        for (ComponentIndex componentIndex : entry.components)
+        {
+            if (cache.slotStamps[componentIndex] > entry.stamp)
             {
-                componentSizes[compIndex] = connectedComponents_[compIndex].size;
-                totalSize += componentSizes[compIndex];
+                fresh = false;
+                break;
             }
         }
-    }
 
-    int oldConnectionsSum = 0;
-    for (int size : componentSizes)
-    {
-        if (size > 0)
+        if (fresh)
         {
-            oldConnectionsSum += (size * (size - 1)) / 2;
+            return entry.gain;
         }
     }
 
-    int newConnections = (totalSize * (totalSize - 1)) / 2;
+    collectNeighborComponents(node, entry.components);
+    entry.gain = mergeGain(node, entry.components);
+    entry.stamp = cache.move;
+    entry.valid = true;
+    return entry.gain;
+}
 
-    return newConnections - oldConnectionsSum;
+void CNP_Graph::setGainCacheEnabled(bool enabled)
+{
+    gainCacheEnabled_ = enabled;
+    if (!enabled)
+    {
+        // The slot stamps stay, as the impact cache relies on them too.
+        gainCache_.entries.clear();
+    }
+}
+
+void CNP_Graph::setImpactCacheEnabled(bool enabled)
+{
+    impactCacheEnabled_ = enabled;
+    if (!enabled)
+    {
+        impactCache_.entries.clear();
+    }
 }
 
 std::unique_ptr<CNP_Graph> CNP_Graph::getRandomFeasibleGraph() const
 {
-    auto tempGraph = std::make_unique<CNP_Graph>(*this);
-    Solution randomSolution;
-    std::vector<Node> availableNodes(originalNodesSet_.begin(),
-                                     originalNodesSet_.end());
+    Solution randomSolution(numNodes_);
+    std::vector<Node> availableNodes;
+    availableNodes.reserve(numNodes_);
+    for (Node node = 0; node < numNodes_; ++node)
+    {
+        if (!(nodeFlags_[node] & NODE_EXCLUDED))
+        {
+            availableNodes.push_back(node);
+        }
+    }
 
     for (int i = 0; i < numToRemove_ && !availableNodes.empty(); ++i)
     {
@@ -765,8 +1358,7 @@ std::unique_ptr<CNP_Graph> CNP_Graph::getRandomFeasibleGraph() const
         availableNodes.pop_back();
     }
 
-    tempGraph->updateGraphByRemovedNodes(randomSolution);
-    return tempGraph;
+    return cloneWithRemovedNodes(randomSolution);
 }
 
 std::unique_ptr<CNP_Graph> CNP_Graph::clone() const
@@ -774,9 +1366,248 @@ std::unique_ptr<CNP_Graph> CNP_Graph::clone() const
     return std::make_unique<CNP_Graph>(*this);
 }
 
+std::unique_ptr<CNP_Graph>
+CNP_Graph::cloneWithRemovedNodes(const Solution &nodesToRemove) const
+{
+    return std::unique_ptr<CNP_Graph>(new CNP_Graph(*this, nodesToRemove));
+}
+
+void CNP_Graph::assignWithRemovedNodes(const CNP_Graph &source,
+                                       const Solution &nodesToRemove)
+{
+    // Copy assignment of the vectors reuses their storage.
+    numNodes_ = source.numNodes_;
+    nodeAge_ = source.nodeAge_;
+    topology_ = source.topology_;
+    nodeFlags_ = source.nodeFlags_;
+    nodeWeights_ = source.nodeWeights_;
+    objective_ = source.objective_;
+    numToRemove_ = source.numToRemove_;
+    nodeToComponentIndex_.resize(numNodes_);
+    rng_ = source.rng_;
+    gainCacheEnabled_ = source.gainCacheEnabled_;
+    impactCacheEnabled_ = source.impactCacheEnabled_;
+
+    removedNodes.clear();
+    removedNodes.reserve(std::max(numToRemove_, 0));
+    updateGraphByRemovedNodes(nodesToRemove);
+}
+
+std::vector<CNP_Graph::Shard> CNP_Graph::partitionByComponents(int maxShards) const
+{
+    std::vector<Shard> shards;
+    if (maxShards < 2)
+    {
+        return shards;
+    }
+
+    // Removed nodes joined by removed edges form clusters, stored flat: the
+    // nodes of cluster k and the components it touches are the ranges
+    // [clusterBegin[k], clusterBegin[k + 1]) and likewise for touchedBegin.
+    std::vector<Node> clusterNodes;
+    std::vector<size_t> clusterBegin(1, 0);
+    std::vector<ComponentIndex> touched;
+    std::vector<size_t> touchedBegin(1, 0);
+    std::vector<char> seen(numNodes_, 0);
+    std::vector<size_t> touchedBy(connectedComponents_.size(), SIZE_MAX);
+    std::vector<Node> stack;
+    for (Node start : removedNodes)
+    {
+        if (seen[start])
+        {
+            continue;
+        }
+
+        const size_t cluster = clusterBegin.size() - 1;
+        stack.assign(1, start);
+        seen[start] = 1;
+        while (!stack.empty())
+        {
+            const Node node = stack.back();
+            stack.pop_back();
+            clusterNodes.push_back(node);
+
+            for (Node neighbor : topology_->neighbors(node))
+            {
+                if (nodeFlags_[neighbor] == NODE_REMOVED)
+                {
+                    if (!seen[neighbor])
+                    {
+                        seen[neighbor] = 1;
+                        stack.push_back(neighbor);
+                    }
+                }
+                else if (isNodeActive(neighbor))
+                {
+                    const ComponentIndex component = nodeToComponentIndex_[neighbor];
+                    if (touchedBy[component] != cluster)
+                    {
+                        touchedBy[component] = cluster;
+                        touched.push_back(component);
+                    }
+                }
+            }
+        }
+        clusterBegin.push_back(clusterNodes.size());
+        touchedBegin.push_back(touched.size());
+    }
+    const size_t numClusters = clusterBegin.size() - 1;
+
+    // Components a cluster touches are grouped together while the group
+    // stays within an even share of the weight, so that only the clusters
+    // between groups are frozen. A union-find over the slots tracks groups.
+    size_t totalWeight = 0;
+    for (ComponentIndex index : liveComponents_)
+    {
+        totalWeight += connectedComponents_[index].weight;
+    }
+    const size_t capacity = (totalWeight + maxShards - 1) / maxShards;
+
+    std::vector<ComponentIndex> parent(connectedComponents_.size());
+    std::iota(parent.begin(), parent.end(), 0);
+    std::vector<size_t> groupWeight(connectedComponents_.size(), 0);
+    for (ComponentIndex index : liveComponents_)
+    {
+        groupWeight[index] = connectedComponents_[index].weight;
+    }
+    auto findGroup = [&parent](ComponentIndex index) {
+        while (parent[index] != index)
+        {
+            parent[index] = parent[parent[index]];
+            index = parent[index];
+        }
+        return index;
+    };
+
+    std::vector<ComponentIndex> roots;
+    for (size_t cluster = 0; cluster < numClusters; ++cluster)
+    {
+        roots.clear();
+        for (size_t i = touchedBegin[cluster]; i < touchedBegin[cluster + 1]; ++i)
+        {
+            roots.push_back(findGroup(touched[i]));
+        }
+        std::sort(roots.begin(), roots.end());
+        roots.erase(std::unique(roots.begin(), roots.end()), roots.end());
+
+        size_t weight = 0;
+        for (ComponentIndex root : roots)
+        {
+            weight += groupWeight[root];
+        }
+        if (roots.size() > 1 && weight <= capacity)
+        {
+            for (ComponentIndex root : roots)
+            {
+                parent[root] = roots[0];
+            }
+            groupWeight[roots[0]] = weight;
+        }
+    }
+
+    // Only a group of two nodes has something left to cut.
+    std::vector<ComponentIndex> groups;
+    size_t numCuttable = 0;
+    for (ComponentIndex index : liveComponents_)
+    {
+        if (findGroup(index) == index)
+        {
+            groups.push_back(index);
+            numCuttable += groupWeight[index] >= 2;
+        }
+    }
+    const size_t numShards = std::min<size_t>(numCuttable, maxShards);
+    if (numShards < 2)
+    {
+        return shards;
+    }
+
+    // Heaviest group first into the lightest shard.
+    std::sort(groups.begin(),
+              groups.end(),
+              [&groupWeight](ComponentIndex lhs, ComponentIndex rhs) {
+                  return groupWeight[lhs] != groupWeight[rhs]
+                             ? groupWeight[lhs] > groupWeight[rhs]
+                             : lhs < rhs;
+              });
+
+    std::vector<size_t> shardOf(connectedComponents_.size(), 0);
+    std::vector<size_t> shardWeights(numShards, 0);
+    for (ComponentIndex root : groups)
+    {
+        const size_t shard
+            = std::min_element(shardWeights.begin(), shardWeights.end())
+              - shardWeights.begin();
+        shardOf[root] = shard;
+        shardWeights[shard] += groupWeight[root];
+    }
+
+    shards.resize(numShards);
+    for (Shard &shard : shards)
+    {
+        shard.removed = Solution(numNodes_);
+    }
+    for (ComponentIndex index : liveComponents_)
+    {
+        const Component &component = connectedComponents_[index];
+        Shard &shard = shards[shardOf[findGroup(index)]];
+        shard.nodes.insert(shard.nodes.end(),
+                           component.nodes.begin(),
+                           component.nodes.end());
+    }
+
+    // A cluster next to one shard belongs to it, one next to no live node
+    // to the first shard; the others stay removed.
+    for (size_t cluster = 0; cluster < numClusters; ++cluster)
+    {
+        size_t owner = 0;
+        bool frozen = false;
+        for (size_t i = touchedBegin[cluster]; i < touchedBegin[cluster + 1]; ++i)
+        {
+            const size_t shard = shardOf[findGroup(touched[i])];
+            frozen = frozen || (i > touchedBegin[cluster] && shard != owner);
+            owner = shard;
+        }
+
+        if (!frozen)
+        {
+            Shard &shard = shards[owner];
+            const auto first = clusterNodes.begin() + clusterBegin[cluster];
+            const auto last = clusterNodes.begin() + clusterBegin[cluster + 1];
+            shard.nodes.insert(shard.nodes.end(), first, last);
+            shard.removed.insert(first, last);
+        }
+    }
+
+    return shards;
+}
+
+std::unique_ptr<CNP_Graph> CNP_Graph::shardGraph(const Shard &shard, int seed) const
+{
+    auto graph = std::make_unique<CNP_Graph>();
+    graph->numNodes_ = numNodes_;
+    graph->nodeAge_ = nodeAge_;
+    graph->topology_ = topology_;
+    graph->nodeFlags_.assign(numNodes_, NODE_EXCLUDED);
+    for (Node node : shard.nodes)
+    {
+        graph->nodeFlags_[node] = NODE_ACTIVE;
+    }
+    graph->nodeWeights_ = nodeWeights_;
+    graph->objective_ = objective_;
+    graph->numToRemove_ = static_cast<int>(shard.removed.size());
+    graph->nodeToComponentIndex_.assign(numNodes_, -1);
+    graph->rng_.setSeed(seed);
+    graph->gainCacheEnabled_ = gainCacheEnabled_;
+    graph->impactCacheEnabled_ = impactCacheEnabled_;
+    graph->removedNodes = Solution(numNodes_);
+    graph->updateGraphByRemovedNodes(shard.removed);
+    return graph;
+}
+
 bool CNP_Graph::isNodeRemoved(Node node) const
 {
-    return removedNodes.find(node) != removedNodes.end();
+    return nodeFlags_[node] & NODE_REMOVED;
 }
 
 int CNP_Graph::getNumNodes() const
@@ -784,7 +1615,7 @@ int CNP_Graph::getNumNodes() const
     return numNodes_;
 }
 
-const NodeSet& CNP_Graph::getRemovedNodes() const
+const Solution &CNP_Graph::getRemovedNodes() const
 {
     return removedNodes;
 }
@@ -794,7 +1625,22 @@ void CNP_Graph::setNodeAge(Node node, Age age)
     nodeAge_[node] = age;
 }
 
-int CNP_Graph::getObjectiveValue() const
+ObjValue CNP_Graph::getObjectiveValue() const
 {
-    return connectedPairs_;
+    switch (objective_)
+    {
+    case ObjectiveKind::LargestComponent:
+    {
+        ObjValue largest = 0;
+        for (ComponentIndex componentIndex : liveComponents_)
+        {
+            largest = std::max(largest, componentCost(componentIndex));
+        }
+        return largest;
+    }
+    case ObjectiveKind::ComponentCount:
+        return numNodes_ + componentCostSum_;
+    default:
+        return componentCostSum_;
+    }
 }
\ No newline at end of file
@@ -2,8 +2,12 @@
 #define CNP_GRAPH_H
 
 #include "../RandomNumberGenerator.h"
+#include "CSRGraph.h"
+#include "ObjectivePolicy.h"
+#include "Solution.h"
 #include "Types.h"
 #include <cctype>
+#include <cstdint>
 #include <fstream>
 #include <iostream>
 #include <memory>
@@ -23,49 +27,272 @@
 class CNP_Graph
 {
 private:
-    int numNodes_;              ///< Number of vertices
-    NodeSet originalNodesSet_;  ///< Set of all existing nodes
-    NodeSet initialNodesSet_;   ///< Snapshot of the original node set
+    int numNodes_ = 0;          ///< Number of vertices
     std::vector<Age> nodeAge_;  ///< Node "age"
 
-    std::vector<NodeSet> currentAdjList_;   ///< Current adjacency list
-    std::vector<NodeSet> originalAdjList_;  ///< Original adjacency list
-    std::vector<NodeSet> initialAdjList_;   ///< Immutable copy of the original adjacency list
+    std::shared_ptr<const CSRGraph> topology_;  ///< Shared original adjacency
+    std::vector<NodeFlags> nodeFlags_;  ///< Removed / excluded state per node
 
-    int numToRemove_;
-    int initialNumToRemove_ = 0;
+    /**
+     * Node weights, or null when every node weighs one.
+     *
+     * A kernelized graph excludes leaves and folds each into the weight of
+     * its neighbour; components then count the pairs of their total weight,
+     * so the objective still counts the pairs of the unreduced graph. The
+     * weighted objectives read the weights given by ProblemData instead.
+     */
+    std::shared_ptr<const std::vector<int>> nodeWeights_;
+    ObjectiveKind objective_ = ObjectiveKind::Pairwise;
+
+    int numToRemove_ = 0;
     std::vector<ComponentIndex>
         nodeToComponentIndex_;  ///< Stores the component index for each vertex
+    /**
+     * Component slot pool.
+     *
+     * Slots are recycled through ``freeComponentSlots_`` instead of being
+     * erased, so component indices stay stable and a split or merge never
+     * relabels components it does not touch. ``liveComponents_`` lists the
+     * occupied slots; ``componentLivePos_`` is each slot's position in it.
+     */
     std::vector<Component> connectedComponents_;
-    int connectedPairs_;
+    std::vector<ComponentIndex> liveComponents_;
+    std::vector<size_t> componentLivePos_;
+    std::vector<ComponentIndex> freeComponentSlots_;
+    std::vector<size_t> nodePosition_;  ///< Position of each node in its component
+    ObjValue componentCostSum_ = 0;  ///< Sum of component costs, additive objectives
     mutable RandomNumberGenerator rng_;
-    int initialSeed_ = 0;
 
-    // Selects the larger component to remove.
+    // Selects the larger component to remove, weighing components by their
+    // node weights.
     ComponentIndex selectRemovedLargerComponent() const;
 
-    // Tarjan algorithm auxiliary variables
-    mutable std::vector<int> dfn_;         ///< Node discovery time
-    mutable std::vector<int> lowVec_;      ///< Minimum discovery time reachable by node
-    mutable std::vector<int> stSizeVec_;   ///< Subtree size
-    mutable std::vector<int> cutSizeVec_;  ///< Cut size
-    mutable std::vector<int> impactVec_;   ///< Node impact
-    mutable std::vector<int> flagVec_;     ///< Flag vector
-    mutable std::vector<bool> isCutVec_;   ///< Whether node is a cut vertex
-    mutable int timeStamp_;                ///< Timestamp
-    mutable int nodeRoot_;                 ///< Root node
-    mutable std::vector<char> componentVisited_;  ///< Scratch buffer for component marking
-    mutable std::vector<int> dfsVisitEpoch_;      ///< Visit epochs for DFS
-    mutable int dfsCurrentEpoch_ = 0;             ///< Current epoch id
-    mutable std::vector<Node> dfsStack_;          ///< Reusable DFS stack
-
-    // Implementation of Tarjan algorithm in connected component.
+    /**
+     * Scratch buffers for the DFS and Tarjan traversals.
+     *
+     * They carry no graph state between calls, so copying a graph leaves the
+     * copy with an empty workspace that is sized on first use.
+     */
+    /// Articulation point state of one node in the impact search. Entries
+    /// are initialised on discovery, so nothing is cleared between calls.
+    struct TarjanEntry
+    {
+        int dfn = 0;           ///< Node discovery time
+        int low = 0;           ///< Minimum discovery time reachable by node
+        int subtreeSize = 1;   ///< DFS subtree size
+        int subtreeNodes = 1;  ///< DFS subtree node count, unweighted
+        int cutSize = 1;       ///< Nodes split off when removed, plus one
+        int64_t subtreeSquared = 1;  ///< Squared weights of the subtree
+        int64_t cutSquared = 1;      ///< Squared weights split off, plus own
+        int64_t impact = 0;    ///< Cost of the split-off subtrees
+        int separated = 0;     ///< Children separated by this node
+        bool isCut = false;    ///< Whether node is a cut vertex
+        Node parent = INVALID_NODE;  ///< DFS parent, none for the root
+    };
+
+    /// DFS frame of the iterative Tarjan search.
+    struct TarjanFrame
+    {
+        Node node;
+        size_t nextEdge;
+    };
+
+    struct Workspace
+    {
+        std::vector<TarjanFrame> tarjanStack;    ///< Explicit DFS stack
+        std::vector<Node> impactCandidates;      ///< Minimum-impact nodes
+        std::vector<Node> impactOrder;       ///< Preorder, impact cache off
+        std::vector<Node> impactChildren;    ///< Separated children of a node
+        std::vector<char> componentVisited;  ///< Scratch buffer for component marking
+        std::vector<int> dfsVisitEpoch;      ///< Visit epochs for DFS
+        int dfsCurrentEpoch = 0;             ///< Current epoch id
+        std::vector<Node> dfsStack;          ///< Reusable DFS stack
+
+        // Interleaved split search run by removeNode.
+        std::vector<int> searchOwner;                   ///< Search that claimed a node
+        std::vector<std::vector<Node>> searchFrontier;  ///< DFS stack per search
+        std::vector<std::vector<Node>> searchClaimed;   ///< Nodes claimed per search
+        std::vector<size_t> searchParent;   ///< Union-find over merged searches
+        std::vector<size_t> searchActive;   ///< Unfinished searches per group
+        std::vector<ComponentIndex> searchSlot;  ///< Component slot per group
+
+        // Neighbouring components collected by addNode.
+        std::vector<ComponentIndex> mergeComponents;
+        std::vector<int> componentEpoch;
+
+        // Ties and weights collected by the selection heuristics.
+        std::vector<ComponentIndex> componentCandidates;
+        std::vector<ObjValue> componentWeights;
+        std::vector<Node> nodeCandidates;
+
+        Workspace() = default;
+        Workspace(const Workspace &) {}
+        Workspace &operator=(const Workspace &) { return *this; }
+    };
+
+    mutable Workspace workspace_;
+
+    /**
+     * Cached connection gains of removed nodes, used by greedySelectNodeToAdd.
+     *
+     * An entry remembers the distinct components around its node and the
+     * move at which it was computed. Every change to a component slot stamps
+     * the slot with the current move, and a node changing component clears
+     * the entries of its neighbours, so an entry is reused as long as none
+     * of its components changed since. Like the workspace, the cache is not
+     * copied with the graph.
+     */
+    struct GainCache
+    {
+        struct Entry
+        {
+            ObjValue gain = 0;
+            uint64_t stamp = 0;
+            bool valid = false;
+            std::vector<ComponentIndex> components;
+        };
+
+        std::vector<Entry> entries;          ///< Per node, sized on first use
+        std::vector<uint64_t> slotStamps;    ///< Last move touching each slot
+        uint64_t move = 0;                   ///< Current move counter
+
+        GainCache() = default;
+        GainCache(const GainCache &) {}
+        GainCache &operator=(const GainCache &) { return *this; }
+    };
+
+    bool gainCacheEnabled_ = true;
+    mutable GainCache gainCache_;
+
+    /**
+     * Block-cut index of the component slots, used by
+     * impactSelectNodeFromComponent, removalSplitSizes and removeNode.
+     *
+     * The Tarjan search of a component records its articulation points
+     * and the DFS preorder of its nodes. A cut vertex splits off the
+     * subtrees of its separated DFS children, each a contiguous range of
+     * the preorder, and keeps the rest in one piece: the block-cut tree of
+     * the component rooted at the DFS root, without listing the blocks.
+     *
+     * An entry stays valid until the slot stamp of the gain cache moves past
+     * the move at which it was computed, so a move only invalidates the
+     * components it touched. Not copied with the graph.
+     */
+    struct ImpactCache
+    {
+        struct Entry
+        {
+            uint64_t stamp = 0;
+            bool valid = false;
+            std::vector<Node> candidates;  ///< Minimum-impact nodes
+            std::vector<Node> order;       ///< Nodes in DFS preorder
+        };
+
+        std::vector<Entry> entries;      ///< Per component slot
+        std::vector<TarjanEntry> nodes;  ///< Per node, sized on first use
+
+        ImpactCache() = default;
+        ImpactCache(const ImpactCache &) {}
+        ImpactCache &operator=(const ImpactCache &) { return *this; }
+    };
+
+    bool impactCacheEnabled_ = true;
+    mutable ImpactCache impactCache_;
+
+    // Records that a component slot changed in the current move.
+    void stampComponent(ComponentIndex componentIndex);
+
+    // Drops the cached gains of the neighbours of a node that changed component.
+    void invalidateNeighborGains(Node node);
+
+    // Collects the distinct components adjacent to a node.
+    void collectNeighborComponents(Node node,
+                                   std::vector<ComponentIndex> &components) const;
+
+    // Returns the change in objective when joining the given components
+    // through ``node``; non-additive objectives return the merged cost.
+    ObjValue mergeGain(Node node,
+                       const std::vector<ComponentIndex> &components) const;
+
+    template <class Policy>
+    ObjValue mergeGainOf(Node node,
+                         const std::vector<ComponentIndex> &components) const;
+
+    // Returns the weight of a node.
+    int nodeWeight(Node node) const
+    {
+        return nodeWeights_ ? (*nodeWeights_)[node] : 1;
+    }
+
+    // Returns the connection gain of a removed node, reusing the cache.
+    ObjValue cachedConnectionGain(Node node) const;
+
+    // Returns the cost of a component slot under the graph's objective.
+    ObjValue componentCost(ComponentIndex componentIndex) const;
+
+    // Adds or subtracts the cost of a slot from the running sum.
+    void addComponentCost(ComponentIndex componentIndex);
+    void subtractComponentCost(ComponentIndex componentIndex);
+
+    // Starts a new visit epoch over the DFS stamp buffer.
+    int nextVisitEpoch() const;
+
+    // Takes a component slot from the pool.
+    ComponentIndex allocateComponent();
+
+    // Returns an emptied component slot to the pool.
+    void releaseComponent(ComponentIndex componentIndex);
+
+    // Appends a node to a component and records its position.
+    void appendToComponent(ComponentIndex componentIndex, Node node);
+
+    // Swap-removes a node from its component.
+    void eraseFromComponent(ComponentIndex componentIndex, Node node);
+
+    // Finds the path-compressed group of a split search.
+    size_t findSearchGroup(size_t search) const;
+
+    // Splits a component after ``removedNode`` left it, moving every fragment
+    // except the one still being explored (or the largest) to a new slot.
+    void splitComponent(ComponentIndex componentIndex, Node removedNode);
+
+    // Returns whether a node takes part in traversals (not removed/excluded).
+    bool isNodeActive(Node node) const { return nodeFlags_[node] == NODE_ACTIVE; }
+
+    // Runs an iterative Tarjan search over a component, fills the node
+    // entries of the block-cut index, the DFS preorder into ``order`` and
+    // the minimum-impact nodes into ``workspace_.impactCandidates``.
     void tarjanInComponent(ComponentIndex compIndex,
-                        int nodeIdx,
-                        const std::vector<int> &nodeToIdx) const;
+                           std::vector<Node> &order) const;
+
+    template <class Policy>
+    void tarjanInComponentOf(ComponentIndex compIndex,
+                             std::vector<Node> &order) const;
+
+    // Returns the up to date block-cut entry of a slot, or nullptr.
+    const ImpactCache::Entry *currentBlockCut(ComponentIndex componentIndex) const;
+
+    // Returns the block-cut entry of a slot, searching the component again
+    // if a move touched it.
+    const ImpactCache::Entry &blockCut(ComponentIndex componentIndex) const;
+
+    // Collects the separated DFS children of a cut vertex of a slot.
+    void collectSeparatedChildren(ComponentIndex componentIndex,
+                                  Node node,
+                                  std::vector<Node> &children) const;
+
+    // Splits a component after the cut vertex ``removedNode`` left it, using
+    // the pieces recorded in its block-cut entry instead of a search.
+    void splitAlongBlockCut(ComponentIndex componentIndex,
+                            Node removedNode,
+                            const ImpactCache::Entry &entry);
+
+    // Copies the shared topology and the per-node state of ``other`` without
+    // its solution, then applies ``nodesToRemove``.
+    CNP_Graph(const CNP_Graph &other, const Solution &nodesToRemove);
 
 public:
-    NodeSet removedNodes;
+    Solution removedNodes;
 
     /**
      * Creates a deep copy of the graph.
@@ -77,26 +304,145 @@ public:
      */
     std::unique_ptr<CNP_Graph> clone() const;
 
-    CNP_Graph(NodeSet nodes, std::vector<NodeSet> adjList, int budget, int seed);
+    /**
+     * Creates a graph over the same topology with the given removal set.
+     *
+     * Equivalent to ``clone()`` followed by ``updateGraphByRemovedNodes()``,
+     * but skips copying the components that the update would discard.
+     *
+     * Parameters
+     * ----------
+     * nodesToRemove : Solution
+     *     Set of nodes removed in the new graph.
+     *
+     * Returns
+     * -------
+     * CNP_Graph
+     *     A new graph instance sharing this graph's topology.
+     */
+    std::unique_ptr<CNP_Graph>
+    cloneWithRemovedNodes(const Solution &nodesToRemove) const;
+
+    /**
+     * Turns this graph into a copy of ``source`` with the given removal set.
+     *
+     * The result equals ``source.cloneWithRemovedNodes(nodesToRemove)``,
+     * but the buffers, workspace and caches of this graph are kept, so a
+     * graph rebuilt for every offspring stops allocating once they have
+     * grown to the size of the problem.
+     *
+     * Parameters
+     * ----------
+     * source : CNP_Graph
+     *     Graph whose topology and per-node state are copied.
+     * nodesToRemove : Solution
+     *     Set of nodes removed in this graph.
+     */
+    void assignWithRemovedNodes(const CNP_Graph &source,
+                                const Solution &nodesToRemove);
+
+    /// Part of the residual graph that can be searched on its own.
+    struct Shard
+    {
+        std::vector<Node> nodes;  ///< Live nodes and owned removed nodes
+        Solution removed;         ///< Removed nodes owned by the shard
+    };
+
+    /**
+     * Partitions the residual graph into independent shards.
+     *
+     * Removed nodes joined by removed edges form clusters. Components next
+     * to a common cluster are grouped while a group weighs at most an even
+     * share of the residual weight, and the groups are spread over at most
+     * ``maxShards`` shards, heaviest first into the lightest shard. A
+     * cluster next to the components of one shard is owned by that shard,
+     * and one next to no live node by the first shard. The other clusters
+     * would join shards if added back, so they stay removed and belong to
+     * no shard.
+     *
+     * Moves inside a shard then touch no node outside it, and for an
+     * additive objective the objective changes by the shard's change.
+     *
+     * Parameters
+     * ----------
+     * maxShards : int
+     *     Most shards to create; no more than there are groups with at
+     *     least two nodes.
+     *
+     * Returns
+     * -------
+     * list[Shard]
+     *     The shards; empty if fewer than two can be created.
+     */
+    std::vector<Shard> partitionByComponents(int maxShards) const;
+
+    /**
+     * Creates a graph over one shard of this graph.
+     *
+     * The shard graph keeps the node ids, topology, ages and weights of
+     * this graph and excludes every node outside the shard, so its
+     * solutions are subsets of this graph's nodes.
+     *
+     * Parameters
+     * ----------
+     * shard : Shard
+     *     Shard returned by :meth:`partitionByComponents`.
+     * seed : int
+     *     Random seed of the shard graph.
+     *
+     * Returns
+     * -------
+     * CNP_Graph
+     *     Graph with the shard's removed nodes as its solution and their
+     *     number as its budget.
+     */
+    std::unique_ptr<CNP_Graph> shardGraph(const Shard &shard, int seed) const;
+
+    /**
+     * Creates a graph over ``nodes`` of a shared topology.
+     *
+     * Parameters
+     * ----------
+     * nodes : NodeSet
+     *     Nodes taking part in the problem; others are excluded.
+     * topology : CSRGraph
+     *     Shared adjacency.
+     * budget : int
+     *     Number of nodes to remove.
+     * seed : int
+     *     Random seed.
+     * nodeWeights : list[int], optional
+     *     Weight of every node: multiplicities from ProblemData's
+     *     kernelization, or node weights of the weighted objective. Null
+     *     weighs every node one.
+     * objective : ObjectiveKind, optional
+     *     Objective the graph maintains. Defaults to pairwise connectivity.
+     */
+    CNP_Graph(const NodeSet &nodes,
+              std::shared_ptr<const CSRGraph> topology,
+              int budget,
+              int seed,
+              std::shared_ptr<const std::vector<int>> nodeWeights = nullptr,
+              ObjectiveKind objective = ObjectiveKind::Pairwise);
 
-    CNP_Graph() {};
+    CNP_Graph() : topology_(std::make_shared<const CSRGraph>()) {}
 
     /**
      * Updates the graph to reflect node removals.
      *
      * Parameters
      * ----------
-     * removedNodes : NodeSet
+     * removedNodes : Solution
      *     Set of nodes that have been removed.
      */
-    void updateGraphByRemovedNodes(const NodeSet &removedNodes);
+    void updateGraphByRemovedNodes(const Solution &removedNodes);
 
     /**
      * Creates a reduced graph after node removal.
      *
      * Parameters
      * ----------
-     * nodesToRemove : NodeSet
+     * nodesToRemove : Solution
      *     Set of nodes to remove.
      *
      * Returns
@@ -104,7 +450,7 @@ public:
      * CNP_Graph
      *     The reduced graph.
      */
-    void getReducedGraphByRemovedNodes(const NodeSet &nodesToRemove);
+    void getReducedGraphByRemovedNodes(const Solution &nodesToRemove);
 
     /**
      * Adds a node back to the graph.
@@ -156,10 +502,10 @@ public:
      *
      * Returns
      * -------
-     * NodeSet
+     * Solution
      *     Set of nodes that have been removed.
      */
-    const NodeSet& getRemovedNodes() const;
+    const Solution &getRemovedNodes() const;
 
     /**
      * Sets the age of a node.
@@ -174,18 +520,27 @@ public:
     void setNodeAge(Node node, Age age);
 
     /**
-     * Calculates the objective value (connectivity) of the graph.
+     * Calculates the objective value of the graph.
+     *
+     * Additive objectives are kept up to date by every move; the largest
+     * component is found by a scan over the components.
      *
      * Returns
      * -------
      * int
-     *     The connectivity after node removal.
+     *     The objective after node removal: the connectivity for CNP.
      */
-    int getObjectiveValue() const;
+    ObjValue getObjectiveValue() const;
+
+    /// Objective maintained by the graph.
+    ObjectiveKind objective() const noexcept { return objective_; }
 
     // Converts to random feasible solution.
     std::unique_ptr<CNP_Graph> getRandomFeasibleGraph() const;
 
+    /// Generator of the random feasible graphs and random selections.
+    RandomNumberGenerator &generator() const noexcept { return rng_; }
+
     // Initializes components and node mapping.
     void initializeComponentsAndMapping();
 
@@ -204,6 +559,27 @@ public:
     // Selects node with minimum impact to remove from component.
     Node impactSelectNodeFromComponent(ComponentIndex componentIndex) const;
 
+    /**
+     * Sizes of the components that removing a node leaves in place of its
+     * own.
+     *
+     * Answered from the block-cut index of the component, which is only
+     * rebuilt if a move touched the component since it was built. A node
+     * that is not a cut vertex leaves one component (none if it was alone),
+     * in constant time; a cut vertex takes time linear in its degree.
+     *
+     * Parameters
+     * ----------
+     * node
+     *     An active node.
+     *
+     * Returns
+     * -------
+     * list[int]
+     *     The weights of the remaining pieces, in no particular order.
+     */
+    std::vector<size_t> removalSplitSizes(Node node) const;
+
     // Selects node to add back to graph.
     Node greedySelectNodeToAdd() const;
 
@@ -211,7 +587,35 @@ public:
     Node randomSelectNodeToRemove() const;
 
     // Calculates connection gain after adding a node.
-    int calculateConnectionGain(Node node) const;
+    ObjValue calculateConnectionGain(Node node) const;
+
+    /**
+     * Enables or disables the cached gain table of greedySelectNodeToAdd.
+     *
+     * The cache is enabled by default; disabling it recomputes every
+     * candidate's gain on each call.
+     *
+     * Parameters
+     * ----------
+     * enabled : bool
+     *     Whether to cache connection gains between moves.
+     */
+    void setGainCacheEnabled(bool enabled);
+
+    /**
+     * Enables or disables the per-component block-cut index of
+     * impactSelectNodeFromComponent.
+     *
+     * The index is enabled by default; disabling it reruns the articulation
+     * point search on each call, and removeNode then always searches for
+     * the pieces of a split component.
+     *
+     * Parameters
+     * ----------
+     * enabled : bool
+     *     Whether to reuse impact results of components unchanged since.
+     */
+    void setImpactCacheEnabled(bool enabled);
 };
 
 #endif
@@ -0,0 +1,104 @@
+#include "CSRGraph.h"
+#include <algorithm>
+
+CSRGraph::CSRGraph(const std::vector<NodeSet> &adjList)
+{
+    const size_t numNodes = adjList.size();
+    offsetStorage_.assign(numNodes + 1, 0);
+
+    for (size_t v = 0; v < numNodes; ++v)
+    {
+        size_t degree = adjList[v].size();
+        if (adjList[v].contains(static_cast<Node>(v)))
+        {
+            degree--;
+        }
+        offsetStorage_[v + 1] = offsetStorage_[v] + degree;
+    }
+
+    neighborStorage_.resize(offsetStorage_[numNodes]);
+    for (size_t v = 0; v < numNodes; ++v)
+    {
+        size_t pos = offsetStorage_[v];
+        for (Node neighbor : adjList[v])
+        {
+            if (neighbor != static_cast<Node>(v))
+            {
+                neighborStorage_[pos++] = neighbor;
+            }
+        }
+
+        // Set iteration order differs between standard libraries.
+        std::sort(neighborStorage_.begin() + offsetStorage_[v],
+                  neighborStorage_.begin() + pos);
+    }
+    bindStorage();
+}
+
+CSRGraph::CSRGraph(int numNodes,
+                   const std::vector<std::pair<Node, Node>> &arcs,
+                   bool symmetric)
+{
+    offsetStorage_.assign(static_cast<size_t>(numNodes) + 1, 0);
+
+    for (const auto &[u, v] : arcs)
+    {
+        if (u != v)
+        {
+            offsetStorage_[u + 1]++;
+            if (symmetric)
+            {
+                offsetStorage_[v + 1]++;
+            }
+        }
+    }
+    for (size_t v = 0; v < static_cast<size_t>(numNodes); ++v)
+    {
+        offsetStorage_[v + 1] += offsetStorage_[v];
+    }
+
+    neighborStorage_.resize(offsetStorage_[numNodes]);
+    std::vector<size_t> next(offsetStorage_.begin(), offsetStorage_.end() - 1);
+    for (const auto &[u, v] : arcs)
+    {
+        if (u != v)
+        {
+            neighborStorage_[next[u]++] = v;
+            if (symmetric)
+            {
+                neighborStorage_[next[v]++] = u;
+            }
+        }
+    }
+
+    // Sort every row and squeeze out repeated arcs, compacting in place.
+    size_t write = 0;
+    for (size_t v = 0; v < static_cast<size_t>(numNodes); ++v)
+    {
+        const auto rowBegin = neighborStorage_.begin() + offsetStorage_[v];
+        const auto rowEnd = neighborStorage_.begin() + offsetStorage_[v + 1];
+        std::sort(rowBegin, rowEnd);
+        const auto uniqueEnd = std::unique(rowBegin, rowEnd);
+
+        offsetStorage_[v] = write;
+        write = std::move(rowBegin, uniqueEnd, neighborStorage_.begin() + write)
+                - neighborStorage_.begin();
+    }
+    offsetStorage_[numNodes] = write;
+    neighborStorage_.resize(write);
+    neighborStorage_.shrink_to_fit();
+    bindStorage();
+}
+
+CSRGraph::CSRGraph(std::span<const size_t> offsets,
+                   std::span<const Node> neighbors,
+                   std::shared_ptr<const void> backing)
+    : offsets_(offsets), neighbors_(neighbors), backing_(std::move(backing))
+{
+}
+
+void CSRGraph::bindStorage() noexcept
+{
+    offsets_ = offsetStorage_;
+    neighbors_ = neighborStorage_;
+}
@@ -0,0 +1,141 @@
+#ifndef CSR_GRAPH_H
+#define CSR_GRAPH_H
+
+#include "Types.h"
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+/**
+ * CSRGraph
+ *
+ * Immutable compressed sparse row (CSR) adjacency structure.
+ *
+ * Stores the neighbors of all nodes in one contiguous array, indexed by a
+ * per-node offset table. Built once from the problem data and shared by all
+ * graph instances (and their clones) through a ``std::shared_ptr``. Node
+ * removal is never reflected here; the graph implementations track it with a
+ * per-node flag mask checked during traversal instead.
+ *
+ * The arrays are either owned or borrowed from a backing object, such as a
+ * memory-mapped graph file, that the instance keeps alive.
+ */
+class CSRGraph
+{
+private:
+    std::vector<size_t> offsetStorage_;  ///< Owned offsets, if any
+    std::vector<Node> neighborStorage_;  ///< Owned neighbors, if any
+
+    std::span<const size_t> offsets_;  ///< Offsets into neighbors_, size n + 1
+    std::span<const Node> neighbors_;  ///< Concatenated neighbor lists
+    std::shared_ptr<const void> backing_;  ///< Owner of borrowed arrays
+
+    /// Points the views at the owned storage.
+    void bindStorage() noexcept;
+
+public:
+    CSRGraph() : offsetStorage_(1, 0) { bindStorage(); }
+
+    // The views may point into the owned storage, so instances stay put;
+    // they are shared through ``std::shared_ptr`` anyway.
+    CSRGraph(const CSRGraph &) = delete;
+    CSRGraph &operator=(const CSRGraph &) = delete;
+
+    /**
+     * Builds the CSR structure from an adjacency list.
+     *
+     * Self-loops are dropped, since none of the algorithms assign any
+     * meaning to them. Every row is sorted, so traversal order, and with it
+     * the search, does not depend on the set implementation.
+     *
+     * Parameters
+     * ----------
+     * adjList : list[set[int]]
+     *     Adjacency list where index ``v`` holds the neighbors of node ``v``.
+     */
+    explicit CSRGraph(const std::vector<NodeSet> &adjList);
+
+    /**
+     * Builds the CSR structure directly from a list of arcs.
+     *
+     * Degrees are counted in a first pass over the arcs and the neighbor
+     * array is filled in a second, so no per-node sets are built. Every row
+     * is then sorted and duplicate arcs and self-loops are dropped.
+     *
+     * Parameters
+     * ----------
+     * numNodes : int
+     *     Number of nodes; every endpoint must be in ``[0, numNodes)``.
+     * arcs : list[tuple[int, int]]
+     *     Arcs ``(u, v)``, each making ``v`` a neighbor of ``u``.
+     * symmetric : bool
+     *     Whether every arc also makes ``u`` a neighbor of ``v``.
+     */
+    CSRGraph(int numNodes,
+             const std::vector<std::pair<Node, Node>> &arcs,
+             bool symmetric);
+
+    /**
+     * Wraps existing CSR arrays without copying them.
+     *
+     * The arrays must be well formed: ``offsets`` non-decreasing from 0 to
+     * ``neighbors.size()``, and every neighbor a valid node.
+     *
+     * Parameters
+     * ----------
+     * offsets : list[int]
+     *     Row offsets, one more than the number of nodes.
+     * neighbors : list[int]
+     *     Concatenated, sorted neighbor rows.
+     * backing : object
+     *     Owner of the arrays, kept alive as long as this instance.
+     */
+    CSRGraph(std::span<const size_t> offsets,
+             std::span<const Node> neighbors,
+             std::shared_ptr<const void> backing);
+
+    /// Returns the row offsets, one more than the number of nodes.
+    std::span<const size_t> offsets() const noexcept { return offsets_; }
+
+    /// Returns the concatenated neighbor rows.
+    std::span<const Node> neighborArray() const noexcept { return neighbors_; }
+
+    /**
+     * Returns the number of nodes covered by the offset table.
+     *
+     * Returns
+     * -------
+     * int
+     *     Number of nodes.
+     */
+    int numNodes() const noexcept
+    {
+        return static_cast<int>(offsets_.size() - 1);
+    }
+
+    /**
+     * Returns the number of stored (directed) adjacency entries.
+     *
+     * Returns
+     * -------
+     * int
+     *     Twice the number of undirected edges for symmetric inputs.
+     */
+    size_t numEntries() const noexcept { return neighbors_.size(); }
+
+    /// Returns the degree of node ``v`` in the original graph.
+    size_t degree(Node v) const noexcept
+    {
+        return offsets_[v + 1] - offsets_[v];
+    }
+
+    /// Returns a contiguous view over the neighbors of node ``v``.
+    std::span<const Node> neighbors(Node v) const noexcept
+    {
+        return {neighbors_.data() + offsets_[v], degree(v)};
+    }
+};
+
+#endif  // CSR_GRAPH_H
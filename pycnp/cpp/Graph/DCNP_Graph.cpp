@@ -1,298 +1,549 @@
 
 #include "DCNP_Graph.h"
+#include "../ThreadPool.h"
+#include "../Trace.h"
 #include <algorithm>
+#include <limits>
 
-namespace
-{
-inline size_t treeIndex(int numNodes, Node row, Node col)
-{
-    return static_cast<size_t>(row) * static_cast<size_t>(numNodes)
-        + static_cast<size_t>(col);
-}
-}
-
-DCNP_Graph::DCNP_Graph(NodeSet nodes,
+DCNP_Graph::DCNP_Graph(const NodeSet &nodes,
                     int K,
-                    std::vector<NodeSet> adjList,
+                    std::shared_ptr<const CSRGraph> topology,
                     int numToRemove,
-                    int seed)
+                    int seed,
+                    TreeStorage storage)
+    : topology_(std::move(topology))
 {
-    numNodes_ = nodes.size();
+    numNodes_ = topology_->numNodes();
     kHops_ = K;
-    originalNodesSet_ = nodes;
-    initialNodesSet_ = nodes;
-    originalAdjList_ = adjList;
-    currentAdjList_ = adjList;
-    initialAdjList_ = adjList;
+    nodeFlags_.assign(numNodes_, NODE_EXCLUDED);
+    for (Node node : nodes)
+    {
+        nodeFlags_[node] = NODE_ACTIVE;
+    }
     numToRemove_ = numToRemove;
-    initialNumToRemove_ = numToRemove;
-    initialKHops_ = K;
+    removedNodes_ = Solution(numNodes_);
+    removedNodes_.reserve(numToRemove);
     rng_.setSeed(seed);
-    initialSeed_ = seed;
 
     nodeAge_.resize(numNodes_, 0);
 
-    intree_.assign(static_cast<size_t>(numNodes_) * static_cast<size_t>(numNodes_),
-                  0);
+    trees_ = KHopTrees(numNodes_, storage);
 
     treeSize_.resize(numNodes_, 0);
-    bfsVisited_.resize(numNodes_, 0);
-    bfsLevel_.resize(numNodes_, 0);
-    bfsQueue_.resize(numNodes_);
 
-    buildTree();
+    // The first build dominates start-up on large graphs, so it always uses
+    // every hardware thread.
+    auto &roots = workspace_.affectedRoots;
+    roots.resize(numNodes_);
+    std::iota(roots.begin(), roots.end(), 0);
+    rebuildTrees(roots, 0);
+
+    // Trees only shrink as nodes are removed, so the unreduced graph gives
+    // the sizes to choose the layout for this graph and its clones.
+    if (storage == TreeStorage::Auto)
+    {
+        trees_.setStorage(TreeStorage::Auto);
+    }
 }
 
-void DCNP_Graph::bfsKTree(Node v)
+DCNP_Graph::DCNP_Graph(const DCNP_Graph &other, const Solution &nodesToRemove)
+    : numNodes_(other.numNodes_),
+      kHops_(other.kHops_),
+      numToRemove_(other.numToRemove_),
+      nodeAge_(other.nodeAge_),
+      topology_(other.topology_),
+      nodeFlags_(other.nodeFlags_),
+      trees_(numNodes_, other.trees_.storage()),
+      treeSize_(numNodes_, 0),
+      removedNodes_(numNodes_),
+      rng_(other.rng_),
+      numThreads_(other.numThreads_)
 {
+    removedNodes_.reserve(std::max(numToRemove_, 0));
+    updateGraphByRemovedNodes(nodesToRemove);
+}
 
-    auto rowBegin = intree_.begin()
-        + treeIndex(numNodes_, v, 0);
-    std::fill(rowBegin,
-              rowBegin + static_cast<size_t>(numNodes_),
-              static_cast<uint8_t>(0));
-
-    if (isNodeRemoved(v))
+void DCNP_Graph::bfsKTree(Node v)
+{
+    if (workspace_.bfs.empty())
     {
-        treeSize_[v] = 0;
-        return;
+        workspace_.bfs.resize(1);
     }
+    BfsScratch &scratch = workspace_.bfs.front();
+    scratch.sizeDelta = 0;
+    bfsKTree(v, scratch);
+    treeSizeSum_ += scratch.sizeDelta;
+}
 
-    if (bfsVisited_.size() < static_cast<size_t>(numNodes_))
-    {
-        bfsVisited_.resize(numNodes_, 0);
-    }
-    else
-    {
-        std::fill(bfsVisited_.begin(),
-                  bfsVisited_.begin() + numNodes_,
-                  static_cast<uint8_t>(0));
-    }
-    if (bfsLevel_.size() < static_cast<size_t>(numNodes_))
+size_t DCNP_Graph::kHopBfs(Node root,
+                          Node blocked,
+                          Node unblocked,
+                          BfsScratch &scratch) const
+{
+    PYCNP_TRACE_COUNT(BfsRecomputes);
+    if (scratch.visitEpoch.size() < static_cast<size_t>(numNodes_))
     {
-        bfsLevel_.resize(numNodes_, 0);
+        scratch.visitEpoch.assign(numNodes_, 0);
+        scratch.level.resize(numNodes_, 0);
+        scratch.queue.resize(numNodes_);
+        scratch.epoch = 0;
     }
-    if (bfsQueue_.size() < static_cast<size_t>(numNodes_))
+    if (++scratch.epoch == 0)
     {
-        bfsQueue_.resize(numNodes_);
+        std::fill(scratch.visitEpoch.begin(), scratch.visitEpoch.end(), 0);
+        scratch.epoch = 1;
     }
 
+    const uint32_t epoch = scratch.epoch;
     size_t head = 0;
     size_t tail = 0;
-    bfsQueue_[tail++] = v;
-    bfsVisited_[v] = 1;
-    bfsLevel_[v] = 0;
-
-    size_t visitedCount = 0;
+    scratch.queue[tail++] = root;
+    scratch.visitEpoch[root] = epoch;
+    scratch.level[root] = 0;
 
     while (head < tail)
     {
-        Node currentNode = bfsQueue_[head++];
+        Node currentNode = scratch.queue[head++];
 
-        if (bfsLevel_[currentNode] < kHops_)
+        if (scratch.level[currentNode] < kHops_)
         {
-
-            for (Node neighbor : currentAdjList_[currentNode])
+            for (Node neighbor : topology_->neighbors(currentNode))
             {
-                if (isNodeRemoved(neighbor) || bfsVisited_[neighbor])
+                if (scratch.visitEpoch[neighbor] == epoch)
                 {
                     continue;
                 }
-                bfsQueue_[tail++] = neighbor;
-                bfsVisited_[neighbor] = 1;
-                bfsLevel_[neighbor] = bfsLevel_[currentNode] + 1;
+                if (neighbor != unblocked
+                    && (neighbor == blocked || !isNodeActive(neighbor)))
+                {
+                    continue;
+                }
+                scratch.queue[tail++] = neighbor;
+                scratch.visitEpoch[neighbor] = epoch;
+                scratch.level[neighbor] = scratch.level[currentNode] + 1;
             }
         }
+    }
 
-        intree_[treeIndex(numNodes_, v, currentNode)] = static_cast<uint8_t>(1);
-        ++visitedCount;
+    return tail;
+}
+
+void DCNP_Graph::bfsKTree(Node v, BfsScratch &scratch)
+{
+    const int oldSize = treeSize_[v];
+
+    if (!isNodeActive(v))
+    {
+        trees_.assign(v, {});
+        treeSize_[v] = 0;
+    }
+    else
+    {
+        // The queue holds exactly the tree, the root included.
+        const size_t size = kHopBfs(v, INVALID_NODE, INVALID_NODE, scratch);
+        trees_.assign(v, {scratch.queue.data(), size});
+        treeSize_[v] = static_cast<int>(size - 1);
     }
 
-    treeSize_[v]
-        = visitedCount > 0 ? static_cast<int>(visitedCount - 1) : 0;
+    scratch.sizeDelta += treeSize_[v] - oldSize;
 }
 
-void DCNP_Graph::buildTree()
+void DCNP_Graph::rebuildTrees(const std::vector<Node> &roots, int numThreads)
 {
-    for (int i = 0; i < numNodes_; i++)
+    // Below this many roots, handing out work costs more than it saves.
+    constexpr size_t MIN_ROOTS_PER_THREAD = 32;
+
+    const size_t numChunks
+        = std::min(ThreadPool::resolveThreads(numThreads),
+                   std::max<size_t>(1, roots.size() / MIN_ROOTS_PER_THREAD));
+    if (workspace_.bfs.size() < numChunks)
     {
-        bfsKTree(i);
+        workspace_.bfs.resize(numChunks);
     }
+    for (BfsScratch &scratch : workspace_.bfs)
+    {
+        scratch.sizeDelta = 0;
+    }
+
+    // Each root owns its tree row and size entry, so chunks never write
+    // to the same memory.
+    ThreadPool::instance().parallelFor(
+        roots.size(),
+        numChunks,
+        [&](size_t begin, size_t end, size_t chunk)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                bfsKTree(roots[i], workspace_.bfs[chunk]);
+            }
+        });
+
+    for (const BfsScratch &scratch : workspace_.bfs)
+    {
+        treeSizeSum_ += scratch.sizeDelta;
+    }
+}
+
+void DCNP_Graph::buildTree()
+{
+    auto &roots = workspace_.affectedRoots;
+    roots.resize(numNodes_);
+    std::iota(roots.begin(), roots.end(), 0);
+    rebuildTrees(roots, numThreads_);
 }
 
-void DCNP_Graph::updateGraphByRemovedNodes(const NodeSet &nodesToRemove)
+void DCNP_Graph::setNumThreads(int numThreads)
 {
+    numThreads_ = numThreads;
+}
 
-    removedNodes_.clear();
+void DCNP_Graph::updateGraphByRemovedNodes(const Solution &nodesToRemove)
+{
 
-    currentAdjList_ = originalAdjList_;
+    removedNodes_.clear();
+    for (NodeFlags &flags : nodeFlags_)
+    {
+        flags &= ~NODE_REMOVED;
+    }
 
     for (Node node : nodesToRemove)
     {
         removedNodes_.insert(node);
+        nodeFlags_[node] |= NODE_REMOVED;
     }
 
     buildTree();
 }
 
-void DCNP_Graph::getReducedGraphByRemovedNodes(const NodeSet &removeSet)
+void DCNP_Graph::getReducedGraphByRemovedNodes(const Solution &removeSet)
 {
 
     removedNodes_.clear();
+    for (NodeFlags &flags : nodeFlags_)
+    {
+        flags &= ~NODE_REMOVED;
+    }
 
     numToRemove_ -= removeSet.size();
 
     for (Node node : removeSet)
     {
-
-        originalNodesSet_.erase(node);
-
-        for (Node neighbor : currentAdjList_[node])
-        {
-            originalAdjList_[neighbor].erase(node);
-        }
-
-        originalAdjList_[node].clear();
+        nodeFlags_[node] |= NODE_EXCLUDED;
     }
 
-    currentAdjList_ = originalAdjList_;
-
     buildTree();
 }
 
 void DCNP_Graph::addNode(Node nodeToAdd)
 {
+    PYCNP_TRACE_COUNT(NodeAdditions);
 
     removedNodes_.erase(nodeToAdd);
+    nodeFlags_[nodeToAdd] &= ~NODE_REMOVED;
 
     bfsKTree(nodeToAdd);
 
-    for (int i = 0; i < numNodes_; i++)
-    {
-
-        if (intree_[treeIndex(numNodes_, nodeToAdd, i)])
+    // Every root within K hops of the added node gains members.
+    auto &affectedRoots = workspace_.affectedRoots;
+    affectedRoots.clear();
+    trees_.forEachMember(nodeToAdd, [&](Node root) {
+        if (root != nodeToAdd)
         {
-            bfsKTree(i);
+            affectedRoots.push_back(root);
         }
-    }
+    });
+
+    rebuildTrees(affectedRoots, numThreads_);
 }
 
 void DCNP_Graph::removeNode(Node nodeToRemove)
 {
+    PYCNP_TRACE_COUNT(NodeRemovals);
 
     removedNodes_.insert(nodeToRemove);
+    nodeFlags_[nodeToRemove] |= NODE_REMOVED;
 
-    for (int i = 0; i < numNodes_; i++)
-    {
+    // The trees containing the removed node are exactly its own members.
+    auto &affectedRoots = workspace_.affectedRoots;
+    affectedRoots.clear();
+    trees_.forEachMember(nodeToRemove,
+                         [&](Node root) { affectedRoots.push_back(root); });
 
-        if (intree_[treeIndex(numNodes_, i, nodeToRemove)])
-        {
-            bfsKTree(i);
-        }
-    }
+    rebuildTrees(affectedRoots, numThreads_);
 }
 
-const std::vector<double> &DCNP_Graph::calculateBetweennessCentrality() const
+void DCNP_Graph::accumulateBetweenness(Node source,
+                                       int maxDepth,
+                                       BrandesScratch &scratch,
+                                       std::vector<double> &score) const
 {
+    auto &distance = scratch.distance;
+    auto &sigma = scratch.sigma;
+    auto &dependency = scratch.dependency;
 
-    static std::vector<double> betweenness;
-    betweenness.resize(numNodes_, 0.0);
+    size_t head = 0;
+    size_t tail = 0;
+    scratch.order[tail++] = source;
+    distance[source] = 0;
+    sigma[source] = 1.0;
 
-    for (int s = 0; s < numNodes_; s++)
+    while (head < tail)
     {
-        if (isNodeRemoved(s))
+        Node v = scratch.order[head++];
+        if (maxDepth > 0 && distance[v] >= maxDepth)
+        {
             continue;
+        }
 
-        std::stack<int> S;
+        for (Node w : topology_->neighbors(v))
+        {
+            if (!isNodeActive(w))
+            {
+                continue;
+            }
+            if (distance[w] < 0)
+            {
+                distance[w] = distance[v] + 1;
+                scratch.order[tail++] = w;
+            }
+            if (distance[w] == distance[v] + 1)
+            {
+                sigma[w] += sigma[v];
+            }
+        }
+    }
 
-        std::vector<std::list<int>> P(numNodes_);
+    // Predecessors are the neighbours one hop closer to the source, so they
+    // are found again from the distances instead of being stored.
+    for (size_t i = tail; i-- > 1;)
+    {
+        Node w = scratch.order[i];
+        const double share = (1.0 + dependency[w]) / sigma[w];
+        for (Node v : topology_->neighbors(w))
+        {
+            if (distance[v] == distance[w] - 1)
+            {
+                dependency[v] += sigma[v] * share;
+            }
+        }
+        score[w] += dependency[w];
+    }
 
-        std::vector<int> d(numNodes_, -1);
+    for (size_t i = 0; i < tail; ++i)
+    {
+        Node v = scratch.order[i];
+        distance[v] = -1;
+        sigma[v] = 0.0;
+        dependency[v] = 0.0;
+    }
+}
 
-        std::vector<int> sigma(numNodes_, 0);
+std::vector<double>
+DCNP_Graph::calculateBetweennessCentrality(int maxDepth, int numPivots) const
+{
+    auto &sources = workspace_.sources;
+    sources.clear();
+    for (Node node = 0; node < numNodes_; ++node)
+    {
+        if (isNodeActive(node))
+        {
+            sources.push_back(node);
+        }
+    }
 
-        sigma[s] = 1;
-        d[s] = 0;
+    double scale = 1.0;
+    if (numPivots > 0 && static_cast<size_t>(numPivots) < sources.size())
+    {
+        for (size_t i = 0; i < static_cast<size_t>(numPivots); ++i)
+        {
+            const size_t pick = i + rng_.generateIndex(sources.size() - i);
+            std::swap(sources[i], sources[pick]);
+        }
+        scale = static_cast<double>(sources.size()) / numPivots;
+        sources.resize(numPivots);
+    }
 
-        std::queue<int> Q;
-        Q.push(s);
+    // Sources are summed per block in a fixed order, so the rounding and
+    // therefore the ranking of nodes do not change with the thread count.
+    constexpr size_t MAX_BLOCKS = 16;
+    constexpr size_t MIN_SOURCES_PER_BLOCK = 8;
 
-        while (!Q.empty())
-        {
-            int v = Q.front();
-            Q.pop();
+    const size_t numBlocks = std::min(
+        MAX_BLOCKS, std::max<size_t>(1, sources.size() / MIN_SOURCES_PER_BLOCK));
+    const size_t numWorkers
+        = std::min(ThreadPool::resolveThreads(numThreads_), numBlocks);
 
-            S.push(v);
+    auto &blocks = workspace_.betweennessBlocks;
+    if (blocks.size() < numBlocks)
+    {
+        blocks.resize(numBlocks);
+    }
+    auto &scratches = workspace_.brandes;
+    if (scratches.size() < numWorkers)
+    {
+        scratches.resize(numWorkers);
+    }
+    for (size_t worker = 0; worker < numWorkers; ++worker)
+    {
+        BrandesScratch &scratch = scratches[worker];
+        if (scratch.distance.size() < static_cast<size_t>(numNodes_))
+        {
+            scratch.distance.assign(numNodes_, -1);
+            scratch.sigma.assign(numNodes_, 0.0);
+            scratch.dependency.assign(numNodes_, 0.0);
+            scratch.order.resize(numNodes_);
+        }
+    }
 
-            for (Node w : currentAdjList_[v])
+    ThreadPool::instance().parallelFor(
+        numBlocks,
+        numWorkers,
+        [&](size_t begin, size_t end, size_t worker)
+        {
+            for (size_t block = begin; block < end; ++block)
             {
+                auto &score = blocks[block];
+                score.assign(numNodes_, 0.0);
 
-                if (isNodeRemoved(w))
-                    continue;
-
-                if (d[w] < 0)
+                const size_t first = sources.size() * block / numBlocks;
+                const size_t last = sources.size() * (block + 1) / numBlocks;
+                for (size_t i = first; i < last; ++i)
                 {
-                    Q.push(w);
-                    d[w] = d[v] + 1;
+                    accumulateBetweenness(
+                        sources[i], maxDepth, scratches[worker], score);
                 }
+            }
+        });
 
-                if (d[w] == d[v] + 1)
-                {
+    std::vector<double> betweenness(numNodes_, 0.0);
+    for (size_t block = 0; block < numBlocks; ++block)
+    {
+        for (Node node = 0; node < numNodes_; ++node)
+        {
+            betweenness[node] += blocks[block][node];
+        }
+    }
+    if (scale != 1.0)
+    {
+        for (double &value : betweenness)
+        {
+            value *= scale;
+        }
+    }
 
-                    sigma[w] += sigma[v];
+    return betweenness;
+}
 
-                    P[w].push_back(v);
-                }
-            }
+ObjValue DCNP_Graph::calculateKhopTreeSize() const
+{
+    // Removed and excluded roots have empty trees, so the running sum over
+    // all roots equals the sum over the remaining ones.
+    return treeSizeSum_ / 2;
+}
+
+int64_t DCNP_Graph::removalDelta(Node node, BfsScratch &scratch) const
+{
+    // The pairs of ``node`` itself disappear, and every other root of its
+    // tree may lose the members it only reached through ``node``.
+    int64_t delta = -static_cast<int64_t>(treeSize_[node]);
+
+    auto &roots = scratch.roots;
+    roots.clear();
+    trees_.forEachMember(node, [&](Node root) {
+        if (root != node)
+        {
+            roots.push_back(root);
         }
+    });
 
-        std::vector<double> delta(numNodes_, 0.0);
+    for (Node root : roots)
+    {
+        const size_t size = kHopBfs(root, node, INVALID_NODE, scratch);
+        delta += static_cast<int64_t>(size - 1) - treeSize_[root];
+    }
 
-        while (!S.empty())
-        {
-            int w = S.top();
-            S.pop();
+    return delta;
+}
 
-            for (auto v : P[w])
-            {
+int64_t DCNP_Graph::additionDelta(Node node, BfsScratch &scratch) const
+{
+    // The new tree of ``node`` holds exactly the roots whose trees grow.
+    const size_t treeSize = kHopBfs(node, INVALID_NODE, node, scratch);
+    int64_t delta = static_cast<int64_t>(treeSize - 1);
 
-                delta[v] += (static_cast<double>(sigma[v]) / sigma[w])
-                            * (1.0 + delta[w]);
-            }
+    auto &roots = scratch.roots;
+    roots.assign(scratch.queue.begin() + 1, scratch.queue.begin() + treeSize);
 
-            if (w != s)
-            {
-                betweenness[w] += delta[w];
-            }
-        }
+    for (Node root : roots)
+    {
+        const size_t size = kHopBfs(root, INVALID_NODE, node, scratch);
+        delta += static_cast<int64_t>(size - 1) - treeSize_[root];
     }
 
-    return betweenness;
+    return delta;
 }
 
-int DCNP_Graph::calculateKhopTreeSize() const
+ObjValue DCNP_Graph::removalGain(Node node) const
 {
-    int sum = 0;
+    if (workspace_.bfs.empty())
+    {
+        workspace_.bfs.resize(1);
+    }
+    return -removalDelta(node, workspace_.bfs.front()) / 2;
+}
 
-    for (int i = 0; i < numNodes_; i++)
+ObjValue DCNP_Graph::additionCost(Node node) const
+{
+    if (workspace_.bfs.empty())
     {
-        if (!isNodeRemoved(i))
-        {
-            sum += treeSize_[i];
-        }
+        workspace_.bfs.resize(1);
     }
+    return additionDelta(node, workspace_.bfs.front()) / 2;
+}
 
-    return sum / 2;
+template <typename Delta>
+void DCNP_Graph::evaluateCandidates(Delta &&delta) const
+{
+    // Each candidate re-counts a whole neighbourhood of trees, so far fewer
+    // of them than of plain rebuilds make a chunk worthwhile.
+    constexpr size_t MIN_CANDIDATES_PER_THREAD = 4;
+
+    const auto &candidates = workspace_.candidates;
+    const size_t numChunks = std::min(
+        ThreadPool::resolveThreads(numThreads_),
+        std::max<size_t>(1, candidates.size() / MIN_CANDIDATES_PER_THREAD));
+    if (workspace_.bfs.size() < numChunks)
+    {
+        workspace_.bfs.resize(numChunks);
+    }
+    workspace_.deltas.resize(candidates.size());
+
+    ThreadPool::instance().parallelFor(
+        candidates.size(),
+        numChunks,
+        [&](size_t begin, size_t end, size_t chunk)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                workspace_.deltas[i]
+                    = delta(candidates[i], workspace_.bfs[chunk]);
+            }
+        });
 }
 
 std::unique_ptr<DCNP_Graph> DCNP_Graph::getRandomFeasibleGraph() const
 {
-    auto tempGraph = std::make_unique<DCNP_Graph>(*this);
-
-    NodeSet nodesToRemove;
+    Solution nodesToRemove(numNodes_);
 
-    std::vector<Node> availableNodes(originalNodesSet_.begin(),
-                                    originalNodesSet_.end());
+    std::vector<Node> availableNodes;
+    availableNodes.reserve(numNodes_);
+    for (Node node = 0; node < numNodes_; ++node)
+    {
+        if (!(nodeFlags_[node] & NODE_EXCLUDED))
+        {
+            availableNodes.push_back(node);
+        }
+    }
 
     for (int i = 0; i < numToRemove_ && !availableNodes.empty(); i++)
     {
@@ -304,43 +555,45 @@ std::unique_ptr<DCNP_Graph> DCNP_Graph::getRandomFeasibleGraph() const
         availableNodes.pop_back();
     }
 
-    tempGraph->updateGraphByRemovedNodes(nodesToRemove);
-
-    return tempGraph;
+    return cloneWithRemovedNodes(nodesToRemove);
 }
 
 Node DCNP_Graph::findBestNodeToRemove()
 {
 
-    int currentObjective = calculateKhopTreeSize();
-    Node bestNode = INVALID_NODE;
-    std::vector<Node> bestList;
-    int maxImprovement = 0;
-
+    auto &candidates = workspace_.candidates;
+    candidates.clear();
     for (int i = 0; i < numNodes_; i++)
     {
         if (!isNodeRemoved(i))
         {
+            candidates.push_back(i);
+        }
+    }
 
-            removeNode(i);
-            int newObjective = calculateKhopTreeSize();
+    evaluateCandidates([this](Node node, BfsScratch &scratch)
+                       { return removalDelta(node, scratch); });
 
-            int improvement = currentObjective - newObjective;
+    Node bestNode = INVALID_NODE;
+    auto &bestList = workspace_.bestCandidates;
+    bestList.clear();
+    int64_t maxImprovement = 0;
 
-            if (improvement > maxImprovement)
-            {
-                maxImprovement = improvement;
-                bestNode = i;
-                bestList.clear();
-                bestList.push_back(bestNode);
-            }
+    for (size_t i = 0; i < candidates.size(); i++)
+    {
+        int64_t improvement = -workspace_.deltas[i];
 
-            else if (improvement == maxImprovement)
-            {
-                bestList.push_back(i);
-            }
+        if (improvement > maxImprovement)
+        {
+            maxImprovement = improvement;
+            bestNode = candidates[i];
+            bestList.clear();
+            bestList.push_back(bestNode);
+        }
 
-            addNode(i);
+        else if (improvement == maxImprovement)
+        {
+            bestList.push_back(candidates[i]);
         }
     }
 
@@ -355,34 +608,33 @@ Node DCNP_Graph::findBestNodeToRemove()
 Node DCNP_Graph::findBestNodeToAdd()
 {
 
-    NodeSet solution = getRemovedNodes();
-    int currentObjective = calculateKhopTreeSize();
-    Node bestNode = INVALID_NODE;
-    std::vector<Node> bestList;
-    int minDeterioration = std::numeric_limits<int>::max();
+    auto &candidates = workspace_.candidates;
+    candidates.assign(removedNodes_.begin(), removedNodes_.end());
 
-    for (Node node : solution)
-    {
+    evaluateCandidates([this](Node node, BfsScratch &scratch)
+                       { return additionDelta(node, scratch); });
 
-        addNode(node);
-        int newObjective = calculateKhopTreeSize();
+    Node bestNode = INVALID_NODE;
+    auto &bestList = workspace_.bestCandidates;
+    bestList.clear();
+    int64_t minDeterioration = std::numeric_limits<int64_t>::max();
 
-        int deterioration = newObjective - currentObjective;
+    for (size_t i = 0; i < candidates.size(); i++)
+    {
+        int64_t deterioration = workspace_.deltas[i];
 
         if (deterioration < minDeterioration)
         {
             minDeterioration = deterioration;
-            bestNode = node;
+            bestNode = candidates[i];
             bestList.clear();
             bestList.push_back(bestNode);
         }
 
         else if (deterioration == minDeterioration)
         {
-            bestList.push_back(node);
+            bestList.push_back(candidates[i]);
         }
-
-        removeNode(node);
     }
 
     if (bestList.size() > 1)
@@ -409,6 +661,39 @@ std::unique_ptr<DCNP_Graph> DCNP_Graph::clone() const
     return std::make_unique<DCNP_Graph>(*this);
 }
 
+std::unique_ptr<DCNP_Graph>
+DCNP_Graph::cloneWithRemovedNodes(const Solution &nodesToRemove) const
+{
+    return std::unique_ptr<DCNP_Graph>(new DCNP_Graph(*this, nodesToRemove));
+}
+
+void DCNP_Graph::assignWithRemovedNodes(const DCNP_Graph &source,
+                                        const Solution &nodesToRemove)
+{
+    // Every tree is rebuilt below, so trees of the same size and layout are
+    // overwritten row by row instead of being allocated again.
+    if (numNodes_ != source.numNodes_
+        || trees_.storage() != source.trees_.storage())
+    {
+        trees_ = KHopTrees(source.numNodes_, source.trees_.storage());
+        treeSize_.assign(source.numNodes_, 0);
+        treeSizeSum_ = 0;
+    }
+
+    numNodes_ = source.numNodes_;
+    kHops_ = source.kHops_;
+    numToRemove_ = source.numToRemove_;
+    nodeAge_ = source.nodeAge_;
+    topology_ = source.topology_;
+    nodeFlags_ = source.nodeFlags_;
+    rng_ = source.rng_;
+    numThreads_ = source.numThreads_;
+
+    removedNodes_.clear();
+    removedNodes_.reserve(std::max(numToRemove_, 0));
+    updateGraphByRemovedNodes(nodesToRemove);
+}
+
 void DCNP_Graph::setNodeAge(Node node, Age age)
 {
     nodeAge_[node] = age;
@@ -416,10 +701,10 @@ void DCNP_Graph::setNodeAge(Node node, Age age)
 
 bool DCNP_Graph::isNodeRemoved(Node node) const
 {
-    return removedNodes_.count(node) > 0;
+    return nodeFlags_[node] & NODE_REMOVED;
 }
 
-const NodeSet& DCNP_Graph::getRemovedNodes() const
+const Solution &DCNP_Graph::getRemovedNodes() const
 {
     return removedNodes_;
 }
@@ -429,7 +714,7 @@ int DCNP_Graph::getNumNodes() const
     return numNodes_;
 }
 
-int DCNP_Graph::getObjectiveValue() const
+ObjValue DCNP_Graph::getObjectiveValue() const
 {
     return calculateKhopTreeSize();
 }
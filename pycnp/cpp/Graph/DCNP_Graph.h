@@ -2,14 +2,14 @@
 #define DCNP_GRAPH_H
 
 #include "../RandomNumberGenerator.h"
+#include "CSRGraph.h"
+#include "KHopTrees.h"
+#include "Solution.h"
 #include "Types.h"
 #include <algorithm>
 #include <cstdint>
-#include <list>
 #include <memory>
 #include <numeric>
-#include <queue>
-#include <stack>
 #include <stdexcept>
 #include <string>
 #include <unordered_set>
@@ -26,66 +26,140 @@
 class DCNP_Graph
 {
 private:
-    int numNodes_;
-    int kHops_;        ///< K-hop limit.
-    int numToRemove_;
-    NodeSet originalNodesSet_;  ///< Set storing all original nodes.
-    NodeSet initialNodesSet_;   ///< Immutable snapshot of the original node set.
+    int numNodes_ = 0;
+    int kHops_ = 0;        ///< K-hop limit.
+    int numToRemove_ = 0;
     std::vector<Age> nodeAge_;  ///< Stores the "age" of each node.
 
-    std::vector<NodeSet> currentAdjList_;   ///< Current adjacency list.
-    std::vector<NodeSet> originalAdjList_;  ///< Original adjacency list.
-    std::vector<NodeSet> initialAdjList_;   ///< Immutable snapshot of the original adjacency list.
+    std::shared_ptr<const CSRGraph> topology_;  ///< Shared original adjacency.
+    std::vector<NodeFlags> nodeFlags_;  ///< Removed / excluded state per node.
 
     /**
-     * K-hop tree adjacency information (flattened).
-     * `(v, u)` at `v * numNodes + u` is 1 if u is in v's K-hop tree, else 0.
+     * K-hop tree membership of every root.
+     * `u` is in the tree of `v` if it is within K hops of `v`.
      */
-    std::vector<uint8_t> intree_;
+    KHopTrees trees_;
 
     /**
      * K-hop tree sizes for each node.
      * `treeSize[v]` is total nodes reachable from `v` within K hops.
      */
     std::vector<int> treeSize_;
-    NodeSet removedNodes_;  ///< Nodes currently removed.
+    int64_t treeSizeSum_ = 0;  ///< Sum of ``treeSize_``, twice the objective.
+    Solution removedNodes_;  ///< Nodes currently removed.
 
     mutable RandomNumberGenerator rng_;
-    int initialSeed_ = 0;
-    int initialNumToRemove_ = 0;
-    int initialKHops_ = 0;
-    mutable std::vector<uint8_t> bfsVisited_;
-    mutable std::vector<int> bfsLevel_;
-    mutable std::vector<Node> bfsQueue_;
+    int numThreads_ = 1;  ///< Threads used to rebuild K-hop trees.
+
+    /// Scratch buffers of one K-hop BFS; visits are stamped, not cleared.
+    struct BfsScratch
+    {
+        std::vector<uint32_t> visitEpoch;
+        uint32_t epoch = 0;
+        std::vector<int> level;
+        std::vector<Node> queue;
+        std::vector<Node> roots;  ///< Trees to re-count in a what-if move
+        int64_t sizeDelta = 0;    ///< Change of tree sizes built with this
+    };
+
+    /// Traversal buffers of one Brandes source; reset after every source.
+    struct BrandesScratch
+    {
+        std::vector<int> distance;  ///< Hops from the source, -1 if unseen
+        std::vector<double> sigma;  ///< Shortest path counts
+        std::vector<double> dependency;
+        std::vector<Node> order;  ///< Nodes in BFS order
+    };
+
+    /**
+     * Scratch buffers for the K-hop BFS, one set per parallel chunk.
+     *
+     * Copies of a graph start with an empty workspace that is sized on first
+     * use, rather than duplicating buffers that hold no graph state.
+     */
+    struct Workspace
+    {
+        std::vector<BfsScratch> bfs;
+        std::vector<Node> affectedRoots;  ///< Trees to rebuild after a move
+        std::vector<Node> candidates;     ///< Nodes evaluated by a search
+        std::vector<int64_t> deltas;      ///< Objective delta per candidate
+        std::vector<Node> bestCandidates;  ///< Ties for the best delta
+        std::vector<BrandesScratch> brandes;  ///< One per betweenness worker
+        std::vector<std::vector<double>> betweennessBlocks;  ///< Block sums
+        std::vector<Node> sources;  ///< Betweenness sources
+
+        Workspace() = default;
+        Workspace(const Workspace &) {}
+        Workspace &operator=(const Workspace &) { return *this; }
+    };
+
+    mutable Workspace workspace_;
+
+    // Returns whether a node takes part in traversals (not removed/excluded).
+    bool isNodeActive(Node node) const { return nodeFlags_[node] == NODE_ACTIVE; }
+
+    // Runs a K-hop BFS from ``root`` as if ``blocked`` were removed and
+    // ``unblocked`` were active, leaving the tree in ``scratch.queue``.
+    // Returns its size, the root included.
+    size_t kHopBfs(Node root,
+                   Node blocked,
+                   Node unblocked,
+                   BfsScratch &scratch) const;
+
+    // Twice the objective change of removing / adding ``node``.
+    int64_t removalDelta(Node node, BfsScratch &scratch) const;
+    int64_t additionDelta(Node node, BfsScratch &scratch) const;
+
+    // Evaluates ``delta`` for every node of ``workspace_.candidates`` into
+    // ``workspace_.deltas``, in parallel when there are enough.
+    template <typename Delta> void evaluateCandidates(Delta &&delta) const;
+
+    // Adds the dependencies of ``source`` (up to ``maxDepth`` hops, or all
+    // when zero) to ``score``, leaving ``scratch`` reset.
+    void accumulateBetweenness(Node source,
+                               int maxDepth,
+                               BrandesScratch &scratch,
+                               std::vector<double> &score) const;
 
     // Helper: Builds K-hop tree for node v using BFS.
     void bfsKTree(Node v);
 
+    // Builds the K-hop tree of ``v`` using the given scratch buffers.
+    void bfsKTree(Node v, BfsScratch &scratch);
+
+    // Rebuilds the trees of ``roots``, in parallel when there are enough.
+    void rebuildTrees(const std::vector<Node> &roots, int numThreads);
+
+    // Copies the shared topology and the per-node state of ``other`` without
+    // its K-hop trees, then applies ``nodesToRemove``.
+    DCNP_Graph(const DCNP_Graph &other, const Solution &nodesToRemove);
+
 public:
-    DCNP_Graph(NodeSet nodes,
+    DCNP_Graph(const NodeSet &nodes,
                int K,
-               std::vector<NodeSet> adjList,
+               std::shared_ptr<const CSRGraph> topology,
                int numToRemove,
-               int seed);
+               int seed,
+               TreeStorage storage = TreeStorage::Auto);
 
-    DCNP_Graph() = default;
+    DCNP_Graph() : topology_(std::make_shared<const CSRGraph>()) {}
 
     /**
      * Updates the graph to reflect node removals for DCNP.
      *
      * Parameters
      * ----------
-     * nodesToRemove : NodeSet
+     * nodesToRemove : Solution
      *     Set of nodes that have been removed.
      */
-    void updateGraphByRemovedNodes(const NodeSet &nodesToRemove);
+    void updateGraphByRemovedNodes(const Solution &nodesToRemove);
 
     /**
      * Creates a reduced graph after node removal for DCNP.
      *
      * Parameters
      * ----------
-     * nodesToRemove : NodeSet
+     * nodesToRemove : Solution
      *     Set of nodes to remove.
      *
      * Returns
@@ -93,7 +167,7 @@ public:
      * DCNP_Graph
      *     The reduced graph.
      */
-    void getReducedGraphByRemovedNodes(const NodeSet &nodesToRemove);
+    void getReducedGraphByRemovedNodes(const Solution &nodesToRemove);
 
     /**
      * Removes a node from the DCNP graph.
@@ -147,10 +221,10 @@ public:
      *
      * Returns
      * -------
-     * NodeSet
+     * Solution
      *     Set of nodes that have been removed.
      */
-    const NodeSet& getRemovedNodes() const;
+    const Solution &getRemovedNodes() const;
 
     /**
      * Returns the total number of nodes in the DCNP graph.
@@ -170,24 +244,92 @@ public:
      * int
      *     The pairwise distance after node removal.
      */
-    int getObjectiveValue() const;
+    ObjValue getObjectiveValue() const;
 
     // Generate a random feasible solution.
     std::unique_ptr<DCNP_Graph> getRandomFeasibleGraph() const;
 
+    /// Generator of the random feasible graphs and random selections.
+    RandomNumberGenerator &generator() const noexcept { return rng_; }
+
     // Build/rebuild K-hop tree info for all unremoved nodes.
     void buildTree();
 
+    /**
+     * Sets the number of threads used to rebuild K-hop trees.
+     *
+     * Applies to full rebuilds and to the trees affected by a node removal
+     * or insertion. Clones inherit the setting.
+     *
+     * Parameters
+     * ----------
+     * numThreads : int
+     *     Thread count; values below one use all hardware threads.
+     */
+    void setNumThreads(int numThreads);
+
     // Calculate sum of K-hop tree sizes.
-    int calculateKhopTreeSize() const;
+    ObjValue calculateKhopTreeSize() const;
 
-    // Calculate betweenness centrality for active nodes.
-    const std::vector<double> &calculateBetweennessCentrality() const;
+    /**
+     * Returns how much removing ``node`` would lower the objective, without
+     * modifying the graph.
+     *
+     * Parameters
+     * ----------
+     * node : Node
+     *     A node that is not removed.
+     *
+     * Returns
+     * -------
+     * ObjValue
+     *     Objective value now minus the value after the removal.
+     */
+    ObjValue removalGain(Node node) const;
 
-    // Find best node to remove (heuristic).
+    /**
+     * Returns how much adding ``node`` back would raise the objective,
+     * without modifying the graph.
+     *
+     * Parameters
+     * ----------
+     * node : Node
+     *     A removed node.
+     *
+     * Returns
+     * -------
+     * ObjValue
+     *     Objective value after the insertion minus the value now.
+     */
+    ObjValue additionCost(Node node) const;
+
+    /**
+     * Calculates the betweenness centrality of the active nodes.
+     *
+     * Sources are processed in parallel, using the threads set by
+     * setNumThreads; the result does not depend on the thread count.
+     *
+     * Parameters
+     * ----------
+     * maxDepth : int
+     *     Only count shortest paths of at most this many hops. Zero (the
+     *     default) counts all of them.
+     * numPivots : int
+     *     Only use this many random sources, and scale the result to all
+     *     active nodes. Zero (the default) uses every active node.
+     *
+     * Returns
+     * -------
+     * list[float]
+     *     Centrality per node; zero for removed and excluded nodes.
+     */
+    std::vector<double> calculateBetweennessCentrality(int maxDepth = 0,
+                                                       int numPivots = 0) const;
+
+    // Find best node to remove (heuristic), evaluated without mutation.
     Node findBestNodeToRemove();
 
-    // Find best node to add back (heuristic).
+    // Find best node to add back (heuristic), evaluated without mutation.
     Node findBestNodeToAdd();
 
     // Randomly select a node to remove.
@@ -195,6 +337,16 @@ public:
 
     // Create a deep copy.
     std::unique_ptr<DCNP_Graph> clone() const;
+
+    // Create a graph over the same topology with the given removal set,
+    // without copying K-hop trees that would be rebuilt anyway.
+    std::unique_ptr<DCNP_Graph>
+    cloneWithRemovedNodes(const Solution &nodesToRemove) const;
+
+    // Turn this graph into source.cloneWithRemovedNodes(nodesToRemove),
+    // keeping its K-hop tree storage and workspace.
+    void assignWithRemovedNodes(const DCNP_Graph &source,
+                                const Solution &nodesToRemove);
 };
 
 #endif  // DCNP_GRAPH_H
@@ -1,9 +1,5 @@
 #include "Graph.h"
 
-namespace {
-    const std::vector<double> EMPTY_DOUBLE_VEC;
-}
-
 Graph::Graph(std::unique_ptr<CNP_Graph> cnp)
     : impl(std::move(cnp)), kind_(Kind::CNP)
 {
@@ -36,6 +32,8 @@ Graph &Graph::operator=(const Graph &other)
                 return std::make_unique<typename T::element_type>(*ptr);
             },
             other.impl);
+        logging_ = false;
+        moveLog_.clear();
     }
     return *this;
 }
@@ -45,14 +43,50 @@ std::unique_ptr<Graph> Graph::clone() const
     return std::make_unique<Graph>(*this);
 }
 
-void Graph::updateGraphByRemovedNodes(const NodeSet &nodesToRemove)
+std::unique_ptr<Graph> Graph::cloneWithRemovedNodes(const Solution &nodesToRemove) const
+{
+    return std::visit(
+        [&](const auto &ptr) {
+            auto cloned = ptr->cloneWithRemovedNodes(nodesToRemove);
+            return std::make_unique<Graph>(std::move(cloned));
+        },
+        impl);
+}
+
+void Graph::assignWithRemovedNodes(const Graph &source,
+                                   const Solution &nodesToRemove)
+{
+    logging_ = false;
+    moveLog_.clear();
+
+    if (kind_ == source.kind_)
+    {
+        std::visit(
+            [&](auto &ptr) {
+                using T = std::decay_t<decltype(ptr)>;
+                ptr->assignWithRemovedNodes(*std::get<T>(source.impl),
+                                            nodesToRemove);
+            },
+            impl);
+        return;
+    }
+
+    kind_ = source.kind_;
+    impl = std::visit(
+        [&](const auto &ptr) -> std::variant<std::unique_ptr<CNP_Graph>, std::unique_ptr<DCNP_Graph>> {
+            return ptr->cloneWithRemovedNodes(nodesToRemove);
+        },
+        source.impl);
+}
+
+void Graph::updateGraphByRemovedNodes(const Solution &nodesToRemove)
 {
     std::visit(
         [&](auto &ptr) { ptr->updateGraphByRemovedNodes(nodesToRemove); },
         impl);
 }
 
-void Graph::getReducedGraphByRemovedNodes(const NodeSet &nodesToRemove)
+void Graph::getReducedGraphByRemovedNodes(const Solution &nodesToRemove)
 {
     std::visit(
         [&](auto &ptr) { ptr->getReducedGraphByRemovedNodes(nodesToRemove); },
@@ -62,11 +96,52 @@ void Graph::getReducedGraphByRemovedNodes(const NodeSet &nodesToRemove)
 void Graph::removeNode(Node node)
 {
     std::visit([&](auto &ptr) { ptr->removeNode(node); }, impl);
+    if (logging_)
+    {
+        moveLog_.push_back({node, true});
+    }
 }
 
 void Graph::addNode(Node node)
 {
     std::visit([&](auto &ptr) { ptr->addNode(node); }, impl);
+    if (logging_)
+    {
+        moveLog_.push_back({node, false});
+    }
+}
+
+void Graph::checkpoint()
+{
+    logging_ = true;
+    moveLog_.clear();
+}
+
+void Graph::commit()
+{
+    logging_ = false;
+    moveLog_.clear();
+}
+
+void Graph::rollback()
+{
+    std::visit(
+        [&](auto &ptr)
+        {
+            for (auto it = moveLog_.rbegin(); it != moveLog_.rend(); ++it)
+            {
+                if (it->removed)
+                {
+                    ptr->addNode(it->node);
+                }
+                else
+                {
+                    ptr->removeNode(it->node);
+                }
+            }
+        },
+        impl);
+    commit();
 }
 
 void Graph::setNodeAge(Node node, Age age)
@@ -74,7 +149,7 @@ void Graph::setNodeAge(Node node, Age age)
     std::visit([&](auto &ptr) { ptr->setNodeAge(node, age); }, impl);
 }
 
-int Graph::getObjectiveValue() const
+ObjValue Graph::getObjectiveValue() const
 {
     return std::visit([](const auto &ptr) { return ptr->getObjectiveValue(); }, impl);
 }
@@ -89,14 +164,21 @@ std::unique_ptr<Graph> Graph::getRandomFeasibleGraph() const
         impl);
 }
 
+RandomNumberGenerator &Graph::generator() const
+{
+    return std::visit(
+        [](const auto &ptr) -> RandomNumberGenerator & { return ptr->generator(); },
+        impl);
+}
+
 bool Graph::isNodeRemoved(Node node) const
 {
     return std::visit([&](const auto &ptr) { return ptr->isNodeRemoved(node); }, impl);
 }
 
-const NodeSet &Graph::getRemovedNodes() const
+const Solution &Graph::getRemovedNodes() const
 {
-    return std::visit([](const auto &ptr) -> const NodeSet & { return ptr->getRemovedNodes(); }, impl);
+    return std::visit([](const auto &ptr) -> const Solution & { return ptr->getRemovedNodes(); }, impl);
 }
 
 int Graph::getNumNodes() const
@@ -155,7 +237,7 @@ Node Graph::randomSelectNodeToRemove() const
     return std::visit([&](const auto &ptr) { return ptr->randomSelectNodeToRemove(); }, impl);
 }
 
-int Graph::calculateConnectionGain(Node node) const
+ObjValue Graph::calculateConnectionGain(Node node) const
 {
     if (isDCNP())
     {
@@ -164,6 +246,14 @@ int Graph::calculateConnectionGain(Node node) const
     return std::get<std::unique_ptr<CNP_Graph>>(impl)->calculateConnectionGain(node);
 }
 
+void Graph::setNumThreads(int numThreads)
+{
+    if (isDCNP())
+    {
+        std::get<std::unique_ptr<DCNP_Graph>>(impl)->setNumThreads(numThreads);
+    }
+}
+
 void Graph::buildTree()
 {
     if (isDCNP())
@@ -181,13 +271,15 @@ int Graph::calculateKhopTreeSize() const
     return 0;
 }
 
-const std::vector<double> &Graph::calculateBetweennessCentrality() const
+std::vector<double> Graph::calculateBetweennessCentrality(int maxDepth,
+                                                          int numPivots) const
 {
     if (isDCNP())
     {
-        return std::get<std::unique_ptr<DCNP_Graph>>(impl)->calculateBetweennessCentrality();
+        return std::get<std::unique_ptr<DCNP_Graph>>(impl)->calculateBetweennessCentrality(
+            maxDepth, numPivots);
     }
-    return EMPTY_DOUBLE_VEC;
+    return {};
 }
 
 Node Graph::findBestNodeToRemove()
@@ -37,16 +37,57 @@ public:
     bool isDCNP() const noexcept { return kind_ == Kind::DCNP; }
 
     std::unique_ptr<Graph> clone() const;
+    std::unique_ptr<Graph> cloneWithRemovedNodes(const Solution &nodesToRemove) const;
 
-    void updateGraphByRemovedNodes(const NodeSet &nodesToRemove);
-    void getReducedGraphByRemovedNodes(const NodeSet &nodesToRemove);
+    /**
+     * Turns this graph into ``source.cloneWithRemovedNodes(nodesToRemove)``.
+     *
+     * When both graphs are of the same problem, the buffers, workspace and
+     * caches of this graph are reused, so an offspring slot rebuilt every
+     * generation stops allocating once it has grown. An open checkpoint is
+     * discarded.
+     */
+    void assignWithRemovedNodes(const Graph &source, const Solution &nodesToRemove);
+
+    void updateGraphByRemovedNodes(const Solution &nodesToRemove);
+    void getReducedGraphByRemovedNodes(const Solution &nodesToRemove);
     void removeNode(Node node);
     void addNode(Node node);
     void setNodeAge(Node node, Age age);
-    int getObjectiveValue() const;
+    ObjValue getObjectiveValue() const;
+
+    /**
+     * Starts a move that can be undone with rollback().
+     *
+     * Node removals and additions made through removeNode and addNode until
+     * commit() or rollback() are logged. A new checkpoint discards the log
+     * of the previous one.
+     */
+    void checkpoint();
+
+    /**
+     * Keeps the removals and additions since checkpoint() and ends it.
+     */
+    void commit();
+
+    /**
+     * Undoes the removals and additions since checkpoint() and ends it.
+     *
+     * The logged moves are inverted newest first, so a rollback costs about
+     * what the moves cost, and the incrementally maintained components and
+     * selection caches stay valid, unlike a rebuild through
+     * updateGraphByRemovedNodes. The removed set and objective value return
+     * to their state at the checkpoint; component indices and node ages may
+     * differ.
+     */
+    void rollback();
     std::unique_ptr<Graph> getRandomFeasibleGraph() const;
+
+    /// Generator of the random feasible graphs; checkpoints save its state.
+    RandomNumberGenerator &generator() const;
+
     bool isNodeRemoved(Node node) const;
-    const NodeSet &getRemovedNodes() const;
+    const Solution &getRemovedNodes() const;
     int getNumNodes() const;
 
     // CNP-oriented helpers
@@ -56,12 +97,14 @@ public:
     Node ageSelectNodeFromComponent(ComponentIndex componentIndex) const;
     Node greedySelectNodeToAdd() const;
     Node randomSelectNodeToRemove() const;
-    int calculateConnectionGain(Node node) const;
+    ObjValue calculateConnectionGain(Node node) const;
 
     // DCNP-oriented helpers
     void buildTree();
+    void setNumThreads(int numThreads);
     int calculateKhopTreeSize() const;
-    const std::vector<double> &calculateBetweennessCentrality() const;
+    std::vector<double> calculateBetweennessCentrality(int maxDepth = 0,
+                                                       int numPivots = 0) const;
     Node findBestNodeToRemove();
     Node findBestNodeToAdd();
 
@@ -73,6 +116,16 @@ public:
 private:
     std::variant<std::unique_ptr<CNP_Graph>, std::unique_ptr<DCNP_Graph>> impl;
     Kind kind_;
+
+    /// A logged move: the node, and whether it was removed or added.
+    struct LoggedMove
+    {
+        Node node;
+        bool removed;
+    };
+
+    bool logging_ = false;               ///< Whether a checkpoint is open
+    std::vector<LoggedMove> moveLog_;    ///< Moves since the checkpoint
 };
 
 #endif  // GRAPH_H
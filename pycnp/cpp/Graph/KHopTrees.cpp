@@ -0,0 +1,166 @@
+#include "KHopTrees.h"
+#include "BitKernels.h"
+#include <algorithm>
+#include <stdexcept>
+
+TreeStorage parseTreeStorage(const std::string &name)
+{
+    if (name == "auto")
+        return TreeStorage::Auto;
+    if (name == "dense")
+        return TreeStorage::Dense;
+    if (name == "bitset")
+        return TreeStorage::Bitset;
+    if (name == "sparse")
+        return TreeStorage::Sparse;
+
+    throw std::invalid_argument("Unknown tree storage: " + name);
+}
+
+KHopTrees::KHopTrees(size_t numNodes, TreeStorage storage)
+    : numNodes_(numNodes), wordsPerRow_((numNodes + WORD_BITS - 1) / WORD_BITS)
+{
+    storage_ = storage == TreeStorage::Auto ? TreeStorage::Sparse : storage;
+
+    switch (storage_)
+    {
+        case TreeStorage::Dense:
+            dense_.assign(numNodes_ * numNodes_, 0);
+            break;
+        case TreeStorage::Bitset:
+            bits_.assign(numNodes_ * wordsPerRow_, 0);
+            break;
+        default:
+            sparse_.resize(numNodes_);
+            break;
+    }
+}
+
+TreeStorage KHopTrees::autoStorage(size_t numNodes, size_t numMembers) noexcept
+{
+    const size_t sparseBytes
+        = numNodes * sizeof(std::vector<Node>) + numMembers * sizeof(Node);
+    const size_t wordsPerRow = (numNodes + WORD_BITS - 1) / WORD_BITS;
+    const size_t bitsetBytes = numNodes * wordsPerRow * sizeof(Word);
+    return sparseBytes <= bitsetBytes ? TreeStorage::Sparse : TreeStorage::Bitset;
+}
+
+void KHopTrees::setStorage(TreeStorage storage)
+{
+    if (storage == TreeStorage::Auto)
+    {
+        size_t numMembers = 0;
+        for (size_t root = 0; root < numNodes_; ++root)
+        {
+            numMembers += memberCount(static_cast<Node>(root));
+        }
+        storage = autoStorage(numNodes_, numMembers);
+    }
+
+    if (storage == storage_)
+    {
+        return;
+    }
+
+    KHopTrees converted(numNodes_, storage);
+    std::vector<Node> members;
+    for (size_t root = 0; root < numNodes_; ++root)
+    {
+        members.clear();
+        forEachMember(static_cast<Node>(root),
+                      [&](Node node) { members.push_back(node); });
+        converted.assign(static_cast<Node>(root), members);
+    }
+
+    *this = std::move(converted);
+}
+
+void KHopTrees::clearRow(Node root)
+{
+    const size_t row = static_cast<size_t>(root);
+    switch (storage_)
+    {
+        case TreeStorage::Dense:
+            std::fill_n(dense_.begin() + row * numNodes_, numNodes_, 0);
+            break;
+        case TreeStorage::Bitset:
+            std::fill_n(bits_.begin() + row * wordsPerRow_, wordsPerRow_, 0);
+            break;
+        default:
+            sparse_[row].clear();
+            break;
+    }
+}
+
+void KHopTrees::assign(Node root, std::span<const Node> members)
+{
+    clearRow(root);
+
+    const size_t row = static_cast<size_t>(root);
+    switch (storage_)
+    {
+        case TreeStorage::Dense:
+            for (Node node : members)
+            {
+                dense_[row * numNodes_ + node] = 1;
+            }
+            break;
+        case TreeStorage::Bitset:
+            for (Node node : members)
+            {
+                bits_[row * wordsPerRow_ + node / WORD_BITS]
+                    |= Word{1} << (node % WORD_BITS);
+            }
+            break;
+        default:
+            sparse_[row].assign(members.begin(), members.end());
+            break;
+    }
+}
+
+bool KHopTrees::contains(Node root, Node node) const
+{
+    const size_t row = static_cast<size_t>(root);
+    switch (storage_)
+    {
+        case TreeStorage::Dense:
+            return dense_[row * numNodes_ + node] != 0;
+        case TreeStorage::Bitset:
+            return (bits_[row * wordsPerRow_ + node / WORD_BITS]
+                    >> (node % WORD_BITS))
+                   & 1;
+        default:
+            return std::find(sparse_[row].begin(), sparse_[row].end(), node)
+                   != sparse_[row].end();
+    }
+}
+
+size_t KHopTrees::memberCount(Node root) const
+{
+    const size_t row = static_cast<size_t>(root);
+    switch (storage_)
+    {
+        case TreeStorage::Dense:
+        {
+            const auto first = dense_.begin() + row * numNodes_;
+            return numNodes_ - std::count(first, first + numNodes_, 0);
+        }
+        case TreeStorage::Bitset:
+            return BitKernels::popcount(bits_.data() + row * wordsPerRow_,
+                                        wordsPerRow_);
+        default:
+            return sparse_[row].size();
+    }
+}
+
+size_t KHopTrees::memoryUsage() const noexcept
+{
+    size_t bytes = dense_.capacity() * sizeof(uint8_t)
+                   + bits_.capacity() * sizeof(Word)
+                   + sparse_.capacity() * sizeof(std::vector<Node>);
+    for (const auto &members : sparse_)
+    {
+        bytes += members.capacity() * sizeof(Node);
+    }
+    return bytes;
+}
@@ -0,0 +1,182 @@
+#ifndef KHOP_TREES_H
+#define KHOP_TREES_H
+
+#include "Types.h"
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+/**
+ * Storage layouts for the K-hop trees of a DCNP graph.
+ *
+ * ``Dense`` keeps one byte per (root, node) pair, ``Bitset`` one bit per pair
+ * with rows scanned a word at a time, and ``Sparse`` only the member list of
+ * each tree. ``Auto`` picks ``Sparse`` or ``Bitset``, whichever is smaller
+ * once the trees of the unreduced graph are known.
+ */
+enum class TreeStorage
+{
+    Auto,
+    Dense,
+    Bitset,
+    Sparse
+};
+
+/**
+ * Parses a tree storage name.
+ *
+ * Parameters
+ * ----------
+ * name : str
+ *     One of ``"auto"``, ``"dense"``, ``"bitset"`` or ``"sparse"``.
+ *
+ * Returns
+ * -------
+ * TreeStorage
+ *     The matching storage layout.
+ *
+ * Raises
+ * ------
+ * ValueError
+ *     When the name is not recognised.
+ */
+TreeStorage parseTreeStorage(const std::string &name);
+
+/**
+ * KHopTrees
+ *
+ * Membership of the K-hop trees of all roots of a graph.
+ *
+ * The graphs are undirected, so a node ``u`` is in the tree of ``v`` exactly
+ * when ``v`` is in the tree of ``u``. The member list of a node therefore
+ * doubles as the reverse index of the roots whose trees contain it, which is
+ * what node removal and insertion need to find the trees to rebuild.
+ */
+class KHopTrees
+{
+private:
+    using Word = uint64_t;
+    static constexpr size_t WORD_BITS = 64;
+
+    size_t numNodes_ = 0;
+    size_t wordsPerRow_ = 0;
+    TreeStorage storage_ = TreeStorage::Sparse;
+
+    std::vector<uint8_t> dense_;              ///< Dense mode rows
+    std::vector<Word> bits_;                  ///< Bitset mode rows
+    std::vector<std::vector<Node>> sparse_;  ///< Sparse mode member lists
+
+    void clearRow(Node root);
+
+public:
+    KHopTrees() = default;
+
+    /**
+     * Creates empty trees for ``numNodes`` roots.
+     *
+     * Parameters
+     * ----------
+     * numNodes : int
+     *     Number of roots (and candidate members).
+     * storage : TreeStorage
+     *     Storage layout. ``Auto`` starts out sparse.
+     */
+    KHopTrees(size_t numNodes, TreeStorage storage);
+
+    /// Returns the active storage layout (never ``Auto``).
+    TreeStorage storage() const noexcept { return storage_; }
+
+    /**
+     * Converts the trees to another storage layout, keeping their contents.
+     *
+     * Parameters
+     * ----------
+     * storage : TreeStorage
+     *     The new layout. ``Auto`` keeps the smaller of sparse and bitset.
+     */
+    void setStorage(TreeStorage storage);
+
+    /**
+     * Returns the layout ``Auto`` settles on for the given trees.
+     *
+     * Parameters
+     * ----------
+     * numNodes : int
+     *     Number of roots.
+     * numMembers : int
+     *     Total number of members over all trees, the roots included.
+     *
+     * Returns
+     * -------
+     * TreeStorage
+     *     ``Sparse`` or ``Bitset``, whichever needs fewer bytes.
+     */
+    static TreeStorage autoStorage(size_t numNodes, size_t numMembers) noexcept;
+
+    /**
+     * Replaces the tree of ``root`` by the given members.
+     *
+     * Parameters
+     * ----------
+     * root : Node
+     *     The tree root.
+     * members : list[int]
+     *     Distinct members of the tree, the root included.
+     */
+    void assign(Node root, std::span<const Node> members);
+
+    /// Returns whether ``node`` is in the tree of ``root``.
+    bool contains(Node root, Node node) const;
+
+    /// Returns the number of members of the tree of ``root``.
+    size_t memberCount(Node root) const;
+
+    /// Returns the number of bytes held by the tree storage.
+    size_t memoryUsage() const noexcept;
+
+    /// Calls ``fn(node)`` for every member of the tree of ``root``.
+    template <typename Fn> void forEachMember(Node root, Fn &&fn) const;
+};
+
+template <typename Fn> void KHopTrees::forEachMember(Node root, Fn &&fn) const
+{
+    switch (storage_)
+    {
+        case TreeStorage::Dense:
+        {
+            const uint8_t *row = dense_.data() + static_cast<size_t>(root) * numNodes_;
+            for (size_t node = 0; node < numNodes_; ++node)
+            {
+                if (row[node])
+                {
+                    fn(static_cast<Node>(node));
+                }
+            }
+            break;
+        }
+        case TreeStorage::Bitset:
+        {
+            const Word *row = bits_.data() + static_cast<size_t>(root) * wordsPerRow_;
+            for (size_t word = 0; word < wordsPerRow_; ++word)
+            {
+                for (Word bits = row[word]; bits != 0; bits &= bits - 1)
+                {
+                    fn(static_cast<Node>(word * WORD_BITS
+                                         + std::countr_zero(bits)));
+                }
+            }
+            break;
+        }
+        default:
+            for (Node node : sparse_[root])
+            {
+                fn(node);
+            }
+            break;
+    }
+}
+
+#endif  // KHOP_TREES_H
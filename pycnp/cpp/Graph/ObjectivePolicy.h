@@ -0,0 +1,150 @@
+#ifndef OBJECTIVE_POLICY_H
+#define OBJECTIVE_POLICY_H
+
+#include "Types.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+/**
+ * Objective of a CNP graph, fixed when the graph is created.
+ *
+ * All objectives are minimised and are aggregates of a cost per connected
+ * component, computed from the component's weight (sum of node weights)
+ * and squared weight (sum of squared node weights).
+ */
+enum class ObjectiveKind
+{
+    Pairwise,          ///< "CNP": pairs of connected nodes
+    WeightedPairwise,  ///< "WCNP": sum of w_i w_j over connected pairs
+    LargestComponent,  ///< "MINMAXC": weight of the largest component
+    ComponentCount,    ///< "MAXNUM": nodes minus components
+};
+
+/// Pairwise connectivity. Node weights count as node multiplicities, which
+/// is how a kernel folds leaves into their neighbour.
+struct PairwiseConnectivity
+{
+    static constexpr bool additive = true;
+    static constexpr bool usesSquaredWeight = false;
+
+    static ObjValue cost(int64_t weight, int64_t)
+    {
+        return weight * (weight - 1) / 2;
+    }
+};
+
+/// Node-weighted pairwise connectivity: a connected pair (i, j) costs
+/// w_i w_j.
+struct WeightedConnectivity
+{
+    static constexpr bool additive = true;
+    static constexpr bool usesSquaredWeight = true;
+
+    static ObjValue cost(int64_t weight, int64_t squaredWeight)
+    {
+        return (weight * weight - squaredWeight) / 2;
+    }
+};
+
+/// Weight of the largest component. Not additive: the aggregate is the
+/// maximum over the components.
+struct LargestComponent
+{
+    static constexpr bool additive = false;
+    static constexpr bool usesSquaredWeight = false;
+
+    static ObjValue cost(int64_t weight, int64_t) { return weight; }
+};
+
+/// Number of components, maximised. Each component costs -1 on top of the
+/// number of graph nodes, so the minimised objective stays non-negative.
+struct ComponentCount
+{
+    static constexpr bool additive = true;
+    static constexpr bool usesSquaredWeight = false;
+
+    static ObjValue cost(int64_t weight, int64_t) { return weight > 0 ? -1 : 0; }
+};
+
+/// Aggregates two component costs of ``Policy``.
+template <class Policy>
+constexpr ObjValue combineCosts(ObjValue lhs, ObjValue rhs)
+{
+    if constexpr (Policy::additive)
+    {
+        return lhs + rhs;
+    }
+    else
+    {
+        return std::max(lhs, rhs);
+    }
+}
+
+/**
+ * Calls ``fn`` with a value of the policy type of ``kind``.
+ *
+ * Kernels that loop over nodes or components are templates on the policy,
+ * so the dispatch happens once per call and the loops are specialised.
+ */
+template <class Fn>
+decltype(auto) visitObjective(ObjectiveKind kind, Fn &&fn)
+{
+    switch (kind)
+    {
+    case ObjectiveKind::WeightedPairwise:
+        return fn(WeightedConnectivity{});
+    case ObjectiveKind::LargestComponent:
+        return fn(LargestComponent{});
+    case ObjectiveKind::ComponentCount:
+        return fn(ComponentCount{});
+    case ObjectiveKind::Pairwise:
+    default:
+        return fn(PairwiseConnectivity{});
+    }
+}
+
+/**
+ * Returns the objective of a CNP problem type.
+ *
+ * Parameters
+ * ----------
+ * problemType
+ *     "CNP", "WCNP", "MINMAXC" or "MAXNUM".
+ *
+ * Raises
+ * ------
+ * std::invalid_argument
+ *     If ``problemType`` is not a CNP variant.
+ */
+inline ObjectiveKind objectiveKindOf(const std::string &problemType)
+{
+    if (problemType == "CNP")
+    {
+        return ObjectiveKind::Pairwise;
+    }
+    if (problemType == "WCNP")
+    {
+        return ObjectiveKind::WeightedPairwise;
+    }
+    if (problemType == "MINMAXC")
+    {
+        return ObjectiveKind::LargestComponent;
+    }
+    if (problemType == "MAXNUM")
+    {
+        return ObjectiveKind::ComponentCount;
+    }
+    throw std::invalid_argument("Not a CNP problem type: " + problemType);
+}
+
+/// Whether ``problemType`` is a CNP variant, solved on a CNP_Graph.
+inline bool isCNPProblemType(const std::string &problemType)
+{
+    return problemType == "CNP" || problemType == "WCNP"
+           || problemType == "MINMAXC" || problemType == "MAXNUM";
+}
+
+#endif  // OBJECTIVE_POLICY_H
@@ -0,0 +1,251 @@
+#ifndef SOLUTION_H
+#define SOLUTION_H
+
+#include "BitKernels.h"
+#include "Types.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/**
+ * Solution
+ *
+ * Compact set of removed nodes.
+ *
+ * Membership is stored in a dense bitset indexed by node id, next to a small
+ * vector holding the member ids. Membership checks are a
+ * single bit test, iteration only touches the members, and copying costs one
+ * bit per node plus the members themselves, instead of the bucket-by-bucket
+ * copy of a hash set.
+ *
+ * The bitset grows on demand, so a default-constructed solution can hold any
+ * non-negative node id. Passing the number of nodes up front avoids the
+ * reallocations.
+ *
+ * A Zobrist-style fingerprint, the XOR of a fixed random key per member, is
+ * kept up to date on every change. It does not depend on the insertion
+ * order, so equal sets always share it and hash lookups of solutions are
+ * O(1).
+ */
+class Solution
+{
+private:
+    using Word = uint64_t;
+    static constexpr size_t WORD_BITS = 64;
+
+    std::vector<Word> bits_;   ///< Membership bitset
+    std::vector<Node> nodes_;  ///< Member ids, in no particular order
+    uint64_t fingerprint_ = 0;  ///< XOR of nodeKey over the members
+
+    // SplitMix64 finalizer: a well-mixed key per node id, no table needed.
+    static uint64_t nodeKey(Node node) noexcept
+    {
+        uint64_t key = static_cast<uint64_t>(node) + 0x9e3779b97f4a7c15ULL;
+        key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        key = (key ^ (key >> 27)) * 0x94d049bb133111ebULL;
+        return key ^ (key >> 31);
+    }
+
+    static size_t wordIndex(Node node) noexcept
+    {
+        return static_cast<size_t>(node) / WORD_BITS;
+    }
+
+    static Word bitMask(Node node) noexcept
+    {
+        return Word{1} << (static_cast<size_t>(node) % WORD_BITS);
+    }
+
+public:
+    using const_iterator = std::vector<Node>::const_iterator;
+
+    Solution() = default;
+
+    /**
+     * Creates an empty solution able to hold node ids smaller than
+     * ``numNodes`` without reallocating the bitset.
+     *
+     * Parameters
+     * ----------
+     * numNodes : int
+     *     Size of the node id universe.
+     */
+    explicit Solution(size_t numNodes)
+        : bits_((numNodes + WORD_BITS - 1) / WORD_BITS, 0)
+    {
+    }
+
+    /// Reserves room for ``count`` members.
+    void reserve(size_t count) { nodes_.reserve(count); }
+
+    /**
+     * Checks whether a node is part of the solution.
+     *
+     * Parameters
+     * ----------
+     * node : Node
+     *     The node to look up.
+     *
+     * Returns
+     * -------
+     * bool
+     *     True if the node is a member.
+     */
+    bool contains(Node node) const noexcept
+    {
+        const size_t word = wordIndex(node);
+        return word < bits_.size() && (bits_[word] & bitMask(node));
+    }
+
+    /// Returns 1 if the node is a member and 0 otherwise.
+    size_t count(Node node) const noexcept { return contains(node) ? 1 : 0; }
+
+    /**
+     * Adds a node to the solution.
+     *
+     * Parameters
+     * ----------
+     * node : Node
+     *     The node to add. Must be non-negative.
+     *
+     * Returns
+     * -------
+     * bool
+     *     True if the node was added, false if it was already a member.
+     */
+    bool insert(Node node)
+    {
+        const size_t word = wordIndex(node);
+        if (word >= bits_.size())
+        {
+            bits_.resize(word + 1, 0);
+        }
+        else if (bits_[word] & bitMask(node))
+        {
+            return false;
+        }
+
+        bits_[word] |= bitMask(node);
+        nodes_.push_back(node);
+        fingerprint_ ^= nodeKey(node);
+        return true;
+    }
+
+    /// Adds every node in ``[first, last)``.
+    template <typename It> void insert(It first, It last)
+    {
+        for (; first != last; ++first)
+        {
+            insert(*first);
+        }
+    }
+
+    /**
+     * Removes a node from the solution.
+     *
+     * The last member takes the freed slot. Locating the slot is linear in
+     * the number of members, which is bounded by the budget.
+     *
+     * Parameters
+     * ----------
+     * node : Node
+     *     The node to remove.
+     *
+     * Returns
+     * -------
+     * size_t
+     *     Number of removed members (0 or 1).
+     */
+    size_t erase(Node node)
+    {
+        if (!contains(node))
+        {
+            return 0;
+        }
+
+        bits_[wordIndex(node)] &= ~bitMask(node);
+        fingerprint_ ^= nodeKey(node);
+        auto it = std::find(nodes_.begin(), nodes_.end(), node);
+        *it = nodes_.back();
+        nodes_.pop_back();
+        return 1;
+    }
+
+    /// Removes all members, keeping the allocated capacity.
+    void clear() noexcept
+    {
+        for (Node node : nodes_)
+        {
+            bits_[wordIndex(node)] = 0;
+        }
+        nodes_.clear();
+        fingerprint_ = 0;
+    }
+
+    size_t size() const noexcept { return nodes_.size(); }
+    bool empty() const noexcept { return nodes_.empty(); }
+
+    const_iterator begin() const noexcept { return nodes_.begin(); }
+    const_iterator end() const noexcept { return nodes_.end(); }
+
+    /// Returns the member ids as a contiguous vector.
+    const std::vector<Node> &nodes() const noexcept { return nodes_; }
+
+    /// Returns the order-independent fingerprint of the member set.
+    uint64_t fingerprint() const noexcept { return fingerprint_; }
+
+    /**
+     * Counts the members shared with another solution.
+     *
+     * Parameters
+     * ----------
+     * other : Solution
+     *     The solution to intersect with.
+     *
+     * Returns
+     * -------
+     * size_t
+     *     Size of the intersection.
+     */
+    size_t intersectionSize(const Solution &other) const noexcept
+    {
+        // A bitset word costs far less than a member lookup, so AND the
+        // bitsets unless they are much longer than the smaller member list.
+        constexpr size_t WORDS_PER_MEMBER = 4;
+
+        const size_t words = std::min(bits_.size(), other.bits_.size());
+        if (words <= WORDS_PER_MEMBER * std::min(size(), other.size()))
+        {
+            return BitKernels::andPopcount(bits_.data(), other.bits_.data(), words);
+        }
+
+        const Solution &smaller = size() <= other.size() ? *this : other;
+        const Solution &larger = size() <= other.size() ? other : *this;
+
+        size_t shared = 0;
+        for (Node node : smaller.nodes_)
+        {
+            shared += larger.contains(node);
+        }
+        return shared;
+    }
+
+    /// Set equality; the insertion order of the members is irrelevant.
+    bool operator==(const Solution &other) const noexcept
+    {
+        return fingerprint_ == other.fingerprint_ && size() == other.size()
+               && intersectionSize(other) == size();
+    }
+};
+
+template <> struct std::hash<Solution>
+{
+    size_t operator()(const Solution &solution) const noexcept
+    {
+        return static_cast<size_t>(solution.fingerprint());
+    }
+};
+
+#endif  // SOLUTION_H
@@ -1,6 +1,9 @@
 #ifndef GRAPH_TYPES_H
 #define GRAPH_TYPES_H
 
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <unordered_set>
 #include <vector>
 
@@ -8,7 +11,13 @@ using Node = int;
 using Age = long;
 using NodeSet = std::unordered_set<Node>;
 using ComponentIndex = int;
-using Solution = NodeSet;
+
+/// Objective value. 64-bit, since the pair count of a component of more
+/// than about 65k nodes overflows ``int``.
+using ObjValue = int64_t;
+
+/// Objective value of "no solution yet"; worse than every real value.
+constexpr ObjValue MAX_OBJ_VALUE = std::numeric_limits<ObjValue>::max();
 
 /**
  * Represents a connected component in the graph.
@@ -16,12 +25,27 @@ using Solution = NodeSet;
 struct Component
 {
     size_t size;              ///< Number of nodes in this connected component.
+    size_t weight;            ///< Sum of node weights; equals size for unit weights.
+    int64_t squaredWeight;    ///< Sum of squared node weights.
     std::vector<Node> nodes;  ///< List of all nodes contained in this connected component.
-    Component() noexcept : size(0) {}
+    Component() noexcept : size(0), weight(0), squaredWeight(0) {}
 };
 
 using Components = std::vector<Component>;
 
 constexpr Node INVALID_NODE = -1;
 
+/**
+ * Per-node state flags kept by the graph implementations.
+ *
+ * A node takes part in traversals only if its flags equal ``NODE_ACTIVE``.
+ * ``NODE_REMOVED`` marks nodes in the current solution, ``NODE_EXCLUDED``
+ * marks nodes that are absent from the node set or were permanently dropped
+ * by a problem reduction.
+ */
+using NodeFlags = uint8_t;
+constexpr NodeFlags NODE_ACTIVE = 0;
+constexpr NodeFlags NODE_REMOVED = 1;
+constexpr NodeFlags NODE_EXCLUDED = 2;
+
 #endif  // GRAPH_TYPES_H
@@ -0,0 +1,150 @@
+#include "MappedFile.h"
+
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#if defined(PYCNP_HAVE_ZLIB)
+#include <zlib.h>
+#endif
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+bool isGzip(std::string_view data)
+{
+    return data.size() >= 2 && static_cast<unsigned char>(data[0]) == 0x1f
+           && static_cast<unsigned char>(data[1]) == 0x8b;
+}
+
+std::vector<char> inflateFile(const std::string &filename)
+{
+#if defined(PYCNP_HAVE_ZLIB)
+    gzFile file = gzopen(filename.c_str(), "rb");
+    if (!file)
+    {
+        throw std::runtime_error("Cannot open file: " + filename);
+    }
+    gzbuffer(file, 1 << 17);
+
+    std::vector<char> contents;
+    constexpr size_t CHUNK_SIZE = 1 << 20;
+    while (true)
+    {
+        const size_t size = contents.size();
+        contents.resize(size + CHUNK_SIZE);
+        const int read
+            = gzread(file, contents.data() + size, static_cast<unsigned>(CHUNK_SIZE));
+        if (read < 0)
+        {
+            int code = 0;
+            const std::string message = gzerror(file, &code);
+            gzclose(file);
+            throw std::runtime_error("Cannot decompress " + message);
+        }
+        contents.resize(size + static_cast<size_t>(read));
+        if (read == 0)
+        {
+            break;
+        }
+    }
+
+    // A truncated stream ends without a read error; gzerror tells.
+    int code = Z_OK;
+    const std::string message = gzerror(file, &code);
+    gzclose(file);
+    if (code != Z_OK)
+    {
+        throw std::runtime_error("Cannot decompress " + message);
+    }
+    return contents;
+#else
+    throw std::runtime_error("Cannot read " + filename
+                             + ": pycnp was built without gzip support");
+#endif
+}
+}  // namespace
+
+MappedFile::MappedFile(const std::string &filename)
+{
+#if defined(_WIN32)
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open())
+    {
+        throw std::runtime_error("Cannot open file: " + filename);
+    }
+    buffer_.assign(std::istreambuf_iterator<char>(file),
+                   std::istreambuf_iterator<char>());
+#else
+    const int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        throw std::runtime_error("Cannot open file: " + filename);
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0)
+    {
+        ::close(fd);
+        throw std::runtime_error("Cannot stat file: " + filename);
+    }
+
+    // mmap rejects empty mappings; an empty file simply has no contents.
+    if (info.st_size > 0)
+    {
+        void *address = ::mmap(nullptr,
+                               static_cast<size_t>(info.st_size),
+                               PROT_READ,
+                               MAP_PRIVATE,
+                               fd,
+                               0);
+        ::close(fd);
+        if (address == MAP_FAILED)
+        {
+            throw std::runtime_error("Cannot map file: " + filename);
+        }
+        ::madvise(address, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+
+        data_ = static_cast<const char *>(address);
+        size_ = static_cast<size_t>(info.st_size);
+        mapped_ = true;
+    }
+    else
+    {
+        ::close(fd);
+    }
+#endif
+
+    if (isGzip(data()))
+    {
+        std::vector<char> contents = inflateFile(filename);
+#if !defined(_WIN32)
+        ::munmap(const_cast<char *>(data_), size_);
+#endif
+        mapped_ = false;
+        buffer_ = std::move(contents);
+    }
+
+    if (!mapped_)
+    {
+        data_ = buffer_.data();
+        size_ = buffer_.size();
+    }
+}
+
+MappedFile::~MappedFile()
+{
+#if !defined(_WIN32)
+    if (mapped_)
+    {
+        ::munmap(const_cast<char *>(data_), size_);
+    }
+#endif
+}
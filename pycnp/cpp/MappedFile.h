@@ -0,0 +1,56 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * MappedFile
+ *
+ * Read-only view of a file's contents.
+ *
+ * Regular files are memory-mapped, so loading does not copy them and
+ * concurrent readers share the page cache. Gzip-compressed files, detected
+ * by their magic bytes, are inflated into memory instead; this needs a
+ * build with zlib. On platforms without ``mmap`` the file is read into
+ * memory.
+ */
+class MappedFile
+{
+public:
+    /**
+     * Opens and maps a file.
+     *
+     * Parameters
+     * ----------
+     * filename
+     *     Path to the file.
+     *
+     * Throws
+     * ------
+     * std::runtime_error
+     *     If the file cannot be opened, mapped or decompressed.
+     */
+    explicit MappedFile(const std::string &filename);
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    /// Returns the (decompressed) file contents.
+    std::string_view data() const noexcept { return {data_, size_}; }
+
+    /// Whether the contents are mapped rather than held in memory.
+    bool isMapped() const noexcept { return mapped_; }
+
+private:
+    const char *data_ = nullptr;
+    size_t size_ = 0;
+    bool mapped_ = false;
+    std::vector<char> buffer_;  ///< Contents when not mapped
+};
+
+#endif  // MAPPED_FILE_H
@@ -0,0 +1,491 @@
+#include "MemeticEngine.h"
+#include "Graph/ObjectivePolicy.h"
+#include "Population.h"
+#include "crossover/doubleBackboneBasedCrossover.h"
+#include "crossover/inherit_repair_recombination.h"
+#include "crossover/reduceSolveCombine.h"
+#include "ThreadPool.h"
+#include "Trace.h"
+#include "search/SearchBudget.h"
+#include "search/SearchCache.h"
+#include <any>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/// Parents of one offspring (the third only for IRR) and its seeds.
+struct MemeticEngine::Mating
+{
+    std::tuple<Solution, Solution, Solution> parents;
+    int seed = 0;        ///< Crossover seed
+    int searchSeed = 0;  ///< Local search seed
+};
+
+/// State shared by the islands of one run, guarded by ``mutex``.
+struct MemeticEngine::Shared
+{
+    const StoppingCriterion &stoppingCriterion;
+    const std::chrono::steady_clock::time_point start;
+
+    std::mutex mutex;
+    std::atomic<bool> stop{false};
+    std::exception_ptr error;
+
+    Progress progress;
+    Result result;
+
+    /// Best solution last published by each island, empty until then.
+    std::vector<std::pair<Solution, ObjValue>> board;
+
+    /// Local search results of all islands; has its own lock.
+    SearchCache searchCache;
+
+    /// Cancelled when the run stops, so running searches return early.
+    std::shared_ptr<CancelToken> cancel = std::make_shared<CancelToken>();
+
+    /// Limits passed to every local search: the cancel token, and the
+    /// deadline of the run when it has a time limit.
+    std::unordered_map<std::string, std::any> searchParams;
+
+    /// Receives the improvements of the run best; pushed under ``mutex``,
+    /// so the islands act as its single producer.
+    std::shared_ptr<ProgressQueue> progressQueue;
+
+    Shared(const StoppingCriterion &criterion,
+           std::shared_ptr<ProgressQueue> queue,
+           int numIslands,
+           size_t cacheSize,
+           double timeLimit)
+        : stoppingCriterion(criterion),
+          start(std::chrono::steady_clock::now()),
+          board(numIslands, {Solution(), MAX_OBJ_VALUE}),
+          searchCache(cacheSize),
+          progressQueue(std::move(queue))
+    {
+        searchParams["cancelToken"] = cancel;
+        if (timeLimit > 0)
+        {
+            searchParams["deadline"]
+                = start
+                  + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                      std::chrono::duration<double>(timeLimit));
+        }
+    }
+
+    void halt()
+    {
+        stop = true;
+        cancel->cancel();
+    }
+
+    double elapsed() const
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now()
+                                             - start)
+            .count();
+    }
+
+    // Records a solution found by an island; caller holds ``mutex``.
+    void report(int island, const Solution &solution, ObjValue objValue)
+    {
+        if (objValue < result.bestObjValue)
+        {
+            result.bestSolution = solution;
+            result.bestObjValue = objValue;
+            result.bestFoundAtTime = elapsed();
+            progress.bestObjValue = objValue;
+
+            if (progressQueue)
+            {
+                ProgressEvent event;
+                event.objValue = objValue;
+                event.time = result.bestFoundAtTime;
+                event.source = island;
+                event.iteration = progress.numGenerations;
+                progressQueue->publish(solution, event);
+            }
+        }
+    }
+};
+
+MemeticEngine::MemeticEngine(const ProblemData &problemData,
+                             std::string problemType,
+                             int budget,
+                             int seed,
+                             Params params)
+    : problemData_(problemData),
+      problemType_(std::move(problemType)),
+      budget_(budget),
+      seed_(seed),
+      params_(std::move(params))
+{
+    if (params_.crossover != "RSC" && params_.crossover != "DBX"
+        && params_.crossover != "IRR")
+    {
+        throw std::invalid_argument("Unknown crossover strategy: "
+                                    + params_.crossover);
+    }
+    if (params_.numIslands < 1)
+    {
+        throw std::invalid_argument("numIslands must be at least 1");
+    }
+    if (params_.migrationInterval < 0)
+    {
+        throw std::invalid_argument("migrationInterval must be non-negative");
+    }
+    if (params_.numOffspring < 1)
+    {
+        throw std::invalid_argument("numOffspring must be at least 1");
+    }
+    if (params_.initialPopSize < 1 || params_.maxIdleGens < 1)
+    {
+        throw std::invalid_argument(
+            "initialPopSize and maxIdleGens must be positive");
+    }
+
+    // Same rules as the Python validation: DCNP is only searched by BCLS,
+    // and BCLS only applies to DCNP. The reduce search only runs for RSC.
+    const auto checkSearch = [&](const std::string &search, const char *name)
+    {
+        if (problemType_ == "DCNP" && search != "BCLS")
+        {
+            throw std::invalid_argument(std::string(name)
+                                        + " must be BCLS for DCNP, got "
+                                        + search);
+        }
+        if (isCNPProblemType(problemType_) && search == "BCLS")
+        {
+            throw std::invalid_argument(std::string(name)
+                                        + " BCLS is not supported for "
+                                        + problemType_);
+        }
+    };
+    checkSearch(params_.search, "search");
+    if (params_.crossover == "RSC")
+    {
+        checkSearch(params_.reduceSearch, "reduceSearch");
+    }
+
+    // Tournament selection draws two distinct parents, and IRR recombines
+    // exactly three fixed individuals.
+    if (params_.crossover == "IRR")
+    {
+        if (problemType_ != "DCNP")
+        {
+            throw std::invalid_argument(
+                "IRR crossover is only supported for DCNP problems");
+        }
+        if (params_.initialPopSize != 3 || params_.isPopVariable)
+        {
+            throw std::invalid_argument(
+                "IRR crossover requires initialPopSize 3 and a fixed-size "
+                "population");
+        }
+    }
+    else if (params_.initialPopSize < 2)
+    {
+        throw std::invalid_argument(params_.crossover
+                                    + " crossover requires initialPopSize >= 2");
+    }
+}
+
+MemeticEngine::Result
+MemeticEngine::run(const StoppingCriterion &stoppingCriterion,
+                   std::shared_ptr<ProgressQueue> progressQueue)
+{
+    Shared shared(stoppingCriterion,
+                  std::move(progressQueue),
+                  params_.numIslands,
+                  params_.searchCacheSize,
+                  params_.timeLimit);
+    if (params_.numShards > 1)
+    {
+        shared.searchParams["numShards"] = params_.numShards;
+    }
+
+    // Graphs are created up front, on this thread, so the islands only
+    // share the already built topology.
+    // Each island gets its own split of the run's stream.
+    RandomNumberGenerator runSeeds(seed_);
+    std::vector<RandomNumberGenerator> islandSeeds;
+    std::vector<int> seeds;
+    std::vector<std::unique_ptr<Graph>> graphs;
+    graphs.reserve(params_.numIslands);
+    for (int island = 0; island < params_.numIslands; ++island)
+    {
+        islandSeeds.push_back(runSeeds.split());
+        seeds.push_back(island == 0 ? seed_ : islandSeeds.back().nextSeed());
+        graphs.push_back(
+            problemData_.createOriginalGraph(problemType_,
+                                             budget_,
+                                             seeds.back(),
+                                             params_.hopDistance,
+                                             params_.treeStorage,
+                                             params_.kernelize));
+    }
+
+    if (params_.numIslands == 1)
+    {
+        runIsland(0, seeds[0], islandSeeds[0], *graphs[0], shared);
+    }
+    else
+    {
+        std::vector<std::thread> threads;
+        threads.reserve(params_.numIslands);
+        for (int island = 0; island < params_.numIslands; ++island)
+        {
+            threads.emplace_back(
+                [this, island, &seeds, &islandSeeds, &graphs, &shared]
+                {
+                    runIsland(island,
+                              seeds[island],
+                              islandSeeds[island],
+                              *graphs[island],
+                              shared);
+                });
+        }
+        for (std::thread &thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    if (shared.error)
+    {
+        std::rethrow_exception(shared.error);
+    }
+
+    shared.result.numGenerations = shared.progress.numGenerations;
+    shared.result.runtime = shared.elapsed();
+    shared.result.searchCacheHits = shared.searchCache.hits();
+    shared.result.searchCacheMisses = shared.searchCache.misses();
+    return std::move(shared.result);
+}
+
+std::unique_ptr<Graph> MemeticEngine::crossover(const Graph &originalGraph,
+                                                const Mating &mating,
+                                                std::unique_ptr<Graph> offspring,
+                                                const Shared &shared) const
+{
+    PYCNP_TRACE_PHASE(Crossover);
+    const auto &[parent1, parent2, parent3] = mating.parents;
+
+    if (params_.crossover == "IRR")
+    {
+        return inherit_repair_recombination(originalGraph,
+                                            {&parent1, &parent2, &parent3},
+                                            mating.seed,
+                                            std::move(offspring));
+    }
+    if (params_.crossover == "RSC")
+    {
+        return reduceSolveCombine(originalGraph,
+                                  {&parent1, &parent2},
+                                  params_.reduceSearch,
+                                  params_.reduceBeta,
+                                  mating.seed,
+                                  std::move(offspring),
+                                  shared.searchParams);
+    }
+    return doubleBackboneBasedCrossover(originalGraph,
+                                        {&parent1, &parent2},
+                                        mating.seed,
+                                        std::move(offspring));
+}
+
+void MemeticEngine::runIsland(int island,
+                              int islandSeed,
+                              RandomNumberGenerator seeds,
+                              Graph &originalGraph,
+                              Shared &shared) const
+{
+    try
+    {
+        // The islands are the parallelism; populations stay serial.
+        Population population(originalGraph,
+                              params_.search,
+                              params_.isPopVariable,
+                              params_.initialPopSize,
+                              params_.maxPopSize,
+                              params_.increasePopSize,
+                              params_.maxIdleGens,
+                              islandSeed);
+        population.setNumThreads(1);
+        population.setTabuArchiveSize(params_.tabuArchiveSize);
+        population.setSearchParams(shared.searchParams);
+
+        auto [bestSolution, bestObjValue] = population.initialize(
+            false, [&shared](ObjValue) { return shared.stop.load(); });
+        {
+            std::lock_guard<std::mutex> lock(shared.mutex);
+            shared.report(island, bestSolution, bestObjValue);
+        }
+
+        int numIdleGenerations = 0;
+        int numGenerations = 0;
+        const int numIslands = static_cast<int>(shared.board.size());
+
+        // Offspring graphs are rebuilt in place every generation, so their
+        // buffers and the scratch space of their searches are allocated
+        // once per island rather than once per offspring.
+        std::vector<Mating> matings(params_.numOffspring);
+        std::vector<std::unique_ptr<Graph>> children(params_.numOffspring);
+        std::vector<size_t> searched;
+        std::vector<std::pair<Solution, ObjValue>> offspring;
+
+        while (!shared.stop.load())
+        {
+            {
+                std::lock_guard<std::mutex> lock(shared.mutex);
+                if (shared.stop.load())
+                {
+                    break;
+                }
+                shared.progress.runtime = shared.elapsed();
+                if ((params_.timeLimit > 0
+                     && shared.progress.runtime >= params_.timeLimit)
+                    || shared.stoppingCriterion(shared.progress))
+                {
+                    shared.halt();
+                    break;
+                }
+            }
+
+            // Parents and seeds are drawn in order on this thread, so the
+            // offspring do not depend on the thread count.
+            for (Mating &mating : matings)
+            {
+                if (params_.crossover == "IRR")
+                {
+                    mating.parents = population.getAllThreeSolutions();
+                }
+                else
+                {
+                    auto [parent1, parent2] = population.tournamentSelectTwoSolutions();
+                    mating.parents = {std::move(parent1), std::move(parent2), Solution()};
+                }
+                mating.seed = seeds.nextSeed();
+                mating.searchSeed = seeds.nextSeed();
+            }
+
+            ThreadPool::instance().parallelFor(
+                matings.size(),
+                matings.size(),
+                [&](size_t begin, size_t end, size_t)
+                {
+                    for (size_t j = begin; j < end; ++j)
+                    {
+                        children[j] = crossover(originalGraph,
+                                                matings[j],
+                                                std::move(children[j]),
+                                                shared);
+                    }
+                });
+
+            // The archive is consulted in mating order, so a repeat within
+            // the batch is skipped just like one from an earlier generation.
+            searched.clear();
+            for (size_t j = 0; j < children.size(); ++j)
+            {
+                if (population.markEvaluated(children[j]->getRemovedNodes()))
+                {
+                    searched.push_back(j);
+                }
+            }
+
+            offspring.assign(searched.size(), {Solution(), MAX_OBJ_VALUE});
+            ThreadPool::instance().parallelFor(
+                searched.size(),
+                searched.size(),
+                [&](size_t begin, size_t end, size_t)
+                {
+                    for (size_t k = begin; k < end; ++k)
+                    {
+                        const size_t j = searched[k];
+                        SearchResult searchResult
+                            = shared.searchCache.run(*children[j],
+                                                     params_.search,
+                                                     matings[j].searchSeed,
+                                                     shared.searchParams);
+                        offspring[k] = {std::move(searchResult.solution),
+                                        searchResult.objValue};
+                    }
+                });
+
+            {
+                PYCNP_TRACE_PHASE(PopulationUpdate);
+                population.updateBatch(offspring, numIdleGenerations);
+            }
+
+            bool improved = false;
+            for (const auto &[solution, objValue] : offspring)
+            {
+                if (objValue < bestObjValue)
+                {
+                    bestSolution = solution;
+                    bestObjValue = objValue;
+                    improved = true;
+                }
+            }
+            numIdleGenerations = improved ? 0 : numIdleGenerations + 1;
+            numGenerations++;
+
+            const bool migrate = numIslands > 1 && params_.migrationInterval > 0
+                                 && numGenerations % params_.migrationInterval == 0;
+
+            std::pair<Solution, ObjValue> migrant{Solution(), MAX_OBJ_VALUE};
+            {
+                std::lock_guard<std::mutex> lock(shared.mutex);
+                ObjValue previousBest = shared.progress.bestObjValue;
+                shared.report(island, bestSolution, bestObjValue);
+                shared.progress.numGenerations++;
+                if (shared.progress.bestObjValue < previousBest)
+                {
+                    shared.progress.numIdleGenerations = 0;
+                }
+                else
+                {
+                    shared.progress.numIdleGenerations++;
+                }
+
+                if (migrate)
+                {
+                    shared.board[island] = {bestSolution, bestObjValue};
+                    migrant = shared.board[(island + numIslands - 1) % numIslands];
+                }
+            }
+
+            // The population update runs outside the lock; only this
+            // island touches its population.
+            if (migrant.second != MAX_OBJ_VALUE && !population.isDuplicate(migrant.first))
+            {
+                population.update(migrant.first, migrant.second, 0);
+                if (migrant.second < bestObjValue)
+                {
+                    bestSolution = migrant.first;
+                    bestObjValue = migrant.second;
+                }
+
+                std::lock_guard<std::mutex> lock(shared.mutex);
+                shared.result.numMigrations++;
+            }
+        }
+    }
+    catch (...)
+    {
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        if (!shared.error)
+        {
+            shared.error = std::current_exception();
+        }
+        shared.halt();
+    }
+}
@@ -0,0 +1,208 @@
+#ifndef MEMETIC_ENGINE_H
+#define MEMETIC_ENGINE_H
+
+#include "Graph/Solution.h"
+#include "ProblemData.h"
+#include "ProgressQueue.h"
+#include "RandomNumberGenerator.h"
+#include <climits>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+
+/**
+ * MemeticEngine
+ *
+ * Island-model memetic search with the generation loop in C++.
+ *
+ * Every island owns an original graph and a :class:`Population`, and runs
+ * the same generation loop as the Python ``MemeticSearch``: crossover,
+ * local search and population update. Islands run on their own threads.
+ * A generation may breed several offspring, whose crossovers and local
+ * searches run in parallel before one batched population update.
+ * Every ``migrationInterval`` generations an island publishes its best
+ * solution and takes in the best one published by its predecessor on a
+ * ring, unless its population already holds it.
+ *
+ * With a tabu archive, the crossover result of every offspring is checked
+ * against the last ``tabuArchiveSize`` ones of its island, and offspring
+ * that start from a set seen before skip the local search and the
+ * population update.
+ *
+ * With a search cache, shared by all islands, an offspring whose crossover
+ * result was local-searched before reuses that result; see
+ * :class:`SearchCache`.
+ *
+ * A single island reproduces ``MemeticSearch`` for the same seed. With
+ * several islands the migrations depend on thread timing, so runs are not
+ * reproducible.
+ */
+class MemeticEngine
+{
+public:
+    /**
+     * Parameters
+     *
+     * Configuration of the search; the defaults match ``MemeticSearchParams``
+     * and ``VariablePopulationParams``.
+     */
+    struct Params
+    {
+        std::string search = "CHNS";      ///< Local search strategy
+        std::string crossover = "RSC";    ///< "RSC", "DBX" or "IRR"
+        std::string reduceSearch = "CHNS";  ///< Search used inside RSC
+        double reduceBeta = 0.9;          ///< Backbone fraction kept by RSC
+        bool isPopVariable = true;
+        int initialPopSize = 5;
+        int maxPopSize = 20;
+        int increasePopSize = 3;
+        int maxIdleGens = 20;
+        int hopDistance = INT_MAX;        ///< K-hop limit, DCNP only
+        std::string treeStorage = "auto";  ///< K-hop tree storage, DCNP only
+        int numOffspring = 1;  ///< Offspring bred per generation, in parallel
+        int numIslands = 1;
+        int migrationInterval = 20;  ///< Generations between migrations, 0 never
+        size_t tabuArchiveSize = 0;  ///< Crossover results remembered, 0 off
+        size_t searchCacheSize = 0;  ///< Local search results cached, 0 off
+        double timeLimit = 0.0;  ///< Seconds, 0 none; cuts searches short
+        bool kernelize = false;  ///< Search a reduced graph, CNP leaves folded
+        int numShards = 1;  ///< Parallel shards per CNP local search, 1 off
+    };
+
+    /**
+     * Progress
+     *
+     * State of the whole run, as seen by the stopping criterion.
+     */
+    struct Progress
+    {
+        int numGenerations = 0;  ///< Generations finished over all islands
+        ObjValue bestObjValue = MAX_OBJ_VALUE;  ///< Best objective value so far
+        int numIdleGenerations = 0;  ///< Generations since it improved
+        double runtime = 0.0;        ///< Seconds since the run started
+    };
+
+    /**
+     * Result
+     *
+     * Outcome of a run.
+     */
+    struct Result
+    {
+        Solution bestSolution;
+        ObjValue bestObjValue = MAX_OBJ_VALUE;
+        int numGenerations = 0;   ///< Generations over all islands
+        int numMigrations = 0;    ///< Migrants taken in by a population
+        double runtime = 0.0;     ///< Seconds
+        double bestFoundAtTime = 0.0;  ///< Seconds
+        size_t searchCacheHits = 0;    ///< Local searches answered by the cache
+        size_t searchCacheMisses = 0;  ///< Local searches actually run
+    };
+
+    /// Returns true to stop the run.
+    using StoppingCriterion = std::function<bool(const Progress &)>;
+
+    /**
+     * Creates an engine for the given problem.
+     *
+     * Parameters
+     * ----------
+     * problemData : ProblemData
+     *     The graph; must outlive the engine.
+     * problemType : str
+     *     ``"CNP"`` or ``"DCNP"``.
+     * budget : int
+     *     Number of nodes to remove.
+     * seed : int
+     *     Random seed of the run. Island ``i`` draws its offspring seeds
+     *     from the ``i``-th split of a generator seeded with ``seed``; the
+     *     first island's graph and population use ``seed`` itself, like
+     *     MemeticSearch, and the others a seed drawn from their stream.
+     * params : Params
+     *     Search configuration.
+     *
+     * Raises
+     * ------
+     * ValueError
+     *     If the crossover is unknown, or the island count, the migration
+     *     interval or the population sizes are out of range. DBX and RSC
+     *     need an initial population of at least 2; IRR needs DCNP and a
+     *     fixed population of exactly 3. Also raised if ``search``, or
+     *     ``reduceSearch`` under RSC, does not fit the problem type: DCNP
+     *     needs BCLS, and the CNP variants do not support it.
+     */
+    MemeticEngine(const ProblemData &problemData,
+                  std::string problemType,
+                  int budget,
+                  int seed,
+                  Params params);
+
+    /// Creates an engine with the default parameters.
+    MemeticEngine(const ProblemData &problemData,
+                  std::string problemType,
+                  int budget,
+                  int seed)
+        : MemeticEngine(problemData, std::move(problemType), budget, seed, Params())
+    {
+    }
+
+    /**
+     * Runs all islands until the stopping criterion holds.
+     *
+     * The criterion is evaluated before every generation of every island,
+     * one call at a time, so counting criteria count generations over all
+     * islands. It is not consulted while the populations are initialised.
+     *
+     * Parameters
+     * ----------
+     * stoppingCriterion : Callable[[Progress], bool]
+     *     Returns true once the run should stop.
+     * progressQueue : ProgressQueue, optional
+     *     Receives an event for every improvement of the best solution of
+     *     the run, with the reporting island and the run's generation
+     *     count, and keeps that solution for anytime access. Drain it from
+     *     another thread while the run goes on.
+     *
+     * Returns
+     * -------
+     * Result
+     *     Best solution found and run statistics.
+     *
+     * Raises
+     * ------
+     * RuntimeError
+     *     If an island fails; the first error is rethrown once all islands
+     *     have stopped.
+     */
+    Result run(const StoppingCriterion &stoppingCriterion,
+               std::shared_ptr<ProgressQueue> progressQueue = nullptr);
+
+private:
+    struct Shared;
+    struct Mating;
+
+    const ProblemData &problemData_;
+    std::string problemType_;
+    int budget_;
+    int seed_;
+    Params params_;
+
+    // Applies the crossover to ``mating``, rebuilding ``offspring`` in
+    // place when it holds the graph of an earlier generation. Crossovers
+    // that search, like RSC, pass ``shared.searchParams`` to the search.
+    std::unique_ptr<Graph> crossover(const Graph &originalGraph,
+                                     const Mating &mating,
+                                     std::unique_ptr<Graph> offspring,
+                                     const Shared &shared) const;
+
+    // Runs the generation loop of one island until the run stops;
+    // ``seeds`` is the island's seed stream.
+    void runIsland(int island,
+                   int islandSeed,
+                   RandomNumberGenerator seeds,
+                   Graph &originalGraph,
+                   Shared &shared) const;
+};
+
+#endif  // MEMETIC_ENGINE_H
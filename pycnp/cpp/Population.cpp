@@ -1,33 +1,76 @@
 #include "Population.h"
+#include "ThreadPool.h"
+#include "Trace.h"
 #include <algorithm>
 #include <iostream>
-#include <cstdio>
 #include <limits>
 #include <memory>
 #include <numeric>
 #include <stdexcept>
+#include <string>
 
 void Population::update(const Solution &newSolution,
-                        int objValue,
+                        ObjValue objValue,
                         int num_idle_generations,
                         bool verbose)
 {
-    // Create a new individual and assign a unique ID
-    Item newItem(newSolution, objValue, 0.0, nextItemId_++);
+    updateBatch({{newSolution, objValue}}, num_idle_generations, verbose);
+}
 
-    // Store only similarity values and IDs to reduce memory usage
-    for (auto &item : population_)
+void Population::updateBatch(
+    const std::vector<std::pair<Solution, ObjValue>> &offspring,
+    int num_idle_generations,
+    bool verbose)
+{
+    if (offspring.empty())
     {
-        double similarity = computeSimilarity(item.solution, newSolution);
-        // The new individual records similarity with existing individuals
-        newItem.similarity.push_back({similarity, item.id});
-        // Existing individuals record similarity with the new individual
-        item.similarity.push_back({similarity, newItem.id});
+        adaptSize(num_idle_generations, verbose);
+        return;
     }
 
-    population_.push_back(newItem);
-    removeWorstSolution();
+    // similarities[j] holds offspring j against every current individual,
+    // then against the offspring before it.
+    const size_t numOld = population_.size();
+    std::vector<std::vector<double>> similarities(offspring.size());
+
+    ThreadPool::instance().parallelFor(
+        offspring.size(),
+        ThreadPool::resolveThreads(numThreads_),
+        [&](size_t begin, size_t end, size_t)
+        {
+            for (size_t j = begin; j < end; ++j)
+            {
+                const Solution &solution = offspring[j].first;
+                auto &row = similarities[j];
+                row.reserve(numOld + j);
+                for (size_t i = 0; i < numOld; ++i)
+                {
+                    row.push_back(
+                        computeSimilarity(population_[i].solution, solution));
+                }
+                for (size_t k = 0; k < j; ++k)
+                {
+                    row.push_back(
+                        computeSimilarity(offspring[k].first, solution));
+                }
+            }
+        });
+
+    for (size_t j = 0; j < offspring.size(); ++j)
+    {
+        insertItem(offspring[j].first, offspring[j].second, similarities[j]);
+    }
+
+    for (size_t j = 0; j < offspring.size(); ++j)
+    {
+        removeWorstSolution();
+    }
+
+    adaptSize(num_idle_generations, verbose);
+}
 
+void Population::adaptSize(int num_idle_generations, bool verbose)
+{
     if (isVariablePopulation_
         && num_idle_generations > 0
         && num_idle_generations % maxIdleGens_ == 0
@@ -56,20 +99,81 @@ void Population::update(const Solution &newSolution,
     }
 }
 
-void Population::add(const Solution &newSolution, int objValue)
+void Population::add(const Solution &newSolution, ObjValue objValue)
 {
-    Solution solution = newSolution;
-    Item item(solution, objValue, 0.0, nextItemId_++);
+    std::vector<double> similarities;
+    similarities.reserve(population_.size());
+    for (const auto &item : population_)
+    {
+        similarities.push_back(computeSimilarity(newSolution, item.solution));
+    }
 
-    for (auto &otherItem : population_)
+    insertItem(newSolution, objValue, similarities);
+}
+
+size_t Population::acquireSlot()
+{
+    if (freeSlots_.empty())
     {
-        double similarity = computeSimilarity(item.solution, otherItem.solution);
-        // Store only similarity values and IDs, not full Solution objects
-        item.similarity.push_back({similarity, otherItem.id});
-        otherItem.similarity.push_back({similarity, item.id});
+        // Grow the matrix, keeping every entry at its (row, column).
+        const size_t oldCapacity = slotCapacity_;
+        const size_t newCapacity = std::max(SIMILARITY_RESERVE_SIZE, 2 * oldCapacity);
+
+        std::vector<double> grown(newCapacity * newCapacity, 0.0);
+        for (size_t row = 0; row < oldCapacity; ++row)
+        {
+            std::copy_n(similarity_.begin() + row * oldCapacity,
+                        oldCapacity,
+                        grown.begin() + row * newCapacity);
+        }
+        similarity_ = std::move(grown);
+        slotCapacity_ = newCapacity;
+
+        // Hand out the lowest new slot first.
+        for (size_t slot = newCapacity; slot-- > oldCapacity;)
+        {
+            freeSlots_.push_back(slot);
+        }
     }
 
-    population_.push_back(item);
+    const size_t slot = freeSlots_.back();
+    freeSlots_.pop_back();
+    return slot;
+}
+
+void Population::clearItems()
+{
+    population_.clear();
+    fingerprints_.clear();
+    freeSlots_.clear();
+    for (size_t slot = slotCapacity_; slot-- > 0;)
+    {
+        freeSlots_.push_back(slot);
+    }
+    fitnessStale_ = true;
+}
+
+void Population::insertItem(Solution solution,
+                            ObjValue objValue,
+                            const std::vector<double> &similarities)
+{
+    // Create a new individual and assign a unique ID
+    Item item(std::move(solution), objValue, 0.0, nextItemId_++);
+    item.slot = acquireSlot();
+
+    for (size_t i = 0; i < population_.size(); ++i)
+    {
+        Item &other = population_[i];
+        const double value = similarities[i];
+        similarity(item.slot, other.slot) = value;
+        similarity(other.slot, item.slot) = value;
+        item.similaritySum += value;
+        other.similaritySum += value;
+    }
+
+    fingerprints_[item.solution.fingerprint()]++;
+    population_.push_back(std::move(item));
+    fitnessStale_ = true;
 }
 
 void Population::removeWorstSolution()
@@ -80,31 +184,36 @@ void Population::removeWorstSolution()
                                     [](const Item &a, const Item &b)
                                     { return a.fitness < b.fitness; });
 
-    // Get the ID of the individual being removed
-    size_t worstId = worstIt->id;
-
-    // Remove references to the removed individual from similarity vectors of all other individuals
+    // Take the removed individual out of the others' similarity sums; its
+    // matrix row and column are simply overwritten once the slot is reused.
+    const size_t worstSlot = worstIt->slot;
     for (auto &item : population_)
     {
-        if (item.id != worstId)
+        if (item.slot != worstSlot)
         {
-            auto &similarity = item.similarity;
-            // Remove similarity records by ID, which is more efficient than comparing Solution objects
-            similarity.erase(
-                std::remove_if(
-                    similarity.begin(),
-                    similarity.end(),
-                    [worstId](const auto &pair)
-                    { return pair.second == worstId; }),
-                similarity.end());
+            item.similaritySum -= similarity(item.slot, worstSlot);
         }
     }
 
+    auto fingerprint = fingerprints_.find(worstIt->solution.fingerprint());
+    if (--fingerprint->second == 0)
+    {
+        fingerprints_.erase(fingerprint);
+    }
+
+    freeSlots_.push_back(worstSlot);
     population_.erase(worstIt);
+    fitnessStale_ = true;
 }
 
 void Population::updateFitness()
 {
+    if (!fitnessStale_)
+    {
+        return;
+    }
+    fitnessStale_ = false;
+
     const size_t popSize = population_.size();
     if (popSize <= 1)
     {
@@ -124,22 +233,8 @@ void Population::updateFitness()
 
         costs[i] = population_[i].objValue;
 
-        const auto &similarities = population_[i].similarity;
-
-        if (!similarities.empty())
-        {
-            // Only need to process similarity values; no need to access Solution objects
-            double sumSimilarity = 0.0;
-            for (const auto &[similarity, _] : similarities)
-            {
-                sumSimilarity += similarity;
-            }
-            diversityScores[i] = sumSimilarity / similarities.size();
-        }
-        else
-        {
-            diversityScores[i] = 0.0;
-        }
+        // Average similarity to the other individuals, from the cached sum
+        diversityScores[i] = population_[i].similaritySum / (popSize - 1);
     }
 
     auto calculateRanks
@@ -182,6 +277,10 @@ void Population::updateFitness()
 
 bool Population::isDuplicate(const Solution &solution) const
 {
+    if (!fingerprints_.contains(solution.fingerprint()))
+    {
+        return false;
+    }
 
     for (const auto &item : population_)
     {
@@ -193,6 +292,38 @@ bool Population::isDuplicate(const Solution &solution) const
     return false;
 }
 
+void Population::setTabuArchiveSize(size_t size)
+{
+    tabuArchiveSize_ = size;
+    while (tabuQueue_.size() > tabuArchiveSize_)
+    {
+        tabuArchive_.erase(tabuQueue_.front());
+        tabuQueue_.pop_front();
+    }
+}
+
+bool Population::markEvaluated(const Solution &solution)
+{
+    if (tabuArchiveSize_ == 0)
+    {
+        return true;
+    }
+
+    const uint64_t fingerprint = solution.fingerprint();
+    if (!tabuArchive_.insert(fingerprint).second)
+    {
+        return false;
+    }
+
+    tabuQueue_.push_back(fingerprint);
+    if (tabuQueue_.size() > tabuArchiveSize_)
+    {
+        tabuArchive_.erase(tabuQueue_.front());
+        tabuQueue_.pop_front();
+    }
+    return true;
+}
+
 std::tuple<Solution, Solution, Solution>
 Population::getAllThreeSolutions() const
 {
@@ -214,97 +345,145 @@ const Population::Item &Population::getBestItem() const
                             { return a.objValue < b.objValue; });
 }
 
-std::pair<Solution, int> Population::generateNonDuplicateSolution()
+void Population::setNumThreads(int numThreads)
 {
+    numThreads_ = numThreads;
+}
 
-    static int seedCounter = 1000;
-    int deterministicSeed = seedCounter++;
-
-    auto newGraph = originalGraph_.getRandomFeasibleGraph();
+void Population::setSearchParams(std::unordered_map<std::string, std::any> params)
+{
+    searchParams_ = std::move(params);
+}
 
-    Search ls(*newGraph, deterministicSeed);
+std::vector<std::unique_ptr<Graph>> Population::searchRandomGraphs(size_t count)
+{
+    // Drawing start graphs uses the original graph's generator, so it stays
+    // on this thread and in order.
+    std::vector<std::unique_ptr<Graph>> graphs;
+    std::vector<int> seeds;
+    graphs.reserve(count);
+    seeds.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        graphs.push_back(originalGraph_.getRandomFeasibleGraph());
+        seeds.push_back(searchSeeds_.nextSeed());
+    }
 
-    ls.setStrategy(search_);
+    ThreadPool::instance().parallelFor(
+        count,
+        ThreadPool::resolveThreads(numThreads_),
+        [&](size_t begin, size_t end, size_t)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                Search ls(*graphs[i], seeds[i]);
+                ls.setStrategy(search_);
+                for (const auto &[name, value] : searchParams_)
+                {
+                    ls.setParam(name, value);
+                }
+                ls.run();
+            }
+        });
 
-    SearchResult result = ls.run();
+    return graphs;
+}
 
+std::pair<Solution, ObjValue> Population::makeNonDuplicate(Graph &graph) const
+{
     int attempts = 0;
     const int MAX_ATTEMPTS = 10;
 
-    while (isDuplicate(newGraph->getRemovedNodes()) && attempts < MAX_ATTEMPTS)
+    while (isDuplicate(graph.getRemovedNodes()) && attempts < MAX_ATTEMPTS)
     {
-        if (FILE* dbg = std::fopen("/tmp/pycnp_debug.log", "a")) { std::fprintf(dbg, "[DEBUG] duplicate solution detected in generateNonDuplicateSolution attempts=%d\n", attempts); std::fclose(dbg); }
+        PYCNP_TRACE_COUNT(DuplicateSolutions);
+        PYCNP_TRACE_EVENT(DuplicateSolution, attempts, population_.size());
 
         Node addedNode;
         if (originalGraph_.isDCNP())
         {
-            addedNode = newGraph->findBestNodeToAdd();
+            addedNode = graph.findBestNodeToAdd();
         }
         else
         {
-            addedNode = newGraph->greedySelectNodeToAdd();
+            addedNode = graph.greedySelectNodeToAdd();
         }
-        newGraph->addNode(addedNode);
+        graph.addNode(addedNode);
 
-        auto removedNode = newGraph->randomSelectNodeToRemove();
-        newGraph->removeNode(removedNode);
+        auto removedNode = graph.randomSelectNodeToRemove();
+        graph.removeNode(removedNode);
         attempts++;
     }
 
-    Solution solution = newGraph->getRemovedNodes();
-    int objValue = newGraph->getObjectiveValue();
+    Solution solution = graph.getRemovedNodes();
+    ObjValue objValue = graph.getObjectiveValue();
 
     return std::make_pair(solution, objValue);
 }
 
+std::pair<Solution, ObjValue> Population::generateNonDuplicateSolution()
+{
+    auto graphs = searchRandomGraphs(1);
+    return makeNonDuplicate(*graphs.front());
+}
+
 void Population::expand()
 {
     const size_t newSize = population_.size() + increasePopSize_;
     population_.reserve(newSize);
 
-    while (population_.size() < newSize)
+    // Duplicates are checked in order, each against the solutions added
+    // before it, exactly as when generating one solution at a time.
+    for (auto &graph : searchRandomGraphs(newSize - population_.size()))
     {
-        auto [solution, objValue] = generateNonDuplicateSolution();
+        auto [solution, objValue] = makeNonDuplicate(*graph);
         add(solution, objValue);
     }
 }
 
 void Population::rebuild()
 {
-    // Use a reference to avoid copying, then create a new Item (assigning a new ID)
+    // Copy the best solution out, then restart from it alone (with a new ID)
     const Item &bestItemRef = getBestItem();
-    Item bestItem(bestItemRef.solution, bestItemRef.objValue, bestItemRef.fitness, nextItemId_++);
-    // Do not copy the similarity vector; let it be rebuilt
-    population_.clear();
-    population_.reserve(initPopSize_);  // Reserve space for the initial population size
-    population_.push_back(std::move(bestItem));
-    population_[0].similarity.clear();
+    Solution bestSolution = bestItemRef.solution;
+    const ObjValue bestObjValue = bestItemRef.objValue;
+    clearItems();
+    add(bestSolution, bestObjValue);
 
     auto [solution, objValue] = generateNonDuplicateSolution();
     add(solution, objValue);
 }
 
-std::pair<Solution, int>
+std::pair<Solution, ObjValue>
 Population::initialize(bool display,
-                    std::function<bool(int)> stopping_criterion)
+                    std::function<bool(ObjValue)> stopping_criterion)
 {
-    population_.clear();
+    clearItems();
 
-    for (int i = 0; i < initPopSize_; ++i)
-    {
-        auto [newSolution, objValue] = generateNonDuplicateSolution();
+    // Solutions are generated one thread-count batch at a time, so a
+    // stopping criterion is still checked every few searches.
+    const size_t batchSize = ThreadPool::resolveThreads(numThreads_);
+    const size_t popSize = std::max(initPopSize_, 0);
 
-        if (stopping_criterion and stopping_criterion(objValue))
+    for (size_t first = 0; first < popSize; first += batchSize)
+    {
+        auto graphs = searchRandomGraphs(std::min(batchSize, popSize - first));
+        for (auto &graph : graphs)
         {
-            if (display)
+            auto [newSolution, objValue] = makeNonDuplicate(*graph);
+
+            if (stopping_criterion and stopping_criterion(objValue))
             {
-                std::cout << "Stopping criterion met during initialization."
-                        << std::endl;
+                if (display)
+                {
+                    std::cout << "Stopping criterion met during initialization."
+                            << std::endl;
+                }
+                return {newSolution, objValue};
             }
-            return {newSolution, objValue};
-        }
 
-        add(newSolution, objValue);
+            add(newSolution, objValue);
+        }
     }
 
     const auto &bestItem = getBestItem();
@@ -316,7 +495,7 @@ std::pair<Solution, Solution> Population::tournamentSelectTwoSolutions(int k)
 {
 
     k = std::min(k, static_cast<int>(population_.size()));
-    if (FILE* dbg = std::fopen("/tmp/pycnp_debug.log", "a")) { std::fprintf(dbg, "[DEBUG] tournamentSelectTwoSolutions popSize=%zu k=%d\n", population_.size(), k); std::fclose(dbg); }
+    PYCNP_TRACE_COUNT(TournamentSelections);
 
     updateFitness();
 
@@ -366,6 +545,104 @@ std::pair<Solution, Solution> Population::tournamentSelectTwoSolutions(int k)
                         population_[parent2Index].solution);
 }
 
+Population::Snapshot Population::snapshot() const
+{
+    Snapshot snapshot;
+    const size_t popSize = population_.size();
+    snapshot.solutions.reserve(popSize);
+    snapshot.similarities.reserve(popSize * (popSize - 1) / 2);
+    for (size_t i = 0; i < popSize; ++i)
+    {
+        const Item &item = population_[i];
+        snapshot.solutions.push_back(item.solution.nodes());
+        snapshot.objValues.push_back(item.objValue);
+        snapshot.fitness.push_back(item.fitness);
+        snapshot.ids.push_back(item.id);
+        snapshot.similaritySums.push_back(item.similaritySum);
+        for (size_t j = i + 1; j < popSize; ++j)
+        {
+            snapshot.similarities.push_back(
+                similarity_[item.slot * slotCapacity_ + population_[j].slot]);
+        }
+    }
+
+    snapshot.fitnessStale = fitnessStale_;
+    snapshot.nextItemId = nextItemId_;
+    snapshot.rng = rng_->state();
+    snapshot.searchSeeds = searchSeeds_.state();
+    snapshot.tabuQueue.assign(tabuQueue_.begin(), tabuQueue_.end());
+    snapshot.tabuArchiveSize = tabuArchiveSize_;
+    return snapshot;
+}
+
+void Population::restore(const Snapshot &snapshot)
+{
+    const size_t popSize = snapshot.solutions.size();
+    if (snapshot.objValues.size() != popSize || snapshot.fitness.size() != popSize
+        || snapshot.ids.size() != popSize || snapshot.similaritySums.size() != popSize
+        || snapshot.similarities.size() != popSize * (popSize - 1) / 2)
+    {
+        throw std::invalid_argument("Population snapshot has inconsistent sizes");
+    }
+    if (!RandomNumberGenerator::isValidState(snapshot.rng)
+        || !RandomNumberGenerator::isValidState(snapshot.searchSeeds))
+    {
+        throw std::invalid_argument("Population snapshot has an all-zero generator state");
+    }
+
+    const int numNodes = originalGraph_.getNumNodes();
+    std::vector<Solution> solutions;
+    solutions.reserve(popSize);
+    for (const auto &nodes : snapshot.solutions)
+    {
+        Solution &solution = solutions.emplace_back(numNodes);
+        for (Node node : nodes)
+        {
+            if (node < 0 || node >= numNodes || !solution.insert(node))
+            {
+                throw std::invalid_argument(
+                    "Population snapshot has an invalid node " + std::to_string(node));
+            }
+        }
+    }
+
+    // Everything is validated above, so a bad snapshot leaves the
+    // population unchanged.
+    rng_->setState(snapshot.rng);
+    searchSeeds_.setState(snapshot.searchSeeds);
+
+    clearItems();
+    population_.reserve(popSize);
+    for (size_t i = 0; i < popSize; ++i)
+    {
+        Item item(std::move(solutions[i]),
+                  snapshot.objValues[i],
+                  snapshot.fitness[i],
+                  snapshot.ids[i]);
+        item.slot = acquireSlot();
+        item.similaritySum = snapshot.similaritySums[i];
+        fingerprints_[item.solution.fingerprint()]++;
+        population_.push_back(std::move(item));
+    }
+
+    size_t pair = 0;
+    for (size_t i = 0; i < popSize; ++i)
+    {
+        for (size_t j = i + 1; j < popSize; ++j)
+        {
+            const double value = snapshot.similarities[pair++];
+            similarity(population_[i].slot, population_[j].slot) = value;
+            similarity(population_[j].slot, population_[i].slot) = value;
+        }
+    }
+
+    fitnessStale_ = snapshot.fitnessStale;
+    nextItemId_ = snapshot.nextItemId;
+    tabuQueue_.assign(snapshot.tabuQueue.begin(), snapshot.tabuQueue.end());
+    tabuArchive_ = std::unordered_set<uint64_t>(tabuQueue_.begin(), tabuQueue_.end());
+    tabuArchiveSize_ = snapshot.tabuArchiveSize;
+}
+
 size_t Population::getSize() const
 {
     return population_.size();
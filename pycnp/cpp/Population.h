@@ -1,9 +1,15 @@
 #pragma once
 #include "RandomNumberGenerator.h"
 #include "search/Search.h"
+#include <any>
 #include <chrono>
+#include <cstdint>
+#include <deque>
 #include <functional>
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 class Graph;
 
@@ -36,22 +42,21 @@ private:
      * Internal representation of an individual solution.
      *
      * Each Item stores a solution, its objective value, fitness score,
-     * unique identifier, and similarity values to all other solutions.
+     * unique identifier, and its slot in the similarity matrix together
+     * with the sum of its similarities to all other solutions.
      */
     struct Item
     {
         Solution solution;           ///< The solution (set of nodes to remove)
-        int objValue;                ///< Objective value (connectivity after removal)
+        ObjValue objValue;           ///< Objective value (connectivity after removal)
         double fitness;              ///< Combined fitness score
         size_t id;                   ///< Unique identifier for this individual
-        // Store similarity values and corresponding individual IDs to reduce memory usage
-        using Similarity = std::vector<std::pair<double, size_t>>;
-        Similarity similarity;       ///< Similarity values to other solutions
+        size_t slot = 0;             ///< Row and column in the similarity matrix
+        double similaritySum = 0.0;  ///< Sum of similarities to the others
 
-        Item(Solution sol, int obj, double fit, size_t item_id)
+        Item(Solution sol, ObjValue obj, double fit, size_t item_id)
             : solution(std::move(sol)), objValue(obj), fitness(fit), id(item_id)
         {
-            similarity.reserve(SIMILARITY_RESERVE_SIZE);  // Reserve initial capacity
         }
 
         Item(const Item&) = default;
@@ -71,16 +76,78 @@ private:
     int increasePopSize_ = 3;                  ///< Number of individuals to add when expanding
     int maxIdleGens_ = 20;                     ///< Idle generations before triggering expansion
     mutable size_t nextItemId_ = 0;            ///< Unique ID counter for new individuals
+    RandomNumberGenerator searchSeeds_;        ///< Seeds of the generated solutions' searches
+    int numThreads_ = 0;                       ///< Threads for generating solutions, 0 = all
+
+    /// Parameters passed to every local search of generated solutions,
+    /// such as a ``"deadline"`` or ``"cancelToken"``.
+    std::unordered_map<std::string, std::any> searchParams_;
+
+    /// Dense similarity matrix indexed by Item::slot, row-major with
+    /// ``slotCapacity_`` columns. Slots of removed individuals are reused.
+    std::vector<double> similarity_;
+    size_t slotCapacity_ = 0;
+    std::vector<size_t> freeSlots_;
+    bool fitnessStale_ = true;                 ///< Population changed since updateFitness
+
+    /// Number of individuals per solution fingerprint, for O(1) duplicate
+    /// checks; a hit is confirmed by comparing the solutions.
+    std::unordered_map<uint64_t, int> fingerprints_;
+
+    /// Fingerprints of recently evaluated solutions, oldest first, and the
+    /// same fingerprints as a set; empty while the archive is disabled.
+    std::deque<uint64_t> tabuQueue_;
+    std::unordered_set<uint64_t> tabuArchive_;
+    size_t tabuArchiveSize_ = 0;               ///< Archive capacity, 0 = disabled
 
     static constexpr double ALPHA = 0.60;     ///< Fitness weight: (1-α)*cost + α*diversity
-    static constexpr size_t SIMILARITY_RESERVE_SIZE = 30;  ///< Preallocated similarity capacity
+    static constexpr size_t SIMILARITY_RESERVE_SIZE = 32;  ///< Initial similarity matrix size
+
+    double &similarity(size_t slot1, size_t slot2)
+    {
+        return similarity_[slot1 * slotCapacity_ + slot2];
+    }
+
+    /// Returns a free matrix slot, growing the matrix when all are taken.
+    size_t acquireSlot();
+
+    /// Removes every individual and frees all matrix slots.
+    void clearItems();
+
+    /**
+     * Appends an individual, given its similarity to every current one in
+     * population order, and updates the cached similarity sums.
+     */
+    void insertItem(Solution solution,
+                    ObjValue objValue,
+                    const std::vector<double> &similarities);
+
+    /**
+     * Draws ``count`` random feasible graphs and runs a local search on each,
+     * in parallel.
+     *
+     * The start graphs and search seeds are assigned in order on the calling
+     * thread, so the resulting graphs do not depend on the thread count.
+     */
+    std::vector<std::unique_ptr<Graph>> searchRandomGraphs(size_t count);
 
-    /// Updates the fitness values of all individuals based on cost and diversity
+    /**
+     * Perturbs a searched graph until its solution is not in the population,
+     * for at most a fixed number of attempts.
+     */
+    std::pair<Solution, ObjValue> makeNonDuplicate(Graph &graph) const;
+
+    /// Updates the fitness values of all individuals based on cost and
+    /// diversity; does nothing if the population is unchanged since the
+    /// last call.
     void updateFitness();
 
     /// Removes the worst solution from the population (typically lowest fitness)
     void removeWorstSolution();
 
+    /// Expands or rebuilds a variable population after idle generations.
+    void adaptSize(int num_idle_generations, bool verbose);
+
     /**
      * Compute Jaccard similarity between two solutions.
      *
@@ -99,19 +166,36 @@ private:
     double computeSimilarity(const Solution &sol1, const Solution &sol2) const
     {
         // Calculate Jaccard similarity between two solutions
-        int intersection = 0;
-        for (auto node : sol1)
-        {
-            if (sol2.find(node) != sol2.end())
-            {
-                intersection++;
-            }
-        }
+        const size_t intersection = sol1.intersectionSize(sol2);
         return static_cast<double>(intersection)
             / (sol1.size() + sol2.size() - intersection);
     }
 
 public:
+    /**
+     * Snapshot
+     *
+     * State of a population between two generations, as saved in
+     * checkpoints. Individuals are listed in population order; the
+     * similarity matrix is kept as its upper triangle in that order, so
+     * free matrix slots are not saved.
+     */
+    struct Snapshot
+    {
+        std::vector<std::vector<Node>> solutions;  ///< Members in insertion order
+        std::vector<ObjValue> objValues;
+        std::vector<double> fitness;
+        std::vector<uint64_t> ids;
+        std::vector<double> similaritySums;
+        std::vector<double> similarities;  ///< Pairs (i, j), i < j, row by row
+        bool fitnessStale = true;
+        uint64_t nextItemId = 0;
+        RandomNumberGenerator::State rng{};
+        RandomNumberGenerator::State searchSeeds{};
+        std::vector<uint64_t> tabuQueue;  ///< Archive fingerprints, oldest first
+        uint64_t tabuArchiveSize = 0;
+    };
+
     /**
      * Construct a Population instance.
      *
@@ -149,6 +233,7 @@ public:
           maxIdleGens_(max_idle_gens)
     {
         rng_->setSeed(seed);
+        searchSeeds_ = rng_->split();
         initPopSize_ = initial_pop_size;
         isVariablePopulation_ = is_pop_variable;
         search_ = search;
@@ -174,9 +259,9 @@ public:
      * Tuple[Solution, int]
      *     Pair of (best initial solution, its objective value)
      */
-    std::pair<Solution, int>
+    std::pair<Solution, ObjValue>
     initialize(bool display = false,
-            std::function<bool(int)> stopping_criterion = nullptr);
+            std::function<bool(ObjValue)> stopping_criterion = nullptr);
 
     /**
      * Update population with a new offspring solution.
@@ -197,10 +282,32 @@ public:
      *     Whether to print detailed information
      */
     void update(const Solution &solution,
-                int objValue,
+                ObjValue objValue,
                 int num_idle_generations,
                 bool verbose = false);
 
+    /**
+     * Update population with a batch of offspring solutions.
+     *
+     * All offspring join the population before the worst individuals are
+     * removed, one per offspring, and the population size is adapted once
+     * for the batch. Similarities to the population and between the
+     * offspring are computed once, in parallel. A batch of one is the same
+     * as :meth:`update`; an empty batch only adapts the size.
+     *
+     * Parameters
+     * ----------
+     * offspring : list[tuple[Solution, int]]
+     *     The offspring solutions with their objective values
+     * num_idle_generations : int
+     *     Number of generations without improvement
+     * verbose : bool, default=False
+     *     Whether to print detailed information
+     */
+    void updateBatch(const std::vector<std::pair<Solution, ObjValue>> &offspring,
+                     int num_idle_generations,
+                     bool verbose = false);
+
     /**
      * Add a solution directly to the population.
      *
@@ -211,7 +318,7 @@ public:
      * objValue : int
      *     Objective value of the solution
      */
-    void add(const Solution &solution, int objValue);
+    void add(const Solution &solution, ObjValue objValue);
 
     /**
      * Select two parent solutions using tournament selection.
@@ -269,6 +376,69 @@ public:
      */
     bool isDuplicate(const Solution &solution) const;
 
+    /**
+     * Set the capacity of the tabu archive of evaluated solutions.
+     *
+     * The archive remembers the fingerprints of the last ``size`` solutions
+     * passed to :meth:`markEvaluated`, so offspring that were evaluated
+     * before can be skipped. Shrinking the archive forgets the oldest ones.
+     *
+     * Parameters
+     * ----------
+     * size : int
+     *     Number of fingerprints kept; 0 (the default) disables the archive.
+     */
+    void setTabuArchiveSize(size_t size);
+
+    /**
+     * Record a solution as evaluated in the tabu archive.
+     *
+     * Only fingerprints are stored, so two different solutions sharing a
+     * 64-bit fingerprint are, with negligible probability, taken for the
+     * same one.
+     *
+     * Parameters
+     * ----------
+     * solution : Solution
+     *     The solution about to be evaluated
+     *
+     * Returns
+     * -------
+     * bool
+     *     False if the solution is already in the archive, true otherwise,
+     *     including when the archive is disabled.
+     */
+    bool markEvaluated(const Solution &solution);
+
+    /**
+     * Copy the state of the population.
+     *
+     * Returns
+     * -------
+     * Snapshot
+     *     Individuals, cached similarities, generators and tabu archive.
+     */
+    Snapshot snapshot() const;
+
+    /**
+     * Replace the state of the population by a snapshot.
+     *
+     * The population continues exactly as the one the snapshot was taken
+     * from, without searching any solution again. The parameters given to
+     * the constructor are not part of the snapshot.
+     *
+     * Parameters
+     * ----------
+     * snapshot : Snapshot
+     *     A snapshot of a population on the same graph.
+     *
+     * Raises
+     * ------
+     * std::invalid_argument
+     *     If the snapshot is inconsistent or has nodes outside the graph.
+     */
+    void restore(const Snapshot &snapshot);
+
     /**
      * Get the current population size.
      *
@@ -279,6 +449,35 @@ public:
      */
     size_t getSize() const;
 
+    /**
+     * Set the number of threads used to generate new solutions.
+     *
+     * Initialization, expansion and rebuilding run their local searches on
+     * this many threads. The generated solutions are the same for every
+     * thread count.
+     *
+     * Parameters
+     * ----------
+     * numThreads : int
+     *     Thread count; values below one (the default) use all hardware
+     *     threads.
+     */
+    void setNumThreads(int numThreads);
+
+    /**
+     * Set the parameters of the local searches that generate solutions.
+     *
+     * They are forwarded with :meth:`Search::setParam` to every search of
+     * initialization, expansion and rebuilding, so a ``"deadline"``,
+     * ``"timeLimit"`` or ``"cancelToken"`` also bounds those searches.
+     *
+     * Parameters
+     * ----------
+     * params : dict[str, Any]
+     *     Search parameters; empty (the default) runs unbounded searches.
+     */
+    void setSearchParams(std::unordered_map<std::string, std::any> params);
+
     /**
      * Generate a new solution that is not a duplicate.
      *
@@ -290,7 +489,7 @@ public:
      * Tuple[Solution, int]
      *     Pair of (new solution, its objective value)
      */
-    std::pair<Solution, int> generateNonDuplicateSolution();
+    std::pair<Solution, ObjValue> generateNonDuplicateSolution();
 
     /**
      * Expand the population with new diverse solutions.
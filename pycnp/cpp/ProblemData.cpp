@@ -1,7 +1,261 @@
 #include "ProblemData.h"
 #include "Graph/CNP_Graph.h"
 #include "Graph/DCNP_Graph.h"
+#include "MappedFile.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
 #include <cstring>
+#include <fstream>
+#include <limits>
+#include <utility>
+
+namespace
+{
+/**
+ * Cursor over the text of a graph file.
+ *
+ * Integers are parsed in place with ``std::from_chars``; line breaks are
+ * only crossed by :meth:`nextLine`, so callers can parse line by line.
+ */
+class TextScanner
+{
+public:
+    explicit TextScanner(std::string_view text)
+        : pos_(text.data()), end_(text.data() + text.size())
+    {
+    }
+
+    bool atEnd() const noexcept { return pos_ == end_; }
+
+    size_t lineNumber() const noexcept { return line_; }
+
+    /// Skips blanks and returns the next character on this line, or '\n'.
+    char peek() noexcept
+    {
+        while (pos_ != end_ && isBlank(*pos_))
+        {
+            ++pos_;
+        }
+        return pos_ == end_ ? '\n' : *pos_;
+    }
+
+    bool atLineEnd() noexcept { return peek() == '\n'; }
+
+    /// Moves to the start of the next line.
+    void nextLine() noexcept
+    {
+        const void *newline = std::memchr(pos_, '\n', end_ - pos_);
+        pos_ = newline ? static_cast<const char *>(newline) + 1 : end_;
+        line_++;
+    }
+
+    /// Skips blank lines and lines starting with a comment marker.
+    void skipComments(std::string_view markers) noexcept
+    {
+        while (!atEnd())
+        {
+            const char next = peek();
+            if (next != '\n' && markers.find(next) == std::string_view::npos)
+            {
+                return;
+            }
+            nextLine();
+        }
+    }
+
+    /// Skips one token on this line.
+    void skipToken() noexcept
+    {
+        peek();
+        while (pos_ != end_ && *pos_ != '\n' && !isBlank(*pos_))
+        {
+            ++pos_;
+        }
+    }
+
+    /// Skips ``c`` if it is the next character on this line.
+    void skip(char c) noexcept
+    {
+        if (peek() == c)
+        {
+            ++pos_;
+        }
+    }
+
+    /// Counts the tokens left on this line without consuming them.
+    size_t countTokens() const noexcept
+    {
+        TextScanner copy = *this;
+        size_t count = 0;
+        while (!copy.atLineEnd())
+        {
+            copy.skipToken();
+            count++;
+        }
+        return count;
+    }
+
+    /// Parses an integer; throws if the next token is not one.
+    long long readInt()
+    {
+        peek();
+        long long value = 0;
+        const auto [ptr, ec] = std::from_chars(pos_, end_, value);
+        if (ec != std::errc())
+        {
+            throw std::runtime_error("File format error: expected a number on line "
+                                     + std::to_string(line_));
+        }
+        pos_ = ptr;
+        return value;
+    }
+
+private:
+    const char *pos_;
+    const char *end_;
+    size_t line_ = 1;
+
+    static bool isBlank(char c) noexcept
+    {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+    }
+};
+
+constexpr std::string_view COMMENT_MARKERS = "#%c";
+
+Node readNode(TextScanner &scanner, long long numNodes)
+{
+    const long long node = scanner.readInt();
+    if (node < 0 || node >= numNodes)
+    {
+        throw std::runtime_error("Node index error: " + std::to_string(node)
+                                 + ", line number="
+                                 + std::to_string(scanner.lineNumber()));
+    }
+    return static_cast<Node>(node);
+}
+
+/**
+ * Header of a binary graph file. Positions are byte offsets from the start
+ * of the file, each a multiple of 8; ``treeSizesAt`` is 0 without sizes and
+ * ``nodeWeightsAt`` is 0 for unweighted data.
+ */
+struct BinaryHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrderMark;
+    uint64_t numNodes;
+    uint64_t numEntries;  ///< Length of the neighbor array
+    uint64_t numNodeIds;  ///< Length of the node id array
+    int64_t hopDistance;  ///< Hop distance of the tree sizes, 0 if none
+    uint64_t offsetsAt;   ///< uint64 row offsets, numNodes + 1 of them
+    uint64_t neighborsAt;  ///< int32 neighbors
+    uint64_t nodeIdsAt;    ///< int32 node ids
+    uint64_t treeSizesAt;  ///< uint32 K-hop tree member counts per node
+    uint64_t nodeWeightsAt;  ///< int32 node weights, numNodes of them
+};
+
+static_assert(sizeof(BinaryHeader) == 88);
+static_assert(sizeof(int) == sizeof(int32_t), "node weights are stored as int32");
+
+constexpr char BINARY_MAGIC[8] = {'P', 'Y', 'C', 'N', 'P', 'B', 'I', 'N'};
+constexpr uint32_t BINARY_VERSION = 2;  // 2: node weights
+constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+bool isBinaryGraph(std::string_view data)
+{
+    return data.size() >= sizeof(BINARY_MAGIC)
+           && std::memcmp(data.data(), BINARY_MAGIC, sizeof(BINARY_MAGIC)) == 0;
+}
+
+uint64_t alignSection(uint64_t position)
+{
+    return (position + 7) & ~uint64_t(7);
+}
+
+/// Keeps a mapped binary file, and offsets converted to size_t, alive.
+struct BinaryBacking
+{
+    MappedFile file;
+    std::vector<size_t> offsets;
+
+    explicit BinaryBacking(const std::string &filename) : file(filename) {}
+};
+
+/**
+ * Counts the members of the K-hop tree of every node: the node itself and
+ * all nodes within ``hopDistance`` hops through nodes of ``nodes``. Nodes
+ * outside ``nodes`` have empty trees.
+ */
+std::vector<uint32_t> countKHopMembers(const CSRGraph &topology,
+                                       const NodeSet &nodes,
+                                       int hopDistance)
+{
+    const size_t numNodes = static_cast<size_t>(topology.numNodes());
+    std::vector<uint8_t> active(numNodes, 0);
+    for (Node node : nodes)
+    {
+        active[node] = 1;
+    }
+
+    std::vector<uint32_t> sizes(numNodes, 0);
+    ThreadPool::instance().parallelFor(
+        numNodes,
+        ThreadPool::resolveThreads(0),
+        [&](size_t begin, size_t end, size_t)
+        {
+            std::vector<int> level(numNodes, -1);
+            std::vector<Node> queue;
+            for (size_t root = begin; root < end; ++root)
+            {
+                if (!active[root])
+                {
+                    continue;
+                }
+
+                queue.assign(1, static_cast<Node>(root));
+                level[root] = 0;
+                for (size_t head = 0; head < queue.size(); ++head)
+                {
+                    const Node node = queue[head];
+                    if (level[node] >= hopDistance)
+                    {
+                        continue;
+                    }
+                    for (Node neighbor : topology.neighbors(node))
+                    {
+                        if (active[neighbor] && level[neighbor] < 0)
+                        {
+                            level[neighbor] = level[node] + 1;
+                            queue.push_back(neighbor);
+                        }
+                    }
+                }
+
+                sizes[root] = static_cast<uint32_t>(queue.size());
+                for (Node node : queue)
+                {
+                    level[node] = -1;
+                }
+            }
+        });
+    return sizes;
+}
+
+NodeSet allNodes(int numNodes)
+{
+    NodeSet nodes;
+    nodes.reserve(numNodes);
+    for (Node node = 0; node < numNodes; ++node)
+    {
+        nodes.insert(node);
+    }
+    return nodes;
+}
+}  // namespace
 
 ProblemData::ProblemData(int num)
 {
@@ -10,161 +264,580 @@ ProblemData::ProblemData(int num)
     adjList_.resize(num);
 }
 
+ProblemData::ProblemData(NodeSet nodes, std::shared_ptr<const CSRGraph> topology)
+    : numNodes_(topology->numNodes()),
+      nodesSet_(std::move(nodes)),
+      adjListStale_(true),
+      topology_(std::move(topology))
+{
+}
+
+void ProblemData::materializeAdjList() const
+{
+    if (!adjListStale_)
+    {
+        return;
+    }
+
+    adjList_.assign(numNodes_, NodeSet());
+    for (Node node = 0; node < numNodes_; ++node)
+    {
+        const auto neighbors = topology_->neighbors(node);
+        adjList_[node].insert(neighbors.begin(), neighbors.end());
+    }
+    adjListStale_ = false;
+}
+
 void ProblemData::addNode(Node node)
 {
+    std::lock_guard<std::mutex> lock(topologyMutex_.mutex);
+    materializeAdjList();
     nodesSet_.insert(node);
+    topology_.reset();
+    treeSizesHop_ = 0;
 }
 
 void ProblemData::addEdge(Node u, Node v)
 {
+    std::lock_guard<std::mutex> lock(topologyMutex_.mutex);
+    materializeAdjList();
     adjList_[u].insert(v);
     adjList_[v].insert(u);
+    topology_.reset();
+    treeSizesHop_ = 0;
+}
+
+void ProblemData::addNodeWeight(Node node, int weight)
+{
+    if (node < 0 || node >= numNodes_)
+    {
+        throw std::invalid_argument("Node index error: " + std::to_string(node));
+    }
+    if (weight < 0)
+    {
+        throw std::invalid_argument("Node weights must be non-negative");
+    }
+    if (nodeWeights_.empty())
+    {
+        nodeWeights_.assign(numNodes_, 1);
+    }
+    nodeWeights_[node] = weight;
+}
+
+int ProblemData::getNodeWeight(Node node) const
+{
+    if (node < 0 || node >= numNodes_)
+    {
+        throw std::invalid_argument("Node index error: " + std::to_string(node));
+    }
+    return nodeWeights_.empty() ? 1 : nodeWeights_[node];
+}
+
+void ProblemData::readNodeWeightsFromFile(const std::string &filename)
+{
+    const MappedFile file(filename);
+    TextScanner scanner(file.data());
+    while (true)
+    {
+        scanner.skipComments(COMMENT_MARKERS);
+        if (scanner.atEnd())
+        {
+            break;
+        }
+
+        const Node node = readNode(scanner, numNodes_);
+        const long long weight = scanner.readInt();
+        if (weight < 0 || weight > std::numeric_limits<int>::max())
+        {
+            throw std::runtime_error("File format error: invalid weight on line "
+                                     + std::to_string(scanner.lineNumber()));
+        }
+        addNodeWeight(node, static_cast<int>(weight));
+        scanner.nextLine();
+    }
+}
+
+ProblemData ProblemData::readFromFile(const std::string &filename)
+{
+    const MappedFile file(filename);
+    if (isBinaryGraph(file.data()))
+    {
+        return loadBinary(filename);
+    }
+
+    TextScanner scanner(file.data());
+    scanner.skipComments(COMMENT_MARKERS);
+
+    if (scanner.peek() == 'p')
+    {
+        return parseDimacsEdgeList(file.data());
+    }
+    if (scanner.countTokens() == 1)
+    {
+        return parseAdjacencyList(file.data());
+    }
+    return parsePlainEdgeList(file.data());
 }
 
 ProblemData ProblemData::readFromAdjacencyListFile(const std::string &filename)
 {
-    std::ifstream file(filename);
+    const MappedFile file(filename);
+    return parseAdjacencyList(file.data());
+}
+
+ProblemData ProblemData::readFromEdgeListFormat(const std::string &filename)
+{
+    const MappedFile file(filename);
+    return parseDimacsEdgeList(file.data());
+}
+
+void ProblemData::saveBinary(const std::string &filename, int hopDistance) const
+{
+    if (hopDistance < 0)
+    {
+        throw std::invalid_argument("hopDistance must be non-negative");
+    }
+
+    const auto topology = getTopology();
+    const auto offsets = topology->offsets();
+    const auto neighbors = topology->neighborArray();
+
+    std::vector<Node> nodeIds(nodesSet_.begin(), nodesSet_.end());
+    std::sort(nodeIds.begin(), nodeIds.end());
+    if (!nodeIds.empty()
+        && (nodeIds.front() < 0 || nodeIds.back() >= topology->numNodes()))
+    {
+        throw std::runtime_error("Cannot save node ids outside [0, numNodes)");
+    }
+
+    std::vector<uint32_t> treeSizes;
+    if (hopDistance > 0)
+    {
+        treeSizes = countKHopMembers(*topology, nodesSet_, hopDistance);
+    }
+
+    BinaryHeader header{};
+    std::memcpy(header.magic, BINARY_MAGIC, sizeof(BINARY_MAGIC));
+    header.version = BINARY_VERSION;
+    header.byteOrderMark = BYTE_ORDER_MARK;
+    header.numNodes = static_cast<uint64_t>(topology->numNodes());
+    header.numEntries = neighbors.size();
+    header.numNodeIds = nodeIds.size();
+    header.hopDistance = hopDistance;
+    header.offsetsAt = alignSection(sizeof(BinaryHeader));
+    header.neighborsAt
+        = alignSection(header.offsetsAt + offsets.size() * sizeof(uint64_t));
+    header.nodeIdsAt
+        = alignSection(header.neighborsAt + neighbors.size() * sizeof(Node));
+    if (hopDistance > 0)
+    {
+        header.treeSizesAt
+            = alignSection(header.nodeIdsAt + nodeIds.size() * sizeof(Node));
+    }
+    if (!nodeWeights_.empty())
+    {
+        const uint64_t end = hopDistance > 0
+                                 ? header.treeSizesAt + treeSizes.size() * sizeof(uint32_t)
+                                 : header.nodeIdsAt + nodeIds.size() * sizeof(Node);
+        header.nodeWeightsAt = alignSection(end);
+    }
+
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
     if (!file.is_open())
     {
-        throw std::runtime_error("Cannot open file: " + filename);
+        throw std::runtime_error("Cannot open file for writing: " + filename);
     }
 
-    int numNodes;
-    file >> numNodes;
-    if (file.eof())
+    auto writeAt = [&file](uint64_t position, const void *data, size_t bytes)
     {
-        throw std::runtime_error("File format error: empty file");
+        static constexpr char PADDING[8] = {};
+        const auto current = static_cast<uint64_t>(file.tellp());
+        file.write(PADDING, static_cast<std::streamsize>(position - current));
+        file.write(static_cast<const char *>(data),
+                   static_cast<std::streamsize>(bytes));
+    };
+
+    const std::vector<uint64_t> fileOffsets(offsets.begin(), offsets.end());
+    writeAt(0, &header, sizeof(header));
+    writeAt(header.offsetsAt, fileOffsets.data(), fileOffsets.size() * sizeof(uint64_t));
+    writeAt(header.neighborsAt, neighbors.data(), neighbors.size() * sizeof(Node));
+    writeAt(header.nodeIdsAt, nodeIds.data(), nodeIds.size() * sizeof(Node));
+    if (hopDistance > 0)
+    {
+        writeAt(header.treeSizesAt, treeSizes.data(), treeSizes.size() * sizeof(uint32_t));
+    }
+    if (!nodeWeights_.empty())
+    {
+        writeAt(header.nodeWeightsAt,
+                nodeWeights_.data(),
+                nodeWeights_.size() * sizeof(int32_t));
+    }
+
+    file.close();
+    if (!file)
+    {
+        throw std::runtime_error("Cannot write file: " + filename);
     }
+}
+
+ProblemData ProblemData::loadBinary(const std::string &filename)
+{
+    auto backing = std::make_shared<BinaryBacking>(filename);
+    const std::string_view data = backing->file.data();
 
-    ProblemData problemData(numNodes);
+    auto invalid = [&filename](const std::string &reason)
+    { return std::runtime_error("Invalid binary graph file " + filename + ": " + reason); };
 
-    for (int v1 = 0; v1 < numNodes; v1++)
+    if (data.size() < sizeof(BinaryHeader) || !isBinaryGraph(data))
     {
-        int node;
-        file >> node;
+        throw invalid("missing header");
+    }
 
-        problemData.nodesSet_.insert(node);
+    BinaryHeader header;
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (header.byteOrderMark != BYTE_ORDER_MARK)
+    {
+        throw invalid("written with another byte order");
+    }
+    if (header.version != BINARY_VERSION)
+    {
+        throw invalid("unsupported version " + std::to_string(header.version));
+    }
+    if (header.numNodes > static_cast<uint64_t>(std::numeric_limits<Node>::max())
+        || header.hopDistance < 0)
+    {
+        throw invalid("bad header");
+    }
 
-        char c;
-        while ((c = file.get()) != ':' && std::isspace(c))
-            ;
-        bool nextLine = false;
+    // Returns the section at ``position``, checking that it fits the file.
+    auto section = [&](uint64_t position, uint64_t count, size_t elementSize)
+    {
+        if (position % 8 != 0 || position > data.size()
+            || count > (data.size() - position) / elementSize)
+        {
+            throw invalid("section out of bounds");
+        }
+        return data.data() + position;
+    };
+
+    const Node numNodes = static_cast<Node>(header.numNodes);
+    const auto *fileOffsets = reinterpret_cast<const uint64_t *>(
+        section(header.offsetsAt, header.numNodes + 1, sizeof(uint64_t)));
+    const auto *neighbors = reinterpret_cast<const Node *>(
+        section(header.neighborsAt, header.numEntries, sizeof(Node)));
+    const auto *nodeIds = reinterpret_cast<const Node *>(
+        section(header.nodeIdsAt, header.numNodeIds, sizeof(Node)));
+
+    if (fileOffsets[0] != 0 || fileOffsets[numNodes] != header.numEntries)
+    {
+        throw invalid("bad offsets");
+    }
+    for (Node node = 0; node < numNodes; ++node)
+    {
+        if (fileOffsets[node + 1] < fileOffsets[node])
+        {
+            throw invalid("bad offsets");
+        }
+    }
+    for (uint64_t i = 0; i < header.numEntries; ++i)
+    {
+        if (neighbors[i] < 0 || neighbors[i] >= numNodes)
+        {
+            throw invalid("neighbor out of range");
+        }
+    }
 
-        while (!file.eof() && !nextLine)
+    NodeSet nodes;
+    nodes.reserve(header.numNodeIds);
+    for (uint64_t i = 0; i < header.numNodeIds; ++i)
+    {
+        if (nodeIds[i] < 0 || nodeIds[i] >= numNodes)
         {
+            throw invalid("node id out of range");
+        }
+        nodes.insert(nodeIds[i]);
+    }
 
-            while (std::isspace(file.peek()))
-            {
-                nextLine = (file.get() == '\n');
-            }
-            if (!nextLine)
-            {
-                int node2;
-                file >> node2;
+    size_t treeMembers = 0;
+    if (header.hopDistance > 0)
+    {
+        const auto *treeSizes = reinterpret_cast<const uint32_t *>(
+            section(header.treeSizesAt, header.numNodes, sizeof(uint32_t)));
+        for (Node node = 0; node < numNodes; ++node)
+        {
+            treeMembers += treeSizes[node];
+        }
+    }
 
-                problemData.adjList_[node].insert(node2);
+    // The offsets are used in place where size_t is 64 bits wide.
+    std::span<const size_t> offsets;
+    if constexpr (sizeof(size_t) == sizeof(uint64_t))
+    {
+        offsets = {reinterpret_cast<const size_t *>(fileOffsets),
+                   static_cast<size_t>(numNodes) + 1};
+    }
+    else
+    {
+        backing->offsets.assign(fileOffsets, fileOffsets + numNodes + 1);
+        offsets = backing->offsets;
+    }
+    std::span<const Node> neighborSpan(neighbors, header.numEntries);
+
+    ProblemData problemData(
+        std::move(nodes),
+        std::make_shared<const CSRGraph>(offsets, neighborSpan, std::move(backing)));
+    problemData.treeSizesHop_ = static_cast<int>(std::min<int64_t>(
+        header.hopDistance, std::numeric_limits<int>::max()));
+    problemData.treeMembers_ = treeMembers;
+    if (header.nodeWeightsAt != 0)
+    {
+        const auto *weights = reinterpret_cast<const int32_t *>(
+            section(header.nodeWeightsAt, header.numNodes, sizeof(int32_t)));
+        for (Node node = 0; node < numNodes; ++node)
+        {
+            if (weights[node] < 0)
+            {
+                throw invalid("negative node weight");
             }
         }
+        problemData.nodeWeights_.assign(weights, weights + numNodes);
     }
-    file.close();
     return problemData;
 }
 
-ProblemData ProblemData::readFromEdgeListFormat(const std::string &filename)
+ProblemData ProblemData::parseAdjacencyList(std::string_view text)
 {
-    std::ifstream file(filename);
-    if (!file.is_open())
+    TextScanner scanner(text);
+    scanner.skipComments(COMMENT_MARKERS);
+    if (scanner.atEnd())
     {
-        throw std::runtime_error("Cannot open file: " + filename);
+        throw std::runtime_error("File format error: empty file");
     }
 
-    char bidon[50];
-    char StrReading[100];
-    file >> StrReading;
-
-    if (file.eof())
+    const long long numNodes = scanner.readInt();
+    if (numNodes < 0 || numNodes > std::numeric_limits<Node>::max())
     {
-        throw std::runtime_error("File format error: empty file");
+        throw std::runtime_error("File format error: invalid node count "
+                                 + std::to_string(numNodes));
     }
+    scanner.nextLine();
 
-    int numNodes = 0;
-    int numEdges = 0;
+    NodeSet nodes;
+    nodes.reserve(numNodes);
+    std::vector<std::pair<Node, Node>> arcs;
+    arcs.reserve(text.size() / 4);
 
-    while (!file.eof())
+    while (true)
     {
-        if (strcmp(StrReading, "p") == 0)
+        scanner.skipComments(COMMENT_MARKERS);
+        if (scanner.atEnd())
         {
-
-            file >> bidon >> numNodes >> numEdges;
             break;
         }
-        file >> StrReading;
+
+        const Node node = readNode(scanner, numNodes);
+        nodes.insert(node);
+        scanner.skip(':');
+        while (!scanner.atLineEnd())
+        {
+            arcs.emplace_back(node, readNode(scanner, numNodes));
+        }
+        scanner.nextLine();
     }
 
-    ProblemData problemData(numNodes);
+    return ProblemData(std::move(nodes),
+                       std::make_shared<const CSRGraph>(
+                           static_cast<int>(numNodes), arcs, false));
+}
 
-    for (int i = 0; i < numNodes; i++)
+ProblemData ProblemData::parseDimacsEdgeList(std::string_view text)
+{
+    TextScanner scanner(text);
+    if (scanner.atEnd())
     {
-        problemData.nodesSet_.insert(i);
+        throw std::runtime_error("File format error: empty file");
     }
 
-    int x1, x2;
-    int linecount = 0;
+    while (!scanner.atEnd() && scanner.peek() != 'p')
+    {
+        scanner.nextLine();
+    }
+    if (scanner.atEnd())
+    {
+        throw std::runtime_error("File format error: missing 'p' line");
+    }
 
-    while (!file.eof())
+    scanner.skipToken();  // "p"
+    scanner.skipToken();  // "edge"
+    const long long numNodes = scanner.readInt();
+    const long long numEdges = scanner.readInt();
+    if (numNodes < 0 || numNodes > std::numeric_limits<Node>::max() || numEdges < 0)
     {
-        if (strcmp(StrReading, "e") == 0)
+        throw std::runtime_error("File format error: invalid 'p' line");
+    }
+    scanner.nextLine();
+
+    std::vector<std::pair<Node, Node>> arcs;
+    arcs.reserve(numEdges);
+    while (!scanner.atEnd())
+    {
+        if (scanner.peek() == 'e')
         {
+            scanner.skipToken();
+            const Node u = readNode(scanner, numNodes);
+            const Node v = readNode(scanner, numNodes);
+            arcs.emplace_back(u, v);
+        }
+        scanner.nextLine();
+    }
 
-            file >> x1 >> x2;
-            linecount++;
+    return ProblemData(allNodes(static_cast<int>(numNodes)),
+                       std::make_shared<const CSRGraph>(
+                           static_cast<int>(numNodes), arcs, true));
+}
 
-            if (x1 < 0 || x2 < 0 || x1 >= numNodes || x2 >= numNodes)
-            {
-                throw std::runtime_error(
-                    "Node index error: x1=" + std::to_string(x1)
-                    + ", x2=" + std::to_string(x2)
-                    + ", line number=" + std::to_string(linecount));
-            }
+ProblemData ProblemData::parsePlainEdgeList(std::string_view text)
+{
+    TextScanner scanner(text);
+    std::vector<std::pair<Node, Node>> arcs;
+    arcs.reserve(text.size() / 8);
 
-            problemData.adjList_[x1].insert(x2);
-            problemData.adjList_[x2].insert(x1);
+    long long maxNode = -1;
+    while (true)
+    {
+        scanner.skipComments(COMMENT_MARKERS);
+        if (scanner.atEnd())
+        {
+            break;
         }
-        file >> StrReading;
+
+        const Node u = readNode(scanner, std::numeric_limits<Node>::max());
+        const Node v = readNode(scanner, std::numeric_limits<Node>::max());
+        arcs.emplace_back(u, v);
+        maxNode = std::max<long long>(maxNode, std::max(u, v));
+        scanner.nextLine();
     }
 
-    file.close();
+    if (arcs.empty())
+    {
+        throw std::runtime_error("File format error: empty file");
+    }
 
-    return problemData;
+    const int numNodes = static_cast<int>(maxNode + 1);
+    return ProblemData(allNodes(numNodes),
+                       std::make_shared<const CSRGraph>(numNodes, arcs, true));
 }
 
 std::unique_ptr<Graph> ProblemData::createOriginalGraph(
-    const std::string &problemType, int numToRemove, int seed, int hop_distance) const
+    const std::string &problemType,
+    int numToRemove,
+    int seed,
+    int hop_distance,
+    const std::string &treeStorage,
+    bool kernelize) const
 {
-    if (problemType == "CNP")
+    const bool isCNP = isCNPProblemType(problemType);
+    if (!isCNP && problemType != "DCNP")
     {
+        throw std::runtime_error("Unknown problem type: " + problemType);
+    }
+    if (numToRemove > static_cast<int>(nodesSet_.size()))
+    {
+        throw std::runtime_error("The number of nodes to remove cannot be greater than the total number of nodes");
+    }
 
-        if (numToRemove > static_cast<int>(nodesSet_.size()))
+    Kernel kernel;
+    const NodeSet *nodes = &nodesSet_;
+    if (kernelize && (problemType == "CNP" || problemType == "DCNP"))
+    {
+        kernel = computeKernel(problemType);
+        if (static_cast<int>(kernel.nodes.size()) >= numToRemove)
+        {
+            nodes = &kernel.nodes;
+        }
+        else
         {
-            throw std::runtime_error("The number of nodes to remove cannot be greater than the total number of nodes");
+            kernel.weights = nullptr;
         }
-        return std::make_unique<Graph>(
-            std::make_unique<CNP_Graph>(nodesSet_, adjList_, numToRemove, seed));
     }
-    else if (problemType == "DCNP")
+
+    if (isCNP)
     {
+        const ObjectiveKind objective = objectiveKindOf(problemType);
+        auto weights = kernel.weights;
+        if (objective == ObjectiveKind::WeightedPairwise && !nodeWeights_.empty())
+        {
+            weights = std::make_shared<const std::vector<int>>(nodeWeights_);
+        }
+        return std::make_unique<Graph>(std::make_unique<CNP_Graph>(
+            *nodes, getTopology(), numToRemove, seed, weights, objective));
+    }
+
+    // Stored tree sizes settle the automatic layout before the trees are
+    // built.
+    TreeStorage storage = parseTreeStorage(treeStorage);
+    if (storage == TreeStorage::Auto && treeSizesHop_ > 0
+        && treeSizesHop_ == hop_distance)
+    {
+        storage = KHopTrees::autoStorage(numNodes_, treeMembers_);
+    }
+    return std::make_unique<Graph>(std::make_unique<DCNP_Graph>(
+        *nodes, hop_distance, getTopology(), numToRemove, seed, storage));
+}
+
+ProblemData::Kernel ProblemData::computeKernel(const std::string &problemType) const
+{
+    const auto topology = getTopology();
+    const int numNodes = topology->numNodes();
 
-        if (numToRemove > static_cast<int>(nodesSet_.size()))
+    std::vector<char> inSet(numNodes, 0);
+    for (Node node : nodesSet_)
+    {
+        inSet[node] = 1;
+    }
+
+    // Degrees within the node set, and the neighbour of degree-one nodes.
+    std::vector<int> degree(numNodes, 0);
+    std::vector<Node> neighborOf(numNodes, INVALID_NODE);
+    for (Node node : nodesSet_)
+    {
+        for (Node neighbor : topology->neighbors(node))
         {
-            throw std::runtime_error("The number of nodes to remove cannot be greater than the total number of nodes");
+            if (neighbor != node && inSet[neighbor])
+            {
+                degree[node]++;
+                neighborOf[node] = neighbor;
+            }
         }
-        return std::make_unique<Graph>(std::make_unique<DCNP_Graph>(
-            nodesSet_, hop_distance, adjList_, numToRemove, seed));
     }
-    else
+
+    const bool foldLeaves = problemType == "CNP";
+    std::vector<int> weights;
+    if (foldLeaves)
     {
-        throw std::runtime_error("Unknown problem type: " + problemType);
+        weights.assign(numNodes, 1);
+    }
+
+    Kernel kernel;
+    for (Node node : nodesSet_)
+    {
+        if (degree[node] == 0)
+        {
+            continue;
+        }
+        if (foldLeaves && degree[node] == 1 && degree[neighborOf[node]] >= 2)
+        {
+            weights[neighborOf[node]]++;
+            continue;
+        }
+        kernel.nodes.insert(node);
     }
+
+    if (foldLeaves)
+    {
+        kernel.weights = std::make_shared<const std::vector<int>>(std::move(weights));
+    }
+    return kernel;
 }
 
 int ProblemData::numNodes() const
@@ -179,5 +852,17 @@ NodeSet ProblemData::getNodesSet() const
 
 const std::vector<NodeSet> &ProblemData::getAdjList() const
 {
+    std::lock_guard<std::mutex> lock(topologyMutex_.mutex);
+    materializeAdjList();
     return adjList_;
 }
+
+std::shared_ptr<const CSRGraph> ProblemData::getTopology() const
+{
+    std::lock_guard<std::mutex> lock(topologyMutex_.mutex);
+    if (!topology_)
+    {
+        topology_ = std::make_shared<const CSRGraph>(adjList_);
+    }
+    return topology_;
+}
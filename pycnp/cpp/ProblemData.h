@@ -2,10 +2,13 @@
 #define PROBLEMDATA_H
 
 #include <fstream>
+#include "Graph/CSRGraph.h"
 #include "Graph/Graph.h"
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <unordered_set>
 #include <vector>
 
@@ -21,7 +24,48 @@ class ProblemData
 private:
     int numNodes_;
     NodeSet nodesSet_;
-    std::vector<NodeSet> adjList_;
+
+    /// Adjacency sets. Instances loaded from a file start from the CSR
+    /// alone; the sets are then built only when asked for or modified.
+    mutable std::vector<NodeSet> adjList_;
+    mutable bool adjListStale_ = false;
+
+    /// CSR view of adjList_, built on first use and shared by all graphs
+    /// created from this instance. Reset whenever the graph is modified.
+    mutable std::shared_ptr<const CSRGraph> topology_;
+
+    /// Guards ``topology_`` and ``adjList_``, so graphs can be created from
+    /// several threads. Copies get a fresh mutex rather than sharing the
+    /// original's.
+    struct TopologyMutex
+    {
+        std::mutex mutex;
+
+        TopologyMutex() = default;
+        TopologyMutex(const TopologyMutex &) {}
+        TopologyMutex &operator=(const TopologyMutex &) { return *this; }
+    };
+
+    mutable TopologyMutex topologyMutex_;
+
+    /// Hop distance of the K-hop tree sizes loaded from a binary file, or 0,
+    /// and the total number of tree members for that distance.
+    int treeSizesHop_ = 0;
+    size_t treeMembers_ = 0;
+
+    /// Node weights of the weighted objective; empty or unset entries
+    /// weigh one.
+    std::vector<int> nodeWeights_;
+
+    /// Creates an instance from its nodes and a ready CSR adjacency.
+    ProblemData(NodeSet nodes, std::shared_ptr<const CSRGraph> topology);
+
+    /// Builds ``adjList_`` from ``topology_`` if stale; caller holds the lock.
+    void materializeAdjList() const;
+
+    static ProblemData parseAdjacencyList(std::string_view text);
+    static ProblemData parseDimacsEdgeList(std::string_view text);
+    static ProblemData parsePlainEdgeList(std::string_view text);
 
 public:
 
@@ -35,10 +79,48 @@ public:
      */
     ProblemData(int num);
 
+    /**
+     * Reads problem data from a graph file, detecting its format.
+     *
+     * Three text formats are understood, each optionally gzip-compressed:
+     *
+     * - Adjacency list: the node count on the first line, then one line
+     *   ``node: neighbor neighbor ...`` per node.
+     * - DIMACS edge list: a ``p edge <nodes> <edges>`` line and one
+     *   ``e <u> <v>`` line per edge, with 0-based node ids.
+     * - Plain edge list: one ``<u> <v>`` pair per line, as in SNAP files;
+     *   further columns are ignored and the node count is the largest id
+     *   plus one.
+     *
+     * Binary files written by :meth:`saveBinary` are recognised by their
+     * magic bytes. Lines starting with ``#``, ``%`` or ``c`` before the
+     * first data line are comments. A first line holding a single number marks an
+     * adjacency list, one starting with ``p`` a DIMACS file. The file is
+     * memory-mapped and parsed with ``std::from_chars`` straight into the
+     * CSR adjacency.
+     *
+     * Parameters
+     * ----------
+     * filename : str
+     *     Path to the graph file.
+     *
+     * Returns
+     * -------
+     * ProblemData
+     *     The loaded problem data.
+     *
+     * Raises
+     * ------
+     * RuntimeError
+     *     If the file cannot be read or a node id is out of range.
+     */
+    static ProblemData readFromFile(const std::string &filename);
+
     /**
      * Reads problem data from an adjacency list format file.
      *
      * Adjacency list format: each line represents a node and its neighbors.
+     * The file may be gzip-compressed.
      *
      * Parameters
      * ----------
@@ -56,7 +138,7 @@ public:
      * Reads problem data from an edge list format file.
      *
      * Edge list format: contains a header line with node/edge counts,
-     * followed by edge definitions.
+     * followed by edge definitions. The file may be gzip-compressed.
      *
      * Parameters
      * ----------
@@ -70,6 +152,60 @@ public:
      */
     static ProblemData readFromEdgeListFormat(const std::string &filename);
 
+    /**
+     * Writes the problem data to a binary graph file.
+     *
+     * The file holds a versioned header, the CSR offsets and neighbors, the
+     * node ids, the node weights of weighted data and, optionally, the
+     * K-hop tree size of every node for one hop distance. All sections are 8-byte aligned, so
+     * :meth:`loadBinary` can use them in place from a read-only mapping,
+     * which concurrent processes share through the page cache. Graphs
+     * created for DCNP with that hop distance and ``"auto"`` tree storage
+     * then pick their tree layout from the stored sizes instead of
+     * building sparse trees first and converting them.
+     *
+     * Parameters
+     * ----------
+     * filename : str
+     *     Path of the file to write.
+     * hopDistance : int, default=0
+     *     Hop distance to precompute the K-hop tree sizes for; 0 stores
+     *     none.
+     *
+     * Raises
+     * ------
+     * ValueError
+     *     If ``hopDistance`` is negative.
+     * RuntimeError
+     *     If the file cannot be written.
+     */
+    void saveBinary(const std::string &filename, int hopDistance = 0) const;
+
+    /**
+     * Loads problem data from a binary graph file.
+     *
+     * The file is memory-mapped and its CSR arrays are used in place; only
+     * the node set is copied. The arrays are checked before use, so a
+     * truncated or corrupt file raises instead of crashing.
+     *
+     * Parameters
+     * ----------
+     * filename : str
+     *     Path to a file written by :meth:`saveBinary`.
+     *
+     * Returns
+     * -------
+     * ProblemData
+     *     The loaded problem data.
+     *
+     * Raises
+     * ------
+     * RuntimeError
+     *     If the file cannot be read, has another version or byte order,
+     *     or is malformed.
+     */
+    static ProblemData loadBinary(const std::string &filename);
+
     /**
      * Returns the number of nodes in the problem data.
      *
@@ -100,6 +236,20 @@ public:
      */
     const std::vector<NodeSet> &getAdjList() const;
 
+    /**
+     * Returns the shared CSR adjacency of the graph.
+     *
+     * The structure is built once on first use and then shared, read-only,
+     * by every graph created through :meth:`createOriginalGraph`. Safe to
+     * call from several threads, as long as none modifies the graph.
+     *
+     * Returns
+     * -------
+     * CSRGraph
+     *     Shared pointer to the immutable CSR adjacency.
+     */
+    std::shared_ptr<const CSRGraph> getTopology() const;
+
     /**
      * Adds a node to the problem data.
      *
@@ -122,6 +272,53 @@ public:
      */
     void addEdge(Node u, Node v);
 
+    /**
+     * Sets the weight of a node, used by the weighted ("WCNP") objective.
+     *
+     * Nodes without a weight weigh one.
+     *
+     * Parameters
+     * ----------
+     * node : Node
+     *     The ID of the node.
+     * weight : int
+     *     The non-negative weight of the node.
+     *
+     * Raises
+     * ------
+     * std::invalid_argument
+     *     If the node is out of range or the weight negative.
+     */
+    void addNodeWeight(Node node, int weight);
+
+    /**
+     * Returns the weight of a node, or one if none was set.
+     *
+     * Parameters
+     * ----------
+     * node : Node
+     *     The ID of the node.
+     */
+    int getNodeWeight(Node node) const;
+
+    /**
+     * Reads node weights from a text file of ``node weight`` lines.
+     *
+     * Lines starting with ``#``, ``%`` or ``c`` are comments. Nodes not
+     * listed keep their weight.
+     *
+     * Parameters
+     * ----------
+     * filename : str
+     *     Path to the weight file.
+     *
+     * Raises
+     * ------
+     * std::runtime_error
+     *     If the file cannot be read or is malformed.
+     */
+    void readNodeWeightsFromFile(const std::string &filename);
+
     /**
      * Creates an original graph from the problem data.
      *
@@ -130,13 +327,24 @@ public:
      * Parameters
      * ----------
      * problemType : str
-     *     The type of problem ("CNP" or "DCNP").
+     *     The type of problem: "DCNP", or one of the CNP objectives "CNP",
+     *     "WCNP" (node-weighted pairs), "MINMAXC" (largest component) and
+     *     "MAXNUM" (number of components).
      * numToRemove : int
      *     The number of nodes to remove.
      * seed : int
      *     Random seed for reproducibility.
      * hop_distance : int
      *     Maximum hop distance for DCNP.
+     * treeStorage : str
+     *     K-hop tree storage for DCNP: ``"auto"``, ``"dense"``, ``"bitset"``
+     *     or ``"sparse"``. Ignored for CNP.
+     * kernelize : bool
+     *     Whether to search the kernel of the instance (see computeKernel)
+     *     instead of all its nodes. The objective and solutions keep
+     *     referring to the full instance. Ignored if the kernel has fewer
+     *     nodes than the budget, and for the CNP objectives other than
+     *     "CNP", which the reduction does not preserve.
      *
      * Returns
      * -------
@@ -146,7 +354,44 @@ public:
     std::unique_ptr<Graph> createOriginalGraph(const std::string &problemType,
                                                int numToRemove,
                                                int seed,
-                                               int hop_distance) const;
+                                               int hop_distance,
+                                               const std::string &treeStorage
+                                               = "auto",
+                                               bool kernelize = false) const;
+
+    /// Nodes left by a reduction, with the weights that keep the objective.
+    struct Kernel
+    {
+        NodeSet nodes;  ///< Nodes the search may remove
+        std::shared_ptr<const std::vector<int>> weights;  ///< CNP only, else null
+    };
+
+    /**
+     * Drops the nodes that some optimal solution never removes.
+     *
+     * Isolated nodes take part in no pair, so they are dropped for both
+     * problems. For CNP, a leaf whose neighbour has further neighbours is
+     * dropped as well, because removing the neighbour instead separates at
+     * least as many pairs. The leaf's weight is added to its neighbour, so
+     * components of the kernel count the pairs of the full instance. A
+     * single pass is made: a folded neighbour is no longer dominated by
+     * its own neighbours, so deeper tree fringes are kept. For DCNP, pairs
+     * depend on hop distances and leaves are kept.
+     *
+     * Node ids are unchanged, so solutions of the kernel are solutions of
+     * the instance.
+     *
+     * Parameters
+     * ----------
+     * problemType : str
+     *     The type of problem ("CNP" or "DCNP").
+     *
+     * Returns
+     * -------
+     * Kernel
+     *     Remaining nodes, and for CNP their weights.
+     */
+    Kernel computeKernel(const std::string &problemType) const;
 };
 
 #endif  // PROBLEMDATA_H
@@ -0,0 +1,180 @@
+#ifndef PROGRESS_QUEUE_H
+#define PROGRESS_QUEUE_H
+
+#include "Graph/Solution.h"
+#include "Graph/Types.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+/// One improvement of the best solution of a run or search.
+struct ProgressEvent
+{
+    ObjValue objValue = 0;     ///< Objective value of the new best solution
+    double time = 0;           ///< Seconds since the run or search started
+    uint64_t fingerprint = 0;  ///< Solution::fingerprint() of the solution
+    int source = 0;            ///< Reporting island; 0 for a single search
+    long iteration = 0;        ///< Generation (engine) or move (search)
+};
+
+/**
+ * ProgressQueue
+ *
+ * Bounded single-producer, single-consumer queue of improvement events, with
+ * the best solution reported so far.
+ *
+ * The producer is a running search or engine, the consumer typically a
+ * Python thread that drains the events in batches while the search runs
+ * with the GIL released. Pushing and draining take no locks: the producer
+ * owns the write index, the consumer the read index, and each publishes its
+ * index with release semantics. Pushes must not race each other; the
+ * memetic engine pushes under its own lock, so its islands count as one
+ * producer. A full queue drops the new event and counts it in
+ * :meth:`dropped` rather than block the producer.
+ *
+ * The best solution itself is kept next to the queue, so anytime access does
+ * not depend on the consumer keeping up. It changes only on an improvement,
+ * so guarding it with a mutex costs the producer a rare, uncontended lock.
+ */
+class ProgressQueue
+{
+public:
+    /**
+     * Creates an empty queue.
+     *
+     * Parameters
+     * ----------
+     * capacity
+     *     Number of undrained events kept; rounded up to a power of two.
+     */
+    explicit ProgressQueue(size_t capacity = 1024)
+        : slots_(std::bit_ceil(std::max<size_t>(capacity, 1)))
+    {
+    }
+
+    ProgressQueue(const ProgressQueue &) = delete;
+    ProgressQueue &operator=(const ProgressQueue &) = delete;
+
+    /// Number of undrained events the queue holds.
+    size_t capacity() const noexcept { return slots_.size(); }
+
+    /**
+     * Reports a new best solution. Producer side.
+     *
+     * Parameters
+     * ----------
+     * solution
+     *     The new best solution.
+     * event
+     *     Its event; the fingerprint is taken from ``solution``.
+     *
+     * Returns
+     * -------
+     * bool
+     *     False if the queue was full and the event was dropped. The best
+     *     solution is updated either way.
+     */
+    bool publish(const Solution &solution, ProgressEvent event)
+    {
+        event.fingerprint = solution.fingerprint();
+        {
+            std::lock_guard<std::mutex> lock(bestMutex_);
+            if (!best_ || event.objValue < best_->second)
+            {
+                best_.emplace(solution, event.objValue);
+            }
+        }
+        return push(event);
+    }
+
+    /// Enqueues ``event`` without touching the best solution. Producer side.
+    bool push(const ProgressEvent &event) noexcept
+    {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_.load(std::memory_order_acquire) == slots_.size())
+        {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        slots_[head & mask()] = event;
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Moves queued events to ``out``, oldest first. Consumer side.
+     *
+     * Parameters
+     * ----------
+     * out
+     *     Vector the events are appended to.
+     * maxEvents
+     *     Most events to take; zero takes all.
+     *
+     * Returns
+     * -------
+     * size_t
+     *     Number of events taken.
+     */
+    size_t drain(std::vector<ProgressEvent> &out, size_t maxEvents = 0)
+    {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        size_t count = head_.load(std::memory_order_acquire) - tail;
+        if (maxEvents > 0)
+        {
+            count = std::min(count, maxEvents);
+        }
+
+        out.reserve(out.size() + count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            out.push_back(slots_[(tail + i) & mask()]);
+        }
+        tail_.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    /// Number of events waiting to be drained.
+    size_t size() const noexcept
+    {
+        return head_.load(std::memory_order_acquire)
+               - tail_.load(std::memory_order_acquire);
+    }
+
+    /// Number of events dropped because the queue was full.
+    uint64_t dropped() const noexcept
+    {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+    /// Best solution and objective value published so far, if any.
+    std::optional<std::pair<Solution, ObjValue>> best() const
+    {
+        std::lock_guard<std::mutex> lock(bestMutex_);
+        return best_;
+    }
+
+private:
+    std::vector<ProgressEvent> slots_;  ///< Ring storage, power-of-two sized
+
+    // The indices only grow; a slot is ``index & mask()``. Each sits on its
+    // own cache line, so the two sides do not invalidate each other's.
+    alignas(64) std::atomic<size_t> head_{0};  ///< Next write, producer
+    alignas(64) std::atomic<size_t> tail_{0};  ///< Next read, consumer
+    alignas(64) std::atomic<uint64_t> dropped_{0};
+
+    mutable std::mutex bestMutex_;
+    std::optional<std::pair<Solution, ObjValue>> best_;
+
+    size_t mask() const noexcept { return slots_.size() - 1; }
+};
+
+#endif  // PROGRESS_QUEUE_H
@@ -1,44 +1,146 @@
 #ifndef RANDOM_NUMBER_GENERATOR_H
 #define RANDOM_NUMBER_GENERATOR_H
 
-#include <chrono>     // Used for generating a time-based default seed
-#include <random>     // C++ standard library random number tools
+#include <array>      // State snapshots
+#include <cstdint>    // Fixed-width state and outputs
+#include <limits>     // Seed and output ranges
+#include <random>     // std::random_device for the default seed
 #include <stdexcept>  // Used for throwing invalid_argument exceptions
 
 /**
  * RandomNumberGenerator
  *
- * Random number generator class wrapping a Mersenne Twister engine.
+ * Random number generator class wrapping a xoshiro256++ engine.
  *
  * Provides methods to generate probability values, integers, indices and
  * boolean values, supplying high-quality randomness for the algorithms.
+ * The state is four 64-bit words, so graphs and strategies that carry a
+ * generator copy cheaply. Bounded integers use Lemire's multiply-shift
+ * rejection instead of a distribution object per draw.
+ *
+ * Independent streams are derived with :meth:`split` (a statistically
+ * independent generator seeded from this one) or :meth:`jump` (the same
+ * sequence advanced by 2^128 draws). Drawing the streams in a fixed order
+ * keeps results reproducible however their consumers are scheduled.
  */
 class RandomNumberGenerator
 {
 private:
-    mutable std::mt19937
-        rng_;  ///< Mersenne Twister random number generation engine. `mutable`
-              ///< allows it to be modified in const methods, as generating
-              ///< random numbers inherently changes the engine's state.
+    mutable uint64_t state_[4] = {};  ///< xoshiro256++ state. `mutable`
+                                      ///< allows it to be modified in const
+                                      ///< methods, as generating random
+                                      ///< numbers inherently changes it.
+
+    static constexpr uint64_t rotl(uint64_t x, int k)
+    {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    /// SplitMix64 step; expands a seed into well-mixed state words.
+    static constexpr uint64_t splitMix(uint64_t &x)
+    {
+        uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    void seedState(uint64_t seed)
+    {
+        for (uint64_t &word : state_)
+        {
+            word = splitMix(seed);
+        }
+    }
 
 public:
+    using result_type = uint64_t;
+
+    /// The four state words, as saved in checkpoints.
+    using State = std::array<uint64_t, 4>;
+
     /**
      * Default constructor.
      *
      * Initializes the generator with a non-deterministic seed obtained
      * from std::random_device.
      */
-    RandomNumberGenerator() : rng_(std::random_device{}()) {}
+    RandomNumberGenerator()
+    {
+        std::random_device device;
+        seedState((static_cast<uint64_t>(device()) << 32) | device());
+    }
+
+    /// Creates a generator seeded with ``seed``, as by :meth:`setSeed`.
+    explicit RandomNumberGenerator(int seed) { setSeed(seed); }
 
     /**
      * Set the random seed.
      *
+     * The seed is expanded by SplitMix64, so nearby seeds give unrelated
+     * sequences.
+     *
      * Parameters
      * ----------
      * seed
      *     Seed value used to initialize the random number generator.
      */
-    void setSeed(int seed) { rng_.seed(static_cast<std::mt19937::result_type>(seed)); }
+    void setSeed(int seed) { seedState(static_cast<uint64_t>(seed)); }
+
+    /// Returns the current state; restoring it with :meth:`setState`
+    /// continues the same sequence.
+    State state() const { return {state_[0], state_[1], state_[2], state_[3]}; }
+
+    /// Whether ``state`` can be set: xoshiro256++ never leaves the all-zero
+    /// state, so it is rejected.
+    static bool isValidState(const State &state)
+    {
+        return state[0] != 0 || state[1] != 0 || state[2] != 0 || state[3] != 0;
+    }
+
+    /**
+     * Set the state saved by :meth:`state`.
+     *
+     * Parameters
+     * ----------
+     * state
+     *     The four state words.
+     *
+     * Raises
+     * ------
+     * std::invalid_argument
+     *     If all words are zero, which xoshiro256++ never leaves.
+     */
+    void setState(const State &state)
+    {
+        if (!isValidState(state))
+        {
+            throw std::invalid_argument("Generator state must not be all zero");
+        }
+        for (int i = 0; i < 4; ++i)
+        {
+            state_[i] = state[i];
+        }
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    /// Returns the next 64 random bits.
+    result_type operator()() const
+    {
+        const uint64_t result = rotl(state_[0] + state_[3], 23) + state_[0];
+        const uint64_t shifted = state_[1] << 17;
+
+        state_[2] ^= state_[0];
+        state_[3] ^= state_[1];
+        state_[1] ^= state_[2];
+        state_[0] ^= state_[3];
+        state_[2] ^= shifted;
+        state_[3] = rotl(state_[3], 45);
+
+        return result;
+    }
 
     /**
      * Generate a random probability value.
@@ -46,12 +148,11 @@ public:
      * Returns
      * -------
      * double
-     *     The generated random probability value.
+     *     The generated random probability value, in [0, 1).
      */
     double generateProbability() const
     {
-        std::uniform_real_distribution<double> dist(0.0, 1.0);
-        return dist(rng_);
+        return static_cast<double>((*this)() >> 11) * 0x1.0p-53;
     }
 
     /**
@@ -80,8 +181,21 @@ public:
         {
             throw std::invalid_argument("Minimum cannot be greater than maximum");
         }
-        std::uniform_int_distribution<int> dist(min, max);
-        return dist(rng_);
+
+        // A 32-bit draw times the range, at most 2^32, fits in 64 bits; its
+        // high word is the offset. Low words below the threshold would
+        // favour some offsets and are redrawn.
+        const uint64_t range = static_cast<uint64_t>(int64_t{max} - min) + 1;
+        uint64_t product = ((*this)() >> 32) * range;
+        if ((product & 0xffffffffULL) < range)
+        {
+            const uint64_t threshold = ((1ULL << 32) - range) % range;
+            while ((product & 0xffffffffULL) < threshold)
+            {
+                product = ((*this)() >> 32) * range;
+            }
+        }
+        return static_cast<int>(min + static_cast<int64_t>(product >> 32));
     }
 
     /**
@@ -125,6 +239,74 @@ public:
      *     True if the generated random probability is less than p, otherwise false.
      */
     bool generateBool(double p) const { return generateProbability() < p; }
+
+    /**
+     * Draws a seed for a component that takes an integer seed.
+     *
+     * Returns
+     * -------
+     * int
+     *     A positive seed; search strategies ignore seeds below one.
+     */
+    int nextSeed() const
+    {
+        return 1 + generateIndex(std::numeric_limits<int>::max());
+    }
+
+    /**
+     * Derives an independent generator from this one.
+     *
+     * The child is seeded from the next output, so this generator advances
+     * by one draw. Children of children are independent as well, which
+     * makes split suitable for nested parallelism: a run splits one stream
+     * per island, an island one per offspring.
+     *
+     * Returns
+     * -------
+     * RandomNumberGenerator
+     *     The derived generator.
+     */
+    RandomNumberGenerator split() const
+    {
+        RandomNumberGenerator child(*this);
+        child.seedState((*this)());
+        return child;
+    }
+
+    /**
+     * Advances the generator by 2^128 draws.
+     *
+     * Copies of one generator, jumped zero, one, two, ... times, produce
+     * non-overlapping subsequences of a single stream.
+     */
+    void jump()
+    {
+        static constexpr uint64_t JUMP[] = {0x180ec6d33cfd0abaULL,
+                                            0xd5a61266f0c9392cULL,
+                                            0xa9582618e03fc9aaULL,
+                                            0x39abdc4529b1661cULL};
+
+        uint64_t jumped[4] = {};
+        for (uint64_t word : JUMP)
+        {
+            for (int bit = 0; bit < 64; ++bit)
+            {
+                if (word & (1ULL << bit))
+                {
+                    for (int i = 0; i < 4; ++i)
+                    {
+                        jumped[i] ^= state_[i];
+                    }
+                }
+                (*this)();
+            }
+        }
+
+        for (int i = 0; i < 4; ++i)
+        {
+            state_[i] = jumped[i];
+        }
+    }
 };
 
 #endif  // RANDOM_NUMBER_GENERATOR_H
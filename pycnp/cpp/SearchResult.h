@@ -2,7 +2,6 @@
 #define SEARCH_RESULT_H
 
 #include "Graph/Graph.h"  
-#include <climits>       
 
 /**
  * SearchResult
@@ -18,9 +17,10 @@ public:
     /**
      * Default constructor.
      *
-     * Initializes the objective value to INT_MAX, indicating no valid solution.
+     * Initializes the objective value to MAX_OBJ_VALUE, indicating no valid
+     * solution.
      */
-    SearchResult() : objValue(INT_MAX) {}
+    SearchResult() : objValue(MAX_OBJ_VALUE) {}
 
     /**
      * Construct with solution and objective value.
@@ -32,7 +32,7 @@ public:
      * obj
      *     Objective value of the solution.
      */
-    SearchResult(NodeSet sol, int obj) : solution(std::move(sol)), objValue(obj) {}
+    SearchResult(Solution sol, ObjValue obj) : solution(std::move(sol)), objValue(obj) {}
 
     // Use default copy and move constructors/assignments
     SearchResult(const SearchResult&) = default;
@@ -41,10 +41,16 @@ public:
     SearchResult& operator=(SearchResult&&) = default;
 
     /// Found solution, represented as a set of nodes
-    NodeSet solution;
+    Solution solution;
 
     /// Objective value of the solution
-    int objValue;
+    ObjValue objValue;
+
+    /// Local search moves performed to find the solution
+    long numSteps = 0;
+
+    /// Whether a time, step or cancellation limit stopped the search early
+    bool interrupted = false;
 
     /**
      * Check whether this is a valid solution.
@@ -52,9 +58,9 @@ public:
      * Returns
      * -------
      * bool
-     *     True if the objective value is not INT_MAX, false otherwise.
+     *     True if the objective value is not MAX_OBJ_VALUE, false otherwise.
      */
-    bool isValid() const noexcept { return objValue != INT_MAX; }
+    bool isValid() const noexcept { return objValue != MAX_OBJ_VALUE; }
 };
 
 #endif  // SEARCH_RESULT_H
\ No newline at end of file
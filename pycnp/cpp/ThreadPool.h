@@ -0,0 +1,208 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * ThreadPool
+ *
+ * Fixed set of worker threads executing chunked parallel loops.
+ *
+ * The calling thread always works on its own loop as well, so a loop
+ * completes even when every worker is busy, and loops may be started from
+ * several threads (or from inside another loop) at once.
+ */
+class ThreadPool
+{
+private:
+    std::vector<std::thread> workers_;
+    std::deque<std::function<void()>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable available_;
+    bool stopping_ = false;
+
+    void workerLoop()
+    {
+        while (true)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                available_.wait(lock,
+                                [this] { return stopping_ || !tasks_.empty(); });
+                if (stopping_ && tasks_.empty())
+                {
+                    return;
+                }
+                task = std::move(tasks_.front());
+                tasks_.pop_front();
+            }
+            task();
+        }
+    }
+
+public:
+    /**
+     * Starts ``numWorkers`` worker threads.
+     *
+     * Parameters
+     * ----------
+     * numWorkers
+     *     Number of threads besides the callers of parallelFor.
+     */
+    explicit ThreadPool(size_t numWorkers)
+    {
+        workers_.reserve(numWorkers);
+        for (size_t i = 0; i < numWorkers; ++i)
+        {
+            workers_.emplace_back([this] { workerLoop(); });
+        }
+    }
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        available_.notify_all();
+        for (std::thread &worker : workers_)
+        {
+            worker.join();
+        }
+    }
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    /**
+     * Returns the process-wide pool, with one worker less than the number
+     * of hardware threads.
+     */
+    static ThreadPool &instance()
+    {
+        static ThreadPool pool(
+            std::max(1u, std::thread::hardware_concurrency()) - 1);
+        return pool;
+    }
+
+    /**
+     * Resolves a requested thread count; values below one mean all
+     * hardware threads.
+     */
+    static size_t resolveThreads(int numThreads)
+    {
+        if (numThreads > 0)
+        {
+            return static_cast<size_t>(numThreads);
+        }
+        return std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    /**
+     * Runs ``fn(begin, end, chunk)`` over ``[0, count)`` split into at most
+     * ``maxChunks`` contiguous chunks, and waits for all of them.
+     *
+     * A chunk is processed by one thread at a time, so ``chunk`` (smaller
+     * than ``maxChunks``) can index per-chunk scratch space. The first
+     * exception thrown by ``fn`` is rethrown in the caller.
+     *
+     * Parameters
+     * ----------
+     * count
+     *     Number of loop iterations.
+     * maxChunks
+     *     Upper bound on the number of chunks, i.e. on the parallelism.
+     * fn
+     *     Callable taking ``(size_t begin, size_t end, size_t chunk)``.
+     */
+    template <typename Fn>
+    void parallelFor(size_t count, size_t maxChunks, Fn &&fn)
+    {
+        const size_t numChunks = std::min(count, std::max<size_t>(1, maxChunks));
+        if (numChunks <= 1 || workers_.empty())
+        {
+            for (size_t chunk = 0; chunk < numChunks; ++chunk)
+            {
+                fn(count * chunk / numChunks,
+                   count * (chunk + 1) / numChunks,
+                   chunk);
+            }
+            return;
+        }
+
+        struct Loop
+        {
+            std::atomic<size_t> next{0};
+            size_t done = 0;
+            std::exception_ptr error;
+            std::mutex mutex;
+            std::condition_variable finished;
+        };
+
+        auto loop = std::make_shared<Loop>();
+        auto *body = &fn;
+
+        // Late helpers find no chunk left and never touch ``fn``, which only
+        // lives as long as this call.
+        auto work = [loop, body, count, numChunks]
+        {
+            size_t chunk;
+            while ((chunk = loop->next.fetch_add(1)) < numChunks)
+            {
+                std::exception_ptr error;
+                try
+                {
+                    (*body)(count * chunk / numChunks,
+                            count * (chunk + 1) / numChunks,
+                            chunk);
+                }
+                catch (...)
+                {
+                    error = std::current_exception();
+                }
+
+                std::lock_guard<std::mutex> lock(loop->mutex);
+                if (error && !loop->error)
+                {
+                    loop->error = error;
+                }
+                if (++loop->done == numChunks)
+                {
+                    loop->finished.notify_all();
+                }
+            }
+        };
+
+        const size_t numHelpers = std::min(numChunks - 1, workers_.size());
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (size_t i = 0; i < numHelpers; ++i)
+            {
+                tasks_.emplace_back(work);
+            }
+        }
+        available_.notify_all();
+
+        work();
+
+        std::unique_lock<std::mutex> lock(loop->mutex);
+        loop->finished.wait(lock, [&] { return loop->done == numChunks; });
+        if (loop->error)
+        {
+            std::rethrow_exception(loop->error);
+        }
+    }
+};
+
+#endif  // THREAD_POOL_H
@@ -0,0 +1,202 @@
+#include "Trace.h"
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+
+namespace
+{
+// Blocks are never freed: a block released by an exiting thread goes on the
+// free list and keeps its totals for the next thread that picks it up.
+struct Registry
+{
+    std::mutex mutex;
+    std::vector<std::unique_ptr<trace::detail::ThreadBlock>> blocks;
+    std::vector<trace::detail::ThreadBlock *> available;
+};
+
+Registry &registry()
+{
+    // Leaked deliberately, so thread exits during static destruction can
+    // still release their blocks.
+    static Registry *instance = new Registry;
+    return *instance;
+}
+
+const std::chrono::steady_clock::time_point EPOCH
+    = std::chrono::steady_clock::now();
+
+struct BlockHandle
+{
+    trace::detail::ThreadBlock *block;
+
+    BlockHandle()
+    {
+        Registry &reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        if (!reg.available.empty())
+        {
+            block = reg.available.back();
+            reg.available.pop_back();
+        }
+        else
+        {
+            reg.blocks.push_back(std::make_unique<trace::detail::ThreadBlock>());
+            block = reg.blocks.back().get();
+            block->index = static_cast<uint32_t>(reg.blocks.size() - 1);
+        }
+    }
+
+    ~BlockHandle()
+    {
+        Registry &reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        reg.available.push_back(block);
+    }
+};
+
+template <typename T> T load(const std::atomic<T> &value)
+{
+    return value.load(std::memory_order_relaxed);
+}
+}  // namespace
+
+namespace trace
+{
+const char *counterName(Counter counter)
+{
+    switch (counter)
+    {
+    case Counter::NodeRemovals:
+        return "node_removals";
+    case Counter::NodeAdditions:
+        return "node_additions";
+    case Counter::ComponentSplits:
+        return "component_splits";
+    case Counter::ComponentMerges:
+        return "component_merges";
+    case Counter::BfsRecomputes:
+        return "bfs_recomputes";
+    case Counter::ComponentSelections:
+        return "component_selections";
+    case Counter::TournamentSelections:
+        return "tournament_selections";
+    case Counter::DuplicateSolutions:
+        return "duplicate_solutions";
+    default:
+        return "unknown";
+    }
+}
+
+const char *phaseName(Phase phase)
+{
+    switch (phase)
+    {
+    case Phase::CBNS:
+        return "CBNS";
+    case Phase::CHNS:
+        return "CHNS";
+    case Phase::DLAS:
+        return "DLAS";
+    case Phase::BCLS:
+        return "BCLS";
+    case Phase::Crossover:
+        return "crossover";
+    case Phase::PopulationUpdate:
+        return "population_update";
+    default:
+        return "unknown";
+    }
+}
+
+const char *eventName(Event event)
+{
+    switch (event)
+    {
+    case Event::ComponentSelected:
+        return "component_selected";
+    case Event::NoComponentAvailable:
+        return "no_component_available";
+    case Event::DuplicateSolution:
+        return "duplicate_solution";
+    default:
+        return "unknown";
+    }
+}
+
+Metrics snapshot()
+{
+    Metrics metrics;
+    Registry &reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+
+    for (const auto &block : reg.blocks)
+    {
+        for (size_t i = 0; i < NUM_COUNTERS; ++i)
+        {
+            metrics.counters[i] += load(block->counters[i]);
+        }
+        for (size_t i = 0; i < NUM_PHASES; ++i)
+        {
+            metrics.phaseCalls[i] += load(block->phaseCalls[i]);
+            metrics.phaseNanos[i] += load(block->phaseNanos[i]);
+        }
+
+        const uint64_t numEvents
+            = block->numEvents.load(std::memory_order_acquire);
+        const uint64_t first
+            = numEvents > EVENT_RING_SIZE ? numEvents - EVENT_RING_SIZE : 0;
+        for (uint64_t position = first; position < numEvents; ++position)
+        {
+            const auto &slot = block->ring[position % EVENT_RING_SIZE];
+            metrics.events.push_back({load(slot.nanos),
+                                      block->index,
+                                      static_cast<Event>(load(slot.event)),
+                                      load(slot.first),
+                                      load(slot.second)});
+        }
+    }
+
+    std::stable_sort(metrics.events.begin(),
+                     metrics.events.end(),
+                     [](const EventRecord &a, const EventRecord &b)
+                     { return a.nanos < b.nanos; });
+    return metrics;
+}
+
+void reset()
+{
+    Registry &reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+
+    for (const auto &block : reg.blocks)
+    {
+        for (auto &value : block->counters)
+        {
+            value.store(0, std::memory_order_relaxed);
+        }
+        for (size_t i = 0; i < NUM_PHASES; ++i)
+        {
+            block->phaseCalls[i].store(0, std::memory_order_relaxed);
+            block->phaseNanos[i].store(0, std::memory_order_relaxed);
+        }
+        block->numEvents.store(0, std::memory_order_relaxed);
+    }
+}
+
+namespace detail
+{
+ThreadBlock &localBlock()
+{
+    thread_local BlockHandle handle;
+    return *handle.block;
+}
+
+uint64_t now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now() - EPOCH)
+        .count();
+}
+}  // namespace detail
+}  // namespace trace
@@ -0,0 +1,216 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Trace
+ *
+ * Compile-time gated counters, phase timers and event log for profiling the
+ * solver.
+ *
+ * Instrumentation sites use the ``PYCNP_TRACE_*`` macros below. Unless the
+ * library is built with ``PYCNP_TRACE`` defined (the ``trace`` meson
+ * option), the macros expand to nothing and their arguments are not
+ * evaluated, so regular builds pay nothing for them.
+ *
+ * When tracing is enabled, every thread records into its own block of
+ * counters and a fixed-size ring of recent events, so recording takes no
+ * locks and shares no cache lines. ``snapshot()`` sums the blocks of all
+ * threads. Blocks outlive their threads and are reused by later threads,
+ * so totals include work done by threads that have since exited.
+ */
+namespace trace
+{
+/// Event counters.
+enum class Counter : size_t
+{
+    NodeRemovals,          ///< Nodes removed from a graph
+    NodeAdditions,         ///< Nodes added back to a graph
+    ComponentSplits,       ///< CNP components split by a removal
+    ComponentMerges,       ///< CNP components merged by an addition
+    BfsRecomputes,         ///< DCNP K-hop BFS traversals
+    ComponentSelections,   ///< Components chosen for a CNP move
+    TournamentSelections,  ///< Parent pairs chosen by tournament
+    DuplicateSolutions,    ///< Generated solutions rejected as duplicates
+    NUM_COUNTERS,
+};
+
+/// Timed phases.
+enum class Phase : size_t
+{
+    CBNS,              ///< CBNS strategy runs
+    CHNS,              ///< CHNS strategy runs
+    DLAS,              ///< DLAS strategy runs
+    BCLS,              ///< BCLS strategy runs
+    Crossover,         ///< Offspring recombination in the memetic engine
+    PopulationUpdate,  ///< Population updates in the memetic engine
+    NUM_PHASES,
+};
+
+/// Logged event kinds; the meaning of the two arguments depends on the kind.
+enum class Event : uint32_t
+{
+    ComponentSelected,      ///< Live components, removed nodes
+    NoComponentAvailable,   ///< Live components, removed nodes
+    DuplicateSolution,      ///< Retry attempt, population size
+    NUM_EVENTS,
+};
+
+constexpr size_t NUM_COUNTERS = static_cast<size_t>(Counter::NUM_COUNTERS);
+constexpr size_t NUM_PHASES = static_cast<size_t>(Phase::NUM_PHASES);
+
+/// Number of recent events kept per thread.
+constexpr size_t EVENT_RING_SIZE = 256;
+
+#if defined(PYCNP_TRACE)
+constexpr bool ENABLED = true;
+#else
+constexpr bool ENABLED = false;
+#endif
+
+const char *counterName(Counter counter);
+const char *phaseName(Phase phase);
+const char *eventName(Event event);
+
+/// One logged event.
+struct EventRecord
+{
+    uint64_t nanos = 0;  ///< Time since the trace epoch
+    uint32_t thread = 0; ///< Index of the recording thread block
+    Event event = Event::ComponentSelected;
+    int64_t first = 0;
+    int64_t second = 0;
+};
+
+/// Aggregated metrics over all threads.
+struct Metrics
+{
+    bool enabled = ENABLED;
+    std::array<uint64_t, NUM_COUNTERS> counters{};
+    std::array<uint64_t, NUM_PHASES> phaseCalls{};
+    std::array<uint64_t, NUM_PHASES> phaseNanos{};
+    std::vector<EventRecord> events;  ///< Recent events, oldest first
+};
+
+/**
+ * Sums the metrics of all threads.
+ *
+ * Counters updated while the snapshot is taken may or may not be included;
+ * take it between runs for exact totals. Without tracing support all values
+ * are zero.
+ */
+Metrics snapshot();
+
+/// Zeroes all counters and timers and clears the event logs.
+void reset();
+
+namespace detail
+{
+struct ThreadBlock
+{
+    struct Slot
+    {
+        std::atomic<uint64_t> nanos{0};
+        std::atomic<uint32_t> event{0};
+        std::atomic<int64_t> first{0};
+        std::atomic<int64_t> second{0};
+    };
+
+    uint32_t index = 0;
+    std::array<std::atomic<uint64_t>, NUM_COUNTERS> counters{};
+    std::array<std::atomic<uint64_t>, NUM_PHASES> phaseCalls{};
+    std::array<std::atomic<uint64_t>, NUM_PHASES> phaseNanos{};
+    std::atomic<uint64_t> numEvents{0};
+    std::array<Slot, EVENT_RING_SIZE> ring;
+};
+
+/// Returns the calling thread's block, registering it on first use.
+ThreadBlock &localBlock();
+
+/// Nanoseconds since the trace epoch.
+uint64_t now();
+
+// Only the owning thread writes a block, so a relaxed load and store is
+// enough and avoids a locked read-modify-write.
+inline void bump(std::atomic<uint64_t> &value, uint64_t amount)
+{
+    value.store(value.load(std::memory_order_relaxed) + amount,
+                std::memory_order_relaxed);
+}
+}  // namespace detail
+
+inline void count(Counter counter, uint64_t amount = 1)
+{
+    detail::bump(detail::localBlock().counters[static_cast<size_t>(counter)],
+                 amount);
+}
+
+inline void record(Event event, int64_t first, int64_t second)
+{
+    detail::ThreadBlock &block = detail::localBlock();
+    const uint64_t position = block.numEvents.load(std::memory_order_relaxed);
+    auto &slot = block.ring[position % EVENT_RING_SIZE];
+    slot.nanos.store(detail::now(), std::memory_order_relaxed);
+    slot.event.store(static_cast<uint32_t>(event), std::memory_order_relaxed);
+    slot.first.store(first, std::memory_order_relaxed);
+    slot.second.store(second, std::memory_order_relaxed);
+    block.numEvents.store(position + 1, std::memory_order_release);
+}
+
+/// Adds the lifetime of the scope to a phase timer.
+class ScopedPhase
+{
+public:
+    explicit ScopedPhase(Phase phase)
+        : phase_(static_cast<size_t>(phase)),
+          start_(std::chrono::steady_clock::now())
+    {
+    }
+
+    ~ScopedPhase()
+    {
+        const auto elapsed = std::chrono::steady_clock::now() - start_;
+        detail::ThreadBlock &block = detail::localBlock();
+        detail::bump(block.phaseCalls[phase_], 1);
+        detail::bump(
+            block.phaseNanos[phase_],
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+
+    ScopedPhase(const ScopedPhase &) = delete;
+    ScopedPhase &operator=(const ScopedPhase &) = delete;
+
+private:
+    size_t phase_;
+    std::chrono::steady_clock::time_point start_;
+};
+}  // namespace trace
+
+#define PYCNP_TRACE_CONCAT_(a, b) a##b
+#define PYCNP_TRACE_CONCAT(a, b) PYCNP_TRACE_CONCAT_(a, b)
+
+#if defined(PYCNP_TRACE)
+#define PYCNP_TRACE_COUNT(counter) ::trace::count(::trace::Counter::counter)
+#define PYCNP_TRACE_ADD(counter, amount)                                       \
+    ::trace::count(::trace::Counter::counter, static_cast<uint64_t>(amount))
+#define PYCNP_TRACE_EVENT(event, first, second)                                \
+    ::trace::record(::trace::Event::event,                                     \
+                    static_cast<int64_t>(first),                               \
+                    static_cast<int64_t>(second))
+#define PYCNP_TRACE_PHASE(phase)                                               \
+    ::trace::ScopedPhase PYCNP_TRACE_CONCAT(tracePhase_, __LINE__)(            \
+        ::trace::Phase::phase)
+#else
+#define PYCNP_TRACE_COUNT(counter) ((void)0)
+#define PYCNP_TRACE_ADD(counter, amount) ((void)0)
+#define PYCNP_TRACE_EVENT(event, first, second) ((void)0)
+#define PYCNP_TRACE_PHASE(phase) ((void)0)
+#endif
+
+#endif  // TRACE_H
@@ -2,7 +2,6 @@
 
 #include <algorithm>
 #include <memory>
-#include <unordered_set>
 
 namespace
 {
@@ -12,16 +11,16 @@ namespace
 std::unique_ptr<Graph> doubleBackboneBasedCrossover(
     const Graph &originalGraph,
     const std::pair<const Solution *, const Solution *> &parents,
-    int seed)
+    int seed,
+    std::unique_ptr<Graph> offspring)
 {
-    RandomNumberGenerator rng;
-    rng.setSeed(seed);
+    RandomNumberGenerator rng(seed);
 
     const auto &MSolution = *parents.first;
     const auto &FSolution = *parents.second;
 
-    Solution nodesToRemove;
-    nodesToRemove.reserve(MSolution.size());
+    Solution nodesToRemove(originalGraph.getNumNodes());
+    nodesToRemove.reserve(MSolution.size() + FSolution.size());
 
     for (Node node : MSolution)
     {
@@ -45,8 +44,14 @@ std::unique_ptr<Graph> doubleBackboneBasedCrossover(
         }
     }
 
-    auto offspring = originalGraph.clone();
-    offspring->updateGraphByRemovedNodes(nodesToRemove);
+    if (offspring)
+    {
+        offspring->assignWithRemovedNodes(originalGraph, nodesToRemove);
+    }
+    else
+    {
+        offspring = originalGraph.cloneWithRemovedNodes(nodesToRemove);
+    }
 
     int currentCount = static_cast<int>(nodesToRemove.size());
     int targetCount = static_cast<int>(MSolution.size());
@@ -16,11 +16,14 @@
  * @param originalGraph The original problem graph.
  * @param parents Pair of parent solutions to cross over.
  * @param seed Random seed for the operation.
- * @return Unique pointer to the new offspring graph.
+ * @param offspring Graph of an earlier offspring, rebuilt in place so its
+ *        storage is reused; a new graph is allocated when null.
+ * @return Unique pointer to the offspring graph.
  */
 std::unique_ptr<Graph> doubleBackboneBasedCrossover(
     const Graph &originalGraph,
     const std::pair<const Solution *, const Solution *> &parents,
-    int seed);
+    int seed,
+    std::unique_ptr<Graph> offspring = nullptr);
 
 #endif  // DOUBLE_BACKBONE_BASED_CROSSOVER_H
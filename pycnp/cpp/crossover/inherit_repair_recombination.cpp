@@ -15,10 +15,10 @@ namespace
 std::unique_ptr<Graph> inherit_repair_recombination(
     const Graph &originalGraph,
     const std::tuple<const Solution *, const Solution *, const Solution *> &parents,
-    int seed)
+    int seed,
+    std::unique_ptr<Graph> offspring)
 {
-    RandomNumberGenerator rng;
-    rng.setSeed(seed);
+    RandomNumberGenerator rng(seed);
 
     const auto &parent1Nodes = *std::get<0>(parents);
     const auto &parent2Nodes = *std::get<1>(parents);
@@ -26,24 +26,22 @@ std::unique_ptr<Graph> inherit_repair_recombination(
 
     int numToRemove = static_cast<int>(parent1Nodes.size());
 
-    auto offspring = originalGraph.clone();
-
     int maxNodeId = 0;
-    for (const auto &parentNodes : {parent1Nodes, parent2Nodes, parent3Nodes})
+    for (const Solution *parentNodes : {&parent1Nodes, &parent2Nodes, &parent3Nodes})
     {
-        for (Node node : parentNodes)
+        for (Node node : *parentNodes)
         {
             maxNodeId = std::max(maxNodeId, node);
         }
     }
 
     std::vector<int> nodeFrequency(static_cast<size_t>(maxNodeId) + 1, 0);
-    Solution nodesToRemove;
+    Solution nodesToRemove(static_cast<size_t>(maxNodeId) + 1);
     nodesToRemove.reserve(numToRemove);
 
-    for (const auto &parentNodes : {parent1Nodes, parent2Nodes, parent3Nodes})
+    for (const Solution *parentNodes : {&parent1Nodes, &parent2Nodes, &parent3Nodes})
     {
-        for (Node node : parentNodes)
+        for (Node node : *parentNodes)
         {
             nodeFrequency[node]++;
 
@@ -109,7 +107,14 @@ std::unique_ptr<Graph> inherit_repair_recombination(
         }
     }
 
-    offspring->updateGraphByRemovedNodes(nodesToRemove);
+    if (offspring)
+    {
+        offspring->assignWithRemovedNodes(originalGraph, nodesToRemove);
+    }
+    else
+    {
+        offspring = originalGraph.cloneWithRemovedNodes(nodesToRemove);
+    }
 
     while (static_cast<int>(nodesToRemove.size()) < numToRemove)
     {
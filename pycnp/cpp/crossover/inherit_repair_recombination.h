@@ -15,11 +15,14 @@
  * @param originalGraph The original problem graph.
  * @param parents Tuple of three parent solutions.
  * @param seed Random seed for the operation.
- * @return Unique pointer to the new offspring graph.
+ * @param offspring Graph of an earlier offspring, rebuilt in place so its
+ *        storage is reused; a new graph is allocated when null.
+ * @return Unique pointer to the offspring graph.
  */
 std::unique_ptr<Graph> inherit_repair_recombination(
     const Graph &originalGraph,
     const std::tuple<const Solution *, const Solution *, const Solution *> &parents,
-    int seed);
+    int seed,
+    std::unique_ptr<Graph> offspring = nullptr);
 
 #endif  // INHERIT_REPAIR_RECOMBINATION_H
@@ -16,7 +16,12 @@ namespace
         Solution sol;
         for (auto item : py_set)
         {
-            sol.insert(item.cast<int>());
+            const int node = item.cast<int>();
+            if (node < 0)
+            {
+                throw std::invalid_argument("Node IDs must be non-negative integers");
+            }
+            sol.insert(node);
         }
         return sol;
     }
@@ -49,8 +54,8 @@ PYBIND11_MODULE(_crossover, m)
                 sols.push_back(pysetToSolution(p));
             }
             parent_pair = {&sols[0], &sols[1]};
-            auto result = doubleBackboneBasedCrossover(orig_graph, parent_pair, seed);
-            return result;
+            py::gil_scoped_release release;
+            return doubleBackboneBasedCrossover(orig_graph, parent_pair, seed);
         },
         py::arg("orig_graph"),
         py::arg("parents"),
@@ -74,6 +79,7 @@ PYBIND11_MODULE(_crossover, m)
                 sols.push_back(pysetToSolution(p));
             }
             parent_tuple = {&sols[0], &sols[1], &sols[2]};
+            py::gil_scoped_release release;
             return inherit_repair_recombination(orig_graph, parent_tuple, seed);
         },
         py::arg("orig_graph"),
@@ -88,7 +94,8 @@ PYBIND11_MODULE(_crossover, m)
            const std::vector<py::set> &py_parents,
            const std::string &search_strategy,
            double beta,
-           int seed)
+           int seed,
+           double time_limit)
         {
             if (py_parents.size() != 2)
             {
@@ -102,18 +109,27 @@ PYBIND11_MODULE(_crossover, m)
             }
             std::pair<const Solution *, const Solution *> parent_pair = {
                 &cpp_solutions[0], &cpp_solutions[1]};
+            std::unordered_map<std::string, std::any> search_params;
+            if (time_limit > 0)
+            {
+                search_params["timeLimit"] = time_limit;
+            }
+            py::gil_scoped_release release;
             return reduceSolveCombine(
                 orig_graph,
                 parent_pair,
                 search_strategy,
                 beta,
-                seed);
+                seed,
+                nullptr,
+                search_params);
         },
         py::arg("orig_graph"),
         py::arg("parents"),
         py::arg("search") = "CHNS",
         py::arg("beta") = 0.9,
         py::arg("seed"),
+        py::arg("time_limit") = 0.0,
         py::return_value_policy::take_ownership,
         DOC_IMPL(reduceSolveCombine));
 }
\ No newline at end of file
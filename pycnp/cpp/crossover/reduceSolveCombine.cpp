@@ -8,20 +8,21 @@ std::unique_ptr<Graph> reduceSolveCombine(
     const std::pair<const Solution *, const Solution *> &parents,
     const std::string &search_strategy,
     double beta,
-    int seed)
+    int seed,
+    std::unique_ptr<Graph> offspring,
+    const std::unordered_map<std::string, std::any> &searchParams)
 {
     if (beta < 0.0 || beta > 1.0)
     {
         throw std::invalid_argument("beta for RSC crossover must be in [0, 1]");
     }
 
-    RandomNumberGenerator rng;
-    rng.setSeed(seed);
+    RandomNumberGenerator rng(seed);
 
     const auto &MSolution = *parents.first;
     const auto &FSolution = *parents.second;
 
-    Solution nodesToRemove;
+    Solution nodesToRemove(originalGraph.getNumNodes());
     nodesToRemove.reserve(std::min(MSolution.size(), FSolution.size()));
 
     for (Node node : MSolution)
@@ -32,10 +33,20 @@ std::unique_ptr<Graph> reduceSolveCombine(
         }
     }
 
-    auto workingGraph = originalGraph.clone();
-    workingGraph->getReducedGraphByRemovedNodes(nodesToRemove);
+    // The offspring graph doubles as the working graph: reducing resets the
+    // removal set, so starting from an empty one is the same as a clone.
+    const Solution noNodes;
+    if (offspring)
+    {
+        offspring->assignWithRemovedNodes(originalGraph, noNodes);
+    }
+    else
+    {
+        offspring = originalGraph.cloneWithRemovedNodes(noNodes);
+    }
+    offspring->getReducedGraphByRemovedNodes(nodesToRemove);
 
-    std::unique_ptr<Graph> reducedGraph(workingGraph->getRandomFeasibleGraph());
+    std::unique_ptr<Graph> reducedGraph(offspring->getRandomFeasibleGraph());
 
     Search local_search(*reducedGraph, seed);
     const bool is_dcnp = originalGraph.isDCNP();
@@ -44,13 +55,15 @@ std::unique_ptr<Graph> reduceSolveCombine(
     local_search.setStrategy(search_strategy.empty() 
         ? (is_dcnp ? "BCLS" : "CHNS") 
         : search_strategy);
+    for (const auto &[name, value] : searchParams)
+    {
+        local_search.setParam(name, value);
+    }
     SearchResult result = local_search.run();
 
     Solution finalNodes = nodesToRemove;
     finalNodes.insert(result.solution.begin(), result.solution.end());
 
-    auto improvedGraph = originalGraph.clone();
-    improvedGraph->updateGraphByRemovedNodes(finalNodes);
-
-    return improvedGraph;
+    offspring->assignWithRemovedNodes(originalGraph, finalNodes);
+    return offspring;
 }
@@ -3,8 +3,10 @@
 
 #include "../Graph/Graph.h"
 #include "../RandomNumberGenerator.h"
+#include <any>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <utility>
 
 /**
@@ -18,13 +20,19 @@
  * @param search_strategy The local search strategy to use on the subproblem.
  * @param beta Parameter controlling the reduction intensity.
  * @param seed Random seed for the operation.
- * @return Unique pointer to the new offspring graph.
+ * @param offspring Graph of an earlier offspring, rebuilt in place so its
+ *        storage is reused; a new graph is allocated when null.
+ * @param searchParams Parameters forwarded to the local search of the
+ *        subproblem, such as a ``"deadline"`` or ``"cancelToken"``.
+ * @return Unique pointer to the offspring graph.
  */
 std::unique_ptr<Graph> reduceSolveCombine(
     const Graph &originalGraph,
     const std::pair<const Solution *, const Solution *> &parents,
     const std::string &search_strategy,
     double beta,
-    int seed);
+    int seed,
+    std::unique_ptr<Graph> offspring = nullptr,
+    const std::unordered_map<std::string, std::any> &searchParams = {});
 
 #endif  // REDUCE_SOLVE_COMBINE_H
@@ -14,12 +14,18 @@
 #include <functional>
 
 // PyCNP core headers
+#include "Checkpoint.h"
 #include "Graph/CNP_Graph.h"
 #include "Graph/DCNP_Graph.h"
 #include "Graph/Graph.h"
+#include "MemeticEngine.h"
 #include "Population.h"
 #include "ProblemData.h"
+#include "ProgressQueue.h"
+#include "RandomNumberGenerator.h"
+#include "Trace.h"
 #include "search/Search.h"
+#include "search/SearchCache.h"
 #include "search/SearchStrategy.h"
 #include "search/CBNSStrategy.h"
 #include "search/CHNSStrategy.h"
@@ -43,10 +49,10 @@ namespace py = pybind11;
 // ============================================================================
 
 /**
- * Convert C++ Solution (unordered_set<int>) to Python set.
+ * Convert C++ Solution to Python set.
  *
  * This helper function is used to convert solution set data structures between C++ and Python.
- * Solution is represented as unordered_set<int> in C++, containing IDs of removed nodes.
+ * Solution is a bitset-backed node set in C++, containing IDs of removed nodes.
  *
  * Parameters
  * ----------
@@ -77,7 +83,7 @@ py::set solutionToPyset(const Solution &sol)
 }
 
 /**
- * Convert Python set to C++ Solution (unordered_set<int>).
+ * Convert Python set to C++ Solution.
  *
  * This helper function converts Python-passed node sets to C++ Solution type.
  * Includes input validation to ensure all elements are valid integer node IDs.
@@ -121,6 +127,58 @@ Solution pysetToSolution(const py::set &py_set)
     }
 }
 
+/**
+ * Convert aggregated trace metrics to a Python dictionary.
+ *
+ * Parameters
+ * ----------
+ * metrics : trace::Metrics
+ *     Metrics summed over all threads
+ *
+ * Returns
+ * -------
+ * py::dict
+ *     Dictionary with ``enabled``, ``counters`` (name to count), ``phases``
+ *     (name to ``calls`` and ``seconds``) and ``events`` (recent events,
+ *     oldest first)
+ */
+py::dict metricsToDict(const trace::Metrics &metrics)
+{
+    py::dict counters;
+    for (size_t i = 0; i < trace::NUM_COUNTERS; ++i)
+    {
+        counters[trace::counterName(static_cast<trace::Counter>(i))]
+            = metrics.counters[i];
+    }
+
+    py::dict phases;
+    for (size_t i = 0; i < trace::NUM_PHASES; ++i)
+    {
+        py::dict phase;
+        phase["calls"] = metrics.phaseCalls[i];
+        phase["seconds"] = static_cast<double>(metrics.phaseNanos[i]) * 1e-9;
+        phases[trace::phaseName(static_cast<trace::Phase>(i))] = phase;
+    }
+
+    py::list events;
+    for (const trace::EventRecord &record : metrics.events)
+    {
+        py::dict event;
+        event["time"] = static_cast<double>(record.nanos) * 1e-9;
+        event["thread"] = record.thread;
+        event["event"] = trace::eventName(record.event);
+        event["args"] = py::make_tuple(record.first, record.second);
+        events.append(event);
+    }
+
+    py::dict result;
+    result["enabled"] = metrics.enabled;
+    result["counters"] = counters;
+    result["phases"] = phases;
+    result["events"] = events;
+    return result;
+}
+
 // ============================================================================
 // Python module definition
 // ============================================================================
@@ -162,6 +220,9 @@ PYBIND11_MODULE(_pycnp, m)
     // Problem type constants - used to specify the problem type to solve
     m.attr("CNP") = "CNP";     // Critical Node Problem
     m.attr("DCNP") = "DCNP";   // Distance-based Critical Node Problem
+    m.attr("WCNP") = "WCNP";   // Node-weighted Critical Node Problem
+    m.attr("MINMAXC") = "MINMAXC";  // Minimise the largest component
+    m.attr("MAXNUM") = "MAXNUM";    // Maximise the number of components
 
     // Crossover strategy constants - used to specify crossover operator types
     m.attr("DBX") = "DBX";     // Double Backbone Based Crossover
@@ -172,21 +233,156 @@ PYBIND11_MODULE(_pycnp, m)
     // Exception type bindings
     // ========================================================================
 
-    // Bind standard exception types to ensure C++ exceptions are properly passed to Python
-    py::register_exception<std::invalid_argument>(m, "InvalidArgumentError");
-    py::register_exception<std::runtime_error>(m, "RuntimeError");
+    // Bind standard exception types to ensure C++ exceptions are properly passed to Python.
+    // They derive from the matching builtins, so callers catch ValueError and
+    // RuntimeError as documented.
+    py::register_exception<std::invalid_argument>(m, "InvalidArgumentError", PyExc_ValueError);
+    py::register_exception<std::runtime_error>(m, "RuntimeError", PyExc_RuntimeError);
+
+    // ========================================================================
+    // Tracing and metrics
+    // ========================================================================
+
+    m.attr("TRACING_ENABLED") = trace::ENABLED;
+
+    m.def("get_metrics",
+          []() { return metricsToDict(trace::snapshot()); },
+          R"doc(
+        Returns solver counters, phase timers and recent events.
+
+        Values are summed over all threads. They are only recorded when pycnp
+        is built with the ``trace`` option; otherwise ``enabled`` is False and
+        all values are zero.
+
+        Returns
+        -------
+        dict
+            ``enabled``, ``counters`` (name to count), ``phases`` (name to a
+            dict with ``calls`` and ``seconds``) and ``events`` (a list of
+            dicts with ``time``, ``thread``, ``event`` and ``args``, oldest
+            first; the last 256 events of each thread are kept).
+    )doc");
+
+    m.def("reset_metrics",
+          &trace::reset,
+          R"doc(
+        Zeroes all counters and timers and clears the event logs.
+    )doc");
 
     // ========================================================================
     // Graph structure class bindings
     // ========================================================================
 
-    // Graph wrapper binding - serves as handle type
-    py::class_<Graph, std::unique_ptr<Graph>>(m, "Graph", DOC_IMPL(Graph));
+    // Graph wrapper binding - serves as handle type, with the moves of a
+    // search and their checkpoints
+    py::class_<Graph, std::unique_ptr<Graph>>(m, "Graph", DOC_IMPL(Graph))
+        .def("remove_node", &Graph::removeNode, py::arg("node"))
+        .def("add_node", &Graph::addNode, py::arg("node"))
+        .def("is_node_removed", &Graph::isNodeRemoved, py::arg("node"))
+        .def("get_removed_nodes", [](const Graph &g) { return solutionToPyset(g.getRemovedNodes()); })
+        .def("get_objective_value", &Graph::getObjectiveValue)
+        .def("greedy_select_node_to_add", &Graph::greedySelectNodeToAdd)
+        .def("random_select_node_to_remove", &Graph::randomSelectNodeToRemove)
+        .def("checkpoint", &Graph::checkpoint, DOC_IMPL(Graph, checkpoint))
+        .def("commit", &Graph::commit, DOC_IMPL(Graph, commit))
+        .def("rollback", &Graph::rollback, DOC_IMPL(Graph, rollback))
+        .def("set_gain_cache_enabled",
+             [](Graph &g, bool enabled) {
+                 if (!g.isCNP())
+                 {
+                     throw std::invalid_argument("Gain cache is only available for CNP graphs");
+                 }
+                 g.asCNP()->setGainCacheEnabled(enabled);
+             },
+             py::arg("enabled"),
+             DOC_IMPL(CNP_Graph, setGainCacheEnabled))
+        .def("set_impact_cache_enabled",
+             [](Graph &g, bool enabled) {
+                 if (!g.isCNP())
+                 {
+                     throw std::invalid_argument("Impact cache is only available for CNP graphs");
+                 }
+                 g.asCNP()->setImpactCacheEnabled(enabled);
+             },
+             py::arg("enabled"),
+             DOC_IMPL(CNP_Graph, setImpactCacheEnabled));
 
     // ========================================================================
     // Search algorithm class bindings
     // ========================================================================
 
+    // CancelToken binding - Cooperative stop for running searches
+    py::class_<CancelToken, std::shared_ptr<CancelToken>>(
+        m, "CancelToken", DOC_IMPL(CancelToken))
+        .def(py::init<>())
+        .def("cancel", &CancelToken::cancel, DOC_IMPL(CancelToken, cancel))
+        .def("reset", &CancelToken::reset, DOC_IMPL(CancelToken, reset))
+        .def_property_readonly("cancelled", &CancelToken::isCancelled);
+
+    // ProgressEvent binding - One improvement reported by a search or run
+    py::class_<ProgressEvent>(m, "ProgressEvent", DOC_IMPL(ProgressEvent))
+        .def_readonly("obj_value", &ProgressEvent::objValue)
+        .def_readonly("time", &ProgressEvent::time)
+        .def_readonly("fingerprint", &ProgressEvent::fingerprint)
+        .def_readonly("source", &ProgressEvent::source)
+        .def_readonly("iteration", &ProgressEvent::iteration)
+        .def("__repr__", [](const ProgressEvent &e) {
+            return "<ProgressEvent(obj_value=" + std::to_string(e.objValue) +
+                   ", time=" + std::to_string(e.time) +
+                   ", source=" + std::to_string(e.source) + ")>";
+        });
+
+    // ProgressQueue binding - Lock-free improvement events, drained from Python
+    py::class_<ProgressQueue, std::shared_ptr<ProgressQueue>>(
+        m, "ProgressQueue", DOC_IMPL(ProgressQueue))
+        .def(py::init<size_t>(), py::arg("capacity") = 1024)
+        .def("drain",
+             [](ProgressQueue &queue, size_t max_events) {
+                 std::vector<ProgressEvent> events;
+                 queue.drain(events, max_events);
+                 return events;
+             },
+             py::arg("max_events") = 0,
+             DOC_IMPL(ProgressQueue, drain))
+        .def("best",
+             [](const ProgressQueue &queue) -> py::object {
+                 auto best = queue.best();
+                 if (!best)
+                 {
+                     return py::none();
+                 }
+                 return py::make_tuple(solutionToPyset(best->first), best->second);
+             },
+             DOC_IMPL(ProgressQueue, best))
+        .def_property_readonly("capacity", &ProgressQueue::capacity)
+        .def_property_readonly("dropped", &ProgressQueue::dropped)
+        .def("__len__", &ProgressQueue::size);
+
+    // RandomNumberGenerator binding - Seed streams for reproducible runs
+    py::class_<RandomNumberGenerator>(
+        m, "RandomNumberGenerator", DOC_IMPL(RandomNumberGenerator))
+        .def(py::init<int>(), py::arg("seed"))
+        .def("next_seed",
+             &RandomNumberGenerator::nextSeed,
+             DOC_IMPL(RandomNumberGenerator, nextSeed))
+        .def("split",
+             &RandomNumberGenerator::split,
+             DOC_IMPL(RandomNumberGenerator, split))
+        .def("jump",
+             &RandomNumberGenerator::jump,
+             DOC_IMPL(RandomNumberGenerator, jump))
+        .def("generate_index",
+             &RandomNumberGenerator::generateIndex,
+             py::arg("max"),
+             DOC_IMPL(RandomNumberGenerator, generateIndex))
+        .def("generate_probability",
+             &RandomNumberGenerator::generateProbability,
+             DOC_IMPL(RandomNumberGenerator, generateProbability))
+        .def_property("state",
+                      &RandomNumberGenerator::state,
+                      &RandomNumberGenerator::setState,
+                      DOC_IMPL(RandomNumberGenerator, state));
+
     // Search class binding - Local search algorithm manager
     py::class_<Search>(m, "Search", DOC_IMPL(Search))
         .def(py::init<Graph &, int>(),
@@ -196,9 +392,78 @@ PYBIND11_MODULE(_pycnp, m)
         .def("set_strategy", &Search::setStrategy,
              py::arg("strategy"),
              DOC_IMPL(Search, setStrategy))
+        .def("set_param",
+             [](Search &search, const std::string &name, int value)
+             { search.setParam(name, value); },
+             py::arg("name"),
+             py::arg("value"),
+             DOC_IMPL(Search, setParam))
+        .def("set_param",
+             [](Search &search, const std::string &name, double value)
+             { search.setParam(name, value); },
+             py::arg("name"),
+             py::arg("value"))
+        .def("set_param",
+             [](Search &search,
+                const std::string &name,
+                std::shared_ptr<CancelToken> value)
+             { search.setParam(name, value); },
+             py::arg("name"),
+             py::arg("value"))
+        .def("set_param",
+             [](Search &search,
+                const std::string &name,
+                std::shared_ptr<ProgressQueue> value)
+             { search.setParam(name, value); },
+             py::arg("name"),
+             py::arg("value"))
         .def("run", &Search::run,
+             py::call_guard<py::gil_scoped_release>(),
              DOC_IMPL(Search, run));
 
+    // SearchCache binding - LRU cache of local search results
+    py::class_<SearchCache>(m, "SearchCache", DOC_IMPL(SearchCache))
+        .def(py::init([](size_t capacity, bool match_seed) {
+                 return std::make_unique<SearchCache>(
+                     capacity,
+                     match_seed ? SearchCache::SeedPolicy::Match
+                                : SearchCache::SeedPolicy::Ignore);
+             }),
+             py::arg("capacity"),
+             py::arg("match_seed") = false,
+             DOC_IMPL(SearchCache, SearchCache))
+        .def("run",
+             [](SearchCache &cache,
+                Graph &graph,
+                const std::string &strategy,
+                int seed,
+                double time_limit)
+             {
+                 std::unordered_map<std::string, std::any> params;
+                 if (time_limit > 0)
+                 {
+                     params["timeLimit"] = time_limit;
+                 }
+                 return cache.run(graph, strategy, seed, params);
+             },
+             py::arg("graph"),
+             py::arg("strategy"),
+             py::arg("seed"),
+             py::arg("time_limit") = 0.0,
+             py::call_guard<py::gil_scoped_release>(),
+             DOC_IMPL(SearchCache, run))
+        .def("clear", &SearchCache::clear,
+             DOC_IMPL(SearchCache, clear))
+        .def_property_readonly("hits", &SearchCache::hits)
+        .def_property_readonly("misses", &SearchCache::misses)
+        .def_property_readonly("capacity", &SearchCache::capacity)
+        .def("__len__", &SearchCache::size)
+        .def("__repr__", [](const SearchCache &c) {
+            return "<SearchCache(size=" + std::to_string(c.size()) +
+                   ", hits=" + std::to_string(c.hits()) +
+                   ", misses=" + std::to_string(c.misses()) + ")>";
+        });
+
     // ========================================================================
     // Problem data class bindings
     // ========================================================================
@@ -208,13 +473,31 @@ PYBIND11_MODULE(_pycnp, m)
         .def(py::init<int>(),
              py::arg("num_nodes"),
              DOC_IMPL(ProblemData, ProblemData))
+        .def_static("read_from_file",
+                    &ProblemData::readFromFile,
+                    py::arg("filename"),
+                    py::call_guard<py::gil_scoped_release>(),
+                    DOC_IMPL(ProblemData, readFromFile))
+        .def_static("load_binary",
+                    &ProblemData::loadBinary,
+                    py::arg("filename"),
+                    py::call_guard<py::gil_scoped_release>(),
+                    DOC_IMPL(ProblemData, loadBinary))
+        .def("save_binary",
+             &ProblemData::saveBinary,
+             py::arg("filename"),
+             py::arg("hop_distance") = 0,
+             py::call_guard<py::gil_scoped_release>(),
+             DOC_IMPL(ProblemData, saveBinary))
         .def_static("read_from_adjacency_list_file",
                     &ProblemData::readFromAdjacencyListFile,
                     py::arg("filename"),
+                    py::call_guard<py::gil_scoped_release>(),
                     DOC_IMPL(ProblemData, readFromAdjacencyListFile))
         .def_static("read_from_edge_list_format",
                     &ProblemData::readFromEdgeListFormat,
                     py::arg("filename"),
+                    py::call_guard<py::gil_scoped_release>(),
                     DOC_IMPL(ProblemData, readFromEdgeListFormat))
         .def("create_original_graph",
              &ProblemData::createOriginalGraph,
@@ -222,6 +505,9 @@ PYBIND11_MODULE(_pycnp, m)
              py::arg("budget"),
              py::arg("seed"),
              py::arg("hop_distance") = std::numeric_limits<int>::max(),
+             py::arg("tree_storage") = "auto",
+             py::arg("kernelize") = false,
+             py::call_guard<py::gil_scoped_release>(),
              DOC_IMPL(ProblemData, createOriginalGraph))
         .def("add_node", &ProblemData::addNode,
              py::arg("node_id"),
@@ -229,6 +515,17 @@ PYBIND11_MODULE(_pycnp, m)
         .def("add_edge", &ProblemData::addEdge,
              py::arg("u"), py::arg("v"),
              DOC_IMPL(ProblemData, addEdge))
+        .def("add_node_weight", &ProblemData::addNodeWeight,
+             py::arg("node_id"), py::arg("weight"),
+             DOC_IMPL(ProblemData, addNodeWeight))
+        .def("get_node_weight", &ProblemData::getNodeWeight,
+             py::arg("node_id"),
+             DOC_IMPL(ProblemData, getNodeWeight))
+        .def("read_node_weights_from_file",
+             &ProblemData::readNodeWeightsFromFile,
+             py::arg("filename"),
+             py::call_guard<py::gil_scoped_release>(),
+             DOC_IMPL(ProblemData, readNodeWeightsFromFile))
         .def("get_nodes_set", &ProblemData::getNodesSet,
              py::return_value_policy::reference_internal,
              DOC_IMPL(ProblemData, getNodesSet))
@@ -255,7 +552,7 @@ PYBIND11_MODULE(_pycnp, m)
              py::arg("max_idle_gens"),
              py::arg("seed"))
         .def("update",
-             [=](Population &self, const py::set &solution_set, int obj_value,
+             [=](Population &self, const py::set &solution_set, ObjValue obj_value,
                 int num_idle_generations, bool verbose) {
                  try {
                      // Parameter validation
@@ -268,6 +565,7 @@ PYBIND11_MODULE(_pycnp, m)
 
                      // Convert solution set
                      Solution sol = pysetToSolution(solution_set);
+                     py::gil_scoped_release release;
                      self.update(sol, obj_value, num_idle_generations, verbose);
                  } catch (const std::exception& e) {
                      throw std::runtime_error("Population update failed: " + std::string(e.what()));
@@ -278,18 +576,49 @@ PYBIND11_MODULE(_pycnp, m)
              py::arg("num_idle_generations"),
              py::arg("verbose") = false,
              DOC_IMPL(Population, update))
+        .def("update_batch",
+             [](Population &self, const std::vector<py::set> &solution_sets,
+                const std::vector<ObjValue> &obj_values, int num_idle_generations, bool verbose) {
+                 if (solution_sets.size() != obj_values.size()) {
+                     throw std::invalid_argument("Need one objective value per solution");
+                 }
+                 if (num_idle_generations < 0) {
+                     throw std::invalid_argument("Number of idle generations must be non-negative");
+                 }
+
+                 std::vector<std::pair<Solution, ObjValue>> offspring;
+                 offspring.reserve(solution_sets.size());
+                 for (size_t i = 0; i < solution_sets.size(); ++i) {
+                     if (obj_values[i] < 0) {
+                         throw std::invalid_argument("Objective value must be non-negative");
+                     }
+                     offspring.emplace_back(pysetToSolution(solution_sets[i]), obj_values[i]);
+                 }
+
+                 py::gil_scoped_release release;
+                 self.updateBatch(offspring, num_idle_generations, verbose);
+             },
+             py::arg("solutions"),
+             py::arg("obj_values"),
+             py::arg("num_idle_generations"),
+             py::arg("verbose") = false,
+             DOC_IMPL(Population, updateBatch))
         .def("initialize",
              [=](Population &self, bool display, py::object stopping_criterion_obj) {
                  try {
                      // Build stopping criterion function
-                     std::function<bool(int)> stopping_criterion = nullptr;
+                     std::function<bool(ObjValue)> stopping_criterion = nullptr;
                      if (!stopping_criterion_obj.is_none()) {
                          // Verify if stopping criterion object is callable
                          if (!py::hasattr(stopping_criterion_obj, "__call__")) {
                              throw std::invalid_argument("Stopping criterion must be callable");
                          }
 
-                         stopping_criterion = [=](int best_obj_value) -> bool {
+                         // Called with the GIL released; the object outlives
+                         // the call, so it is captured by reference and copies
+                         // of the function never touch its reference count.
+                         stopping_criterion = [&stopping_criterion_obj](ObjValue best_obj_value) -> bool {
+                             py::gil_scoped_acquire gil;
                              try {
                                  return stopping_criterion_obj(best_obj_value).cast<bool>();
                              } catch (const py::cast_error& e) {
@@ -298,7 +627,12 @@ PYBIND11_MODULE(_pycnp, m)
                          };
                      }
 
-                     auto [solution, obj_value] = self.initialize(display, stopping_criterion);
+                     std::pair<Solution, ObjValue> best;
+                     {
+                         py::gil_scoped_release release;
+                         best = self.initialize(display, stopping_criterion);
+                     }
+                     auto &[solution, obj_value] = best;
                      return std::make_pair(solutionToPyset(solution), obj_value);
                  } catch (const std::exception& e) {
                      throw std::runtime_error("Population initialization failed: " + std::string(e.what()));
@@ -310,7 +644,11 @@ PYBIND11_MODULE(_pycnp, m)
              [=](Population &p) {
                  try {
                      // Tournament selection of two different solutions as parents
-                     auto result = p.tournamentSelectTwoSolutions();
+                     std::pair<Solution, Solution> result;
+                     {
+                         py::gil_scoped_release release;
+                         result = p.tournamentSelectTwoSolutions();
+                     }
                      py::tuple py_result(2);
                      py_result[0] = solutionToPyset(result.first);
                      py_result[1] = solutionToPyset(result.second);
@@ -336,8 +674,240 @@ PYBIND11_MODULE(_pycnp, m)
              DOC_IMPL(Population, getAllThreeSolutions))
         .def("get_size", &Population::getSize,
              DOC_IMPL(Population, getSize))
+        .def("set_num_threads", &Population::setNumThreads,
+             py::arg("num_threads"),
+             DOC_IMPL(Population, setNumThreads))
+        .def("set_time_limit",
+             [](Population &self, double time_limit) {
+                 // All searches of one initialization share the deadline.
+                 std::unordered_map<std::string, std::any> params;
+                 if (time_limit > 0)
+                 {
+                     params["deadline"]
+                         = std::chrono::steady_clock::now()
+                           + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                               std::chrono::duration<double>(time_limit));
+                 }
+                 self.setSearchParams(std::move(params));
+             },
+             py::arg("time_limit"),
+             DOC_IMPL(Population, setSearchParams))
+        .def("is_duplicate",
+             [](const Population &self, const py::set &solution) {
+                 return self.isDuplicate(pysetToSolution(solution));
+             },
+             py::arg("solution"),
+             DOC_IMPL(Population, isDuplicate))
+        .def("set_tabu_archive_size", &Population::setTabuArchiveSize,
+             py::arg("size"),
+             DOC_IMPL(Population, setTabuArchiveSize))
+        .def("mark_evaluated",
+             [](Population &self, const py::set &solution) {
+                 return self.markEvaluated(pysetToSolution(solution));
+             },
+             py::arg("solution"),
+             DOC_IMPL(Population, markEvaluated))
         ;
 
+    // Checkpoint binding - Resumable state of a memetic search
+    py::class_<Checkpoint>(m, "Checkpoint", DOC_IMPL(Checkpoint))
+        .def_static("capture",
+                    [](const Population &population,
+                       const Graph &graph,
+                       const std::string &problem_type,
+                       int64_t budget,
+                       const std::string &search,
+                       const std::string &crossover) {
+                        return Checkpoint::capture(
+                            {problem_type, budget, search, crossover}, population, graph);
+                    },
+                    py::arg("population"),
+                    py::arg("graph"),
+                    py::arg("problem_type"),
+                    py::arg("budget"),
+                    py::arg("search"),
+                    py::arg("crossover"),
+                    DOC_IMPL(Checkpoint, capture))
+        .def("restore",
+             [](const Checkpoint &self,
+                Population &population,
+                const Graph &graph,
+                const std::string &problem_type,
+                int64_t budget,
+                const std::string &search,
+                const std::string &crossover) {
+                 self.restore({problem_type, budget, search, crossover}, population, graph);
+             },
+             py::arg("population"),
+             py::arg("graph"),
+             py::arg("problem_type"),
+             py::arg("budget"),
+             py::arg("search"),
+             py::arg("crossover"),
+             DOC_IMPL(Checkpoint, restore))
+        .def("save",
+             &Checkpoint::save,
+             py::arg("filename"),
+             py::call_guard<py::gil_scoped_release>(),
+             DOC_IMPL(Checkpoint, save))
+        .def_static("load",
+                    &Checkpoint::load,
+                    py::arg("filename"),
+                    py::call_guard<py::gil_scoped_release>(),
+                    DOC_IMPL(Checkpoint, load))
+        .def_readwrite("seed_stream", &Checkpoint::seedStream)
+        .def_property(
+            "best_solution",
+            [](const Checkpoint &c) {
+                py::set nodes;
+                for (Node node : c.bestSolution)
+                {
+                    nodes.add(node);
+                }
+                return nodes;
+            },
+            [](Checkpoint &c, const py::set &solution) {
+                c.bestSolution = pysetToSolution(solution).nodes();
+            })
+        .def_readwrite("best_obj_value", &Checkpoint::bestObjValue)
+        .def_readwrite("num_generations", &Checkpoint::numGenerations)
+        .def_readwrite("num_idle_generations", &Checkpoint::numIdleGenerations)
+        .def_readwrite("num_search_steps", &Checkpoint::numSearchSteps)
+        .def_readwrite("runtime", &Checkpoint::runtime)
+        .def_readwrite("best_found_at_time", &Checkpoint::bestFoundAtTime)
+        .def_readonly("num_nodes", &Checkpoint::numNodes)
+        .def_property_readonly("problem_type",
+                               [](const Checkpoint &c) { return c.config.problemType; })
+        .def_property_readonly("budget", [](const Checkpoint &c) { return c.config.budget; })
+        .def_property_readonly("search", [](const Checkpoint &c) { return c.config.search; })
+        .def_property_readonly("crossover",
+                               [](const Checkpoint &c) { return c.config.crossover; })
+        .def_property_readonly("population_size", [](const Checkpoint &c) {
+            return c.population.solutions.size();
+        });
+
+    // CheckpointWriter binding - Background saving of checkpoints
+    py::class_<CheckpointWriter>(m, "CheckpointWriter", DOC_IMPL(CheckpointWriter))
+        .def(py::init<>())
+        .def("submit",
+             &CheckpointWriter::submit,
+             py::arg("checkpoint"),
+             py::arg("filename"),
+             DOC_IMPL(CheckpointWriter, submit))
+        .def("wait",
+             &CheckpointWriter::wait,
+             py::call_guard<py::gil_scoped_release>(),
+             DOC_IMPL(CheckpointWriter, wait))
+        .def_property_readonly("num_written", &CheckpointWriter::numWritten);
+
+    // ========================================================================
+    // Memetic engine class bindings
+    // ========================================================================
+
+    // MemeticEngine::Result binding - Outcome of an island-model run
+    py::class_<MemeticEngine::Result>(m, "MemeticEngineResult", DOC_IMPL(MemeticEngine, Result))
+        .def_property_readonly("best_solution",
+                               [](const MemeticEngine::Result &r) { return solutionToPyset(r.bestSolution); })
+        .def_readonly("best_obj_value", &MemeticEngine::Result::bestObjValue)
+        .def_readonly("num_generations", &MemeticEngine::Result::numGenerations)
+        .def_readonly("num_migrations", &MemeticEngine::Result::numMigrations)
+        .def_readonly("runtime", &MemeticEngine::Result::runtime)
+        .def_readonly("best_found_at_time", &MemeticEngine::Result::bestFoundAtTime)
+        .def_readonly("search_cache_hits", &MemeticEngine::Result::searchCacheHits)
+        .def_readonly("search_cache_misses", &MemeticEngine::Result::searchCacheMisses)
+        .def("__repr__", [](const MemeticEngine::Result &r) {
+            return "<MemeticEngineResult(best_obj_value=" + std::to_string(r.bestObjValue) +
+                   ", num_generations=" + std::to_string(r.numGenerations) + ")>";
+        });
+
+    // MemeticEngine binding - Island-model memetic search run from C++
+    py::class_<MemeticEngine>(m, "MemeticEngine", DOC_IMPL(MemeticEngine))
+        .def(py::init(
+                 [](const ProblemData &problem_data, const std::string &problem_type,
+                    int budget, int seed, const std::string &search,
+                    const std::string &crossover, const std::string &reduce_search,
+                    double reduce_beta, bool is_pop_variable, int initial_pop_size,
+                    int max_pop_size, int increase_pop_size, int max_idle_gens,
+                    int hop_distance, const std::string &tree_storage,
+                    int num_offspring, int num_islands, int migration_interval,
+                    size_t tabu_archive_size, size_t search_cache_size,
+                    double time_limit, bool kernelize, int num_shards) {
+                     MemeticEngine::Params params;
+                     params.search = search;
+                     params.crossover = crossover;
+                     params.reduceSearch = reduce_search;
+                     params.reduceBeta = reduce_beta;
+                     params.isPopVariable = is_pop_variable;
+                     params.initialPopSize = initial_pop_size;
+                     params.maxPopSize = max_pop_size;
+                     params.increasePopSize = increase_pop_size;
+                     params.maxIdleGens = max_idle_gens;
+                     params.hopDistance = hop_distance;
+                     params.treeStorage = tree_storage;
+                     params.numOffspring = num_offspring;
+                     params.numIslands = num_islands;
+                     params.migrationInterval = migration_interval;
+                     params.tabuArchiveSize = tabu_archive_size;
+                     params.searchCacheSize = search_cache_size;
+                     params.timeLimit = time_limit;
+                     params.kernelize = kernelize;
+                     params.numShards = num_shards;
+                     return std::make_unique<MemeticEngine>(
+                         problem_data, problem_type, budget, seed, params);
+                 }),
+             py::arg("problem_data"),
+             py::arg("problem_type"),
+             py::arg("budget"),
+             py::arg("seed"),
+             py::arg("search") = "CHNS",
+             py::arg("crossover") = "RSC",
+             py::arg("reduce_search") = "CHNS",
+             py::arg("reduce_beta") = 0.9,
+             py::arg("is_pop_variable") = true,
+             py::arg("initial_pop_size") = 5,
+             py::arg("max_pop_size") = 20,
+             py::arg("increase_pop_size") = 3,
+             py::arg("max_idle_gens") = 20,
+             py::arg("hop_distance") = std::numeric_limits<int>::max(),
+             py::arg("tree_storage") = "auto",
+             py::arg("num_offspring") = 1,
+             py::arg("num_islands") = 1,
+             py::arg("migration_interval") = 20,
+             py::arg("tabu_archive_size") = 0,
+             py::arg("search_cache_size") = 0,
+             py::arg("time_limit") = 0.0,
+             py::arg("kernelize") = false,
+             py::arg("num_shards") = 1,
+             py::keep_alive<1, 2>(),
+             DOC_IMPL(MemeticEngine, MemeticEngine))
+        .def("run",
+             [](MemeticEngine &engine,
+                py::object stopping_criterion_obj,
+                std::shared_ptr<ProgressQueue> progress_queue) {
+                 if (!py::hasattr(stopping_criterion_obj, "__call__")) {
+                     throw std::invalid_argument("Stopping criterion must be callable");
+                 }
+
+                 // Islands call the criterion from their own threads, one at
+                 // a time; it gets the best objective value like the
+                 // criteria of pycnp.stop.
+                 MemeticEngine::StoppingCriterion stopping_criterion =
+                     [&stopping_criterion_obj](const MemeticEngine::Progress &progress) {
+                         py::gil_scoped_acquire gil;
+                         try {
+                             return stopping_criterion_obj(progress.bestObjValue).cast<bool>();
+                         } catch (const py::cast_error &) {
+                             throw std::runtime_error("Stopping criterion must return boolean value");
+                         }
+                     };
+
+                 py::gil_scoped_release release;
+                 return engine.run(stopping_criterion, std::move(progress_queue));
+             },
+             py::arg("stopping_criterion"),
+             py::arg("progress_queue") = py::none(),
+             DOC_IMPL(MemeticEngine, run));
+
     // ========================================================================
     // Search result class bindings
     // ========================================================================
@@ -354,6 +924,8 @@ PYBIND11_MODULE(_pycnp, m)
                                   }
                               })
         .def_readwrite("obj_value", &SearchResult::objValue)
+        .def_readwrite("num_steps", &SearchResult::numSteps)
+        .def_readwrite("interrupted", &SearchResult::interrupted)
         .def("__repr__", [](const SearchResult &r) {
             return "<SearchResult(obj_value=" + std::to_string(r.objValue) +
                    ", solution_size=" + std::to_string(r.solution.size()) + ")>";
@@ -367,33 +939,55 @@ PYBIND11_MODULE(_pycnp, m)
     py::class_<CNP_Graph>(m, "CNP_Graph", DOC_IMPL(CNP_Graph))
         .def(py::init<>())
         .def("clone", &CNP_Graph::clone, DOC_IMPL(CNP_Graph, clone))
-        .def("update_graph_by_removed_nodes", &CNP_Graph::updateGraphByRemovedNodes)
-        .def("get_reduced_graph_by_removed_nodes", &CNP_Graph::getReducedGraphByRemovedNodes)
+        .def("update_graph_by_removed_nodes",
+             [](CNP_Graph &g, const py::set &nodes) { g.updateGraphByRemovedNodes(pysetToSolution(nodes)); })
+        .def("get_reduced_graph_by_removed_nodes",
+             [](CNP_Graph &g, const py::set &nodes) { g.getReducedGraphByRemovedNodes(pysetToSolution(nodes)); })
         .def("add_node", &CNP_Graph::addNode)
         .def("remove_node", &CNP_Graph::removeNode)
         .def("is_node_removed", &CNP_Graph::isNodeRemoved)
         .def("get_num_nodes", &CNP_Graph::getNumNodes)
-        .def("get_removed_nodes", &CNP_Graph::getRemovedNodes, py::return_value_policy::reference_internal)
+        .def("get_removed_nodes", [](const CNP_Graph &g) { return solutionToPyset(g.getRemovedNodes()); })
         .def("set_node_age", &CNP_Graph::setNodeAge)
         .def("get_objective_value", &CNP_Graph::getObjectiveValue)
-        .def_readwrite("removed_nodes", &CNP_Graph::removedNodes);
+        .def("set_gain_cache_enabled",
+             &CNP_Graph::setGainCacheEnabled,
+             py::arg("enabled"),
+             DOC_IMPL(CNP_Graph, setGainCacheEnabled))
+        .def("set_impact_cache_enabled",
+             &CNP_Graph::setImpactCacheEnabled,
+             py::arg("enabled"),
+             DOC_IMPL(CNP_Graph, setImpactCacheEnabled))
+        .def("removal_split_sizes",
+             &CNP_Graph::removalSplitSizes,
+             py::arg("node"),
+             DOC_IMPL(CNP_Graph, removalSplitSizes))
+        .def_property("removed_nodes",
+                      [](const CNP_Graph &g) { return solutionToPyset(g.getRemovedNodes()); },
+                      [](CNP_Graph &g, const py::set &nodes) { g.updateGraphByRemovedNodes(pysetToSolution(nodes)); });
 
     // DCNP_Graph binding - Distance-based Critical Node Problem graph implementation
     py::class_<DCNP_Graph>(m, "DCNP_Graph", DOC_IMPL(DCNP_Graph))
         .def(py::init<>())
-        .def("update_graph_by_removed_nodes", &DCNP_Graph::updateGraphByRemovedNodes)
-        .def("get_reduced_graph_by_removed_nodes", &DCNP_Graph::getReducedGraphByRemovedNodes)
+        .def("update_graph_by_removed_nodes",
+             [](DCNP_Graph &g, const py::set &nodes) { g.updateGraphByRemovedNodes(pysetToSolution(nodes)); })
+        .def("get_reduced_graph_by_removed_nodes",
+             [](DCNP_Graph &g, const py::set &nodes) { g.getReducedGraphByRemovedNodes(pysetToSolution(nodes)); })
         .def("remove_node", &DCNP_Graph::removeNode)
         .def("add_node", &DCNP_Graph::addNode)
         .def("set_node_age", &DCNP_Graph::setNodeAge)
         .def("is_node_removed", &DCNP_Graph::isNodeRemoved)
-        .def("get_removed_nodes", &DCNP_Graph::getRemovedNodes, py::return_value_policy::reference_internal)
+        .def("get_removed_nodes", [](const DCNP_Graph &g) { return solutionToPyset(g.getRemovedNodes()); })
         .def("get_num_nodes", &DCNP_Graph::getNumNodes)
         .def("get_objective_value", &DCNP_Graph::getObjectiveValue)
         .def("get_random_feasible_graph", &DCNP_Graph::getRandomFeasibleGraph)
         .def("build_tree", &DCNP_Graph::buildTree)
         .def("calculate_k_hop_tree_size", &DCNP_Graph::calculateKhopTreeSize)
-        .def("calculate_betweenness_centrality", &DCNP_Graph::calculateBetweennessCentrality, py::return_value_policy::reference_internal)
+        .def("calculate_betweenness_centrality",
+             &DCNP_Graph::calculateBetweennessCentrality,
+             py::arg("max_depth") = 0,
+             py::arg("num_pivots") = 0,
+             DOC_IMPL(DCNP_Graph, calculateBetweennessCentrality))
         .def("find_best_node_to_remove", &DCNP_Graph::findBestNodeToRemove)
         .def("find_best_node_to_add", &DCNP_Graph::findBestNodeToAdd)
         .def("clone", &DCNP_Graph::clone);
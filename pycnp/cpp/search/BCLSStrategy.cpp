@@ -1,11 +1,14 @@
 #include "BCLSStrategy.h"
+#include "CandidateQueue.h"
+#include "SearchBudget.h"
+#include "SearchProgress.h"
 #include "SearchResult.h"
 #include "SearchUtils.h"
+#include "Trace.h"
 #include <algorithm>
 #include <iostream>
-#include <iterator>
-#include <list>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
 BCLSStrategy::BCLSStrategy(
@@ -15,11 +18,18 @@ BCLSStrategy::BCLSStrategy(
     maxIdleSteps_ = SearchUtils::getParamOr<int>(params, "maxIdleSteps", maxIdleSteps_);
     selectionProb_
         = SearchUtils::getParamOr<double>(params, "selectionProb", selectionProb_);
+    betweennessDepth_ = SearchUtils::getParamOr<int>(
+        params, "betweennessDepth", betweennessDepth_);
+    betweennessPivots_ = SearchUtils::getParamOr<int>(
+        params, "betweennessPivots", betweennessPivots_);
     SearchUtils::applySeed(params, rng_);
 }
 
 SearchResult BCLSStrategy::execute()
 {
+    PYCNP_TRACE_PHASE(BCLS);
+    SearchBudget budget(params_);
+    SearchProgress progress(params_);
 
     SearchResult result;
 
@@ -34,9 +44,10 @@ SearchResult BCLSStrategy::execute()
 
     bestSolution = dcnpGraph->getRemovedNodes();
 
-    int currentObjValue = graph_.getObjectiveValue();
-    int bestObjValue = currentObjValue;
+    ObjValue currentObjValue = graph_.getObjectiveValue();
+    ObjValue bestObjValue = currentObjValue;
     long numIdleSteps = 0;
+    long numSteps = 0;
 
     std::vector<Node> sortedNodes;
     sortedNodes.reserve(currentGraph.getNumNodes());
@@ -45,27 +56,27 @@ SearchResult BCLSStrategy::execute()
         sortedNodes.push_back(i);
     }
 
-    const std::vector<double> &centrality
-        = currentGraph.calculateBetweennessCentrality();
+    const std::vector<double> centrality
+        = currentGraph.calculateBetweennessCentrality(betweennessDepth_,
+                                                      betweennessPivots_);
     std::sort(sortedNodes.begin(),
             sortedNodes.end(),
             [&centrality](int a, int b)
             { return centrality[a] > centrality[b]; });
 
-    std::list<Node> candidateNodes(sortedNodes.begin(), sortedNodes.end());
+    CandidateQueue candidateNodes(sortedNodes);
 
-    auto it_5 = candidateNodes.begin();
-    updateIteratorTo5th(candidateNodes, it_5);
-
-    while (numIdleSteps < maxIdleSteps_)
+    while (numIdleSteps < maxIdleSteps_ && !budget.exhausted(numSteps))
     {
-        performMove(currentGraph, currentObjValue, candidateNodes, it_5);
+        numSteps++;
+        performMove(currentGraph, currentObjValue, candidateNodes);
 
         if (currentObjValue < bestObjValue)
         {
             // getRemovedNodes now returns a const reference; this creates a copy of the current best solution
             bestSolution = currentGraph.getRemovedNodes();
             bestObjValue = currentObjValue;
+            progress.improved(bestSolution, bestObjValue, numSteps);
             numIdleSteps = 0;
         }
         else
@@ -74,16 +85,17 @@ SearchResult BCLSStrategy::execute()
         }
     }
 
-    result.solution = bestSolution;
+    result.solution = std::move(bestSolution);
     result.objValue = bestObjValue;
+    result.numSteps = numSteps;
+    result.interrupted = budget.interrupted();
 
     return result;
 }
 
 void BCLSStrategy::performMove(Graph &currentGraph,
-                            int &currentObjValue,
-                            std::list<Node> &candidateNodes,
-                            std::list<Node>::iterator &it_5)
+                            ObjValue &currentObjValue,
+                            CandidateQueue &candidateNodes)
 {
 
     if (candidateNodes.empty())
@@ -98,9 +110,7 @@ void BCLSStrategy::performMove(Graph &currentGraph,
         double r = rng_.generateProbability();
 
         Node removedNode = candidateNodes.front();
-        candidateNodes.pop_front();
-
-        updateIteratorTo5th(candidateNodes, it_5);
+        candidateNodes.popFront();
 
         if (currentGraph.isNodeRemoved(removedNode))
         {
@@ -115,13 +125,11 @@ void BCLSStrategy::performMove(Graph &currentGraph,
             if (BestNodeToAdd != INVALID_NODE)
             {
                 currentGraph.addNode(BestNodeToAdd);
-                candidateNodes.push_back(BestNodeToAdd);
-                updateIteratorTo5th(candidateNodes, it_5);
+                candidateNodes.pushBack(BestNodeToAdd);
             }
             else
             {
-                candidateNodes.push_front(removedNode);
-                updateIteratorTo5th(candidateNodes, it_5);
+                candidateNodes.pushFront(removedNode);
                 continue;
             }
             currentObjValue = currentGraph.getObjectiveValue();
@@ -129,34 +137,8 @@ void BCLSStrategy::performMove(Graph &currentGraph,
         }
         else
         {
-
-            if (candidateNodes.size() >= 5 && it_5 != candidateNodes.end())
-            {
-                candidateNodes.insert(std::next(it_5), removedNode);
-            }
-            else
-            {
-                candidateNodes.push_back(removedNode);
-            }
-            updateIteratorTo5th(candidateNodes, it_5);
+            candidateNodes.insertAt(
+                std::min(REINSERT_POSITION, candidateNodes.size()), removedNode);
         }
     }
 }
-
-void BCLSStrategy::updateIteratorTo5th(std::list<Node> &candidateNodes,
-                                    std::list<Node>::iterator &it_5)
-{
-    if (candidateNodes.size() >= 5)
-    {
-        it_5 = candidateNodes.begin();
-        std::advance(it_5, 4);
-    }
-    else if (!candidateNodes.empty())
-    {
-        it_5 = std::prev(candidateNodes.end());
-    }
-    else
-    {
-        it_5 = candidateNodes.end();
-    }
-}
\ No newline at end of file
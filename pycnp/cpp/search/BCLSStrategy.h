@@ -5,9 +5,10 @@
 #include "RandomNumberGenerator.h"
 #include "SearchStrategy.h"
 #include <any>
-#include <list>
 #include <unordered_map>
 
+class CandidateQueue;
+
 /**
  * BCLSStrategy
  *
@@ -15,6 +16,11 @@
  *
  * BCLS (Betweenness centrality-based late-acceptance search) strategy
  * uses node betweenness centrality to guide the search.
+ *
+ * Besides ``"maxIdleSteps"`` and ``"selectionProb"``, the parameters
+ * ``"betweennessDepth"`` and ``"betweennessPivots"`` (int) select the
+ * bounded or sampled approximation of the centrality ranking; see
+ * DCNP_Graph::calculateBetweennessCentrality.
  */
 class BCLSStrategy : public SearchStrategy
 {
@@ -52,8 +58,13 @@ private:
     std::unordered_map<std::string, std::any> params_;  ///< Algorithm parameters
     int maxIdleSteps_ = 150;                            ///< Maximum idle steps, default 150
     double selectionProb_ = 0.8;                        ///< Selection probability, default 0.8
+    int betweennessDepth_ = 0;                          ///< Path length bound, default 0 (exact)
+    int betweennessPivots_ = 0;                         ///< Sampled sources, default 0 (all)
     RandomNumberGenerator rng_;                         ///< Random number generator
 
+    /// Candidates passed over by a draw are reinserted after this many.
+    static constexpr size_t REINSERT_POSITION = 5;
+
     /**
      * Perform one move operation.
      *
@@ -64,20 +75,12 @@ private:
      * currentObjValue
      *     Current objective function value, will be updated.
      * candidateNodes
-     *     List of candidate nodes.
-     * it_5
-     *     Iterator pointing to the 5th element in the candidate nodes list.
+     *     Candidate nodes, most central first. Removed nodes reaching the
+     *     front are dropped.
      */
     void performMove(Graph &currentGraph,
-                     int &currentObjValue,
-                     std::list<Node> &candidateNodes,
-                     std::list<Node>::iterator &it_5);
-
-    /**
-     * Update iterator pointing to the 5th (or last) candidate node.
-     */
-    void updateIteratorTo5th(std::list<Node> &candidateNodes,
-                             std::list<Node>::iterator &it_5);
+                     ObjValue &currentObjValue,
+                     CandidateQueue &candidateNodes);
 };
 
 #endif  // BCLS_STRATEGY_H
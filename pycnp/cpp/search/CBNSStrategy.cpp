@@ -1,6 +1,10 @@
 #include "CBNSStrategy.h"
+#include "SearchBudget.h"
+#include "SearchProgress.h"
 #include "SearchResult.h"
 #include "SearchUtils.h"
+#include "Trace.h"
+#include <utility>
 
 CBNSStrategy::CBNSStrategy(
     Graph &graph, const std::unordered_map<std::string, std::any> &params)
@@ -12,18 +16,21 @@ CBNSStrategy::CBNSStrategy(
 
 SearchResult CBNSStrategy::execute()
 {
+    PYCNP_TRACE_PHASE(CBNS);
+    SearchBudget budget(params_);
+    SearchProgress progress(params_);
 
     SearchResult result;
 
     Graph &currentGraph = graph_;
     Solution bestSolution = graph_.getRemovedNodes();
 
-    int currentObjValue = graph_.getObjectiveValue();
-    int bestObjValue = currentObjValue;
+    ObjValue currentObjValue = graph_.getObjectiveValue();
+    ObjValue bestObjValue = currentObjValue;
     long numIdleSteps = 0;
     long numSteps = 0;
 
-    while (numIdleSteps < maxIdleSteps_)
+    while (numIdleSteps < maxIdleSteps_ && !budget.exhausted(numSteps))
     {
         numSteps++;
 
@@ -34,6 +41,7 @@ SearchResult CBNSStrategy::execute()
             // getRemovedNodes now returns a const reference; this creates a copy of the current best solution
             bestSolution = currentGraph.getRemovedNodes();
             bestObjValue = currentObjValue;
+            progress.improved(bestSolution, bestObjValue, numSteps);
             numIdleSteps = 0;
         }
         else
@@ -42,14 +50,16 @@ SearchResult CBNSStrategy::execute()
         }
     }
 
-    result.solution = bestSolution;
+    result.solution = std::move(bestSolution);
     result.objValue = bestObjValue;
+    result.numSteps = numSteps;
+    result.interrupted = budget.interrupted();
 
     return result;
 }
 
 void CBNSStrategy::performMove(Graph &currentGraph,
-                               int &currentObjValue,
+                               ObjValue &currentObjValue,
                                long numSteps)
 {
 
@@ -1,6 +1,10 @@
 #include "CHNSStrategy.h"
+#include "SearchBudget.h"
+#include "SearchProgress.h"
 #include "SearchResult.h"
 #include "SearchUtils.h"
+#include "Trace.h"
+#include <utility>
 
 CHNSStrategy::CHNSStrategy(
     Graph &graph, const std::unordered_map<std::string, std::any> &params)
@@ -13,18 +17,21 @@ CHNSStrategy::CHNSStrategy(
 
 SearchResult CHNSStrategy::execute()
 {
+    PYCNP_TRACE_PHASE(CHNS);
+    SearchBudget budget(params_);
+    SearchProgress progress(params_);
 
     SearchResult result;
 
     Graph &currentGraph = graph_;
     Solution bestSolution = currentGraph.getRemovedNodes();
 
-    int currentObjValue = graph_.getObjectiveValue();
-    int bestObjValue = currentObjValue;
+    ObjValue currentObjValue = graph_.getObjectiveValue();
+    ObjValue bestObjValue = currentObjValue;
     long numSteps = 0;
     long numIdleSteps = 0;
 
-    while (numIdleSteps < maxIdleSteps_)
+    while (numIdleSteps < maxIdleSteps_ && !budget.exhausted(numSteps))
     {
         numSteps++;
 
@@ -35,6 +42,7 @@ SearchResult CHNSStrategy::execute()
             // getRemovedNodes now returns a const reference; this creates a copy of the current best solution
             bestSolution = currentGraph.getRemovedNodes();
             bestObjValue = currentObjValue;
+            progress.improved(bestSolution, bestObjValue, numSteps);
             numIdleSteps = 0;
         }
         else
@@ -43,13 +51,15 @@ SearchResult CHNSStrategy::execute()
         }
     }
 
-    result.solution = bestSolution;
+    result.solution = std::move(bestSolution);
     result.objValue = bestObjValue;
+    result.numSteps = numSteps;
+    result.interrupted = budget.interrupted();
     return result;
 }
 
 void CHNSStrategy::performMove(Graph &currentGraph,
-                               int &currentObjValue,
+                               ObjValue &currentObjValue,
                                long numSteps)
 {
 
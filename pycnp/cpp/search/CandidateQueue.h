@@ -0,0 +1,103 @@
+#ifndef CANDIDATE_QUEUE_H
+#define CANDIDATE_QUEUE_H
+
+#include "Graph/Types.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/**
+ * CandidateQueue
+ *
+ * Double-ended queue of candidate nodes in a contiguous ring buffer.
+ *
+ * Besides pushing and popping at both ends, a node can be inserted at a
+ * small position ``k`` from the front by shifting the first ``k`` entries,
+ * which keeps a "reinsert after the first few candidates" step constant
+ * time without the pointer chasing of a linked list.
+ */
+class CandidateQueue
+{
+public:
+    /// Creates a queue holding ``nodes`` in order.
+    explicit CandidateQueue(const std::vector<Node> &nodes)
+        : nodes_(std::bit_ceil(std::max<size_t>(nodes.size(), 1))),
+          size_(nodes.size())
+    {
+        std::copy(nodes.begin(), nodes.end(), nodes_.begin());
+    }
+
+    bool empty() const noexcept { return size_ == 0; }
+    size_t size() const noexcept { return size_; }
+
+    Node front() const { return nodes_[head_]; }
+
+    void popFront()
+    {
+        head_ = (head_ + 1) & mask();
+        --size_;
+    }
+
+    void pushFront(Node node)
+    {
+        reserveOne();
+        head_ = (head_ - 1) & mask();
+        nodes_[head_] = node;
+        ++size_;
+    }
+
+    void pushBack(Node node)
+    {
+        reserveOne();
+        at(size_) = node;
+        ++size_;
+    }
+
+    /**
+     * Inserts ``node`` so that ``position`` nodes precede it.
+     *
+     * Takes time linear in ``position``, which must not exceed size().
+     */
+    void insertAt(size_t position, Node node)
+    {
+        reserveOne();
+        head_ = (head_ - 1) & mask();
+        for (size_t i = 0; i < position; ++i)
+        {
+            at(i) = at(i + 1);
+        }
+        at(position) = node;
+        ++size_;
+    }
+
+private:
+    std::vector<Node> nodes_;  ///< Ring storage, power-of-two sized
+    size_t head_ = 0;          ///< Slot of the front node
+    size_t size_ = 0;
+
+    size_t mask() const noexcept { return nodes_.size() - 1; }
+
+    Node &at(size_t index) { return nodes_[(head_ + index) & mask()]; }
+
+    // Doubles the storage when full, moving the nodes to its start.
+    void reserveOne()
+    {
+        if (size_ < nodes_.size())
+        {
+            return;
+        }
+
+        std::vector<Node> grown(nodes_.size() * 2);
+        for (size_t i = 0; i < size_; ++i)
+        {
+            grown[i] = at(i);
+        }
+        nodes_ = std::move(grown);
+        head_ = 0;
+    }
+};
+
+#endif  // CANDIDATE_QUEUE_H
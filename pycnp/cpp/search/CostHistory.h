@@ -0,0 +1,111 @@
+#ifndef COST_HISTORY_H
+#define COST_HISTORY_H
+
+#include "Graph/Types.h"
+
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+/**
+ * CostHistory
+ *
+ * Fixed-length cost history of a late acceptance search.
+ *
+ * Entries are rewritten in round-robin order, one per search step, so the
+ * history always holds the costs written over the last ``size()`` steps: a
+ * sliding window. A monotonic deque over that window keeps the maximum cost
+ * and its multiplicity up to date, in amortized constant time per step
+ * whatever the history length and the range of the costs.
+ */
+class CostHistory
+{
+public:
+    /// Creates a history of ``length`` entries, all set to ``cost``.
+    CostHistory(size_t length, ObjValue cost) : costs_(length, cost)
+    {
+        for (size_t step = 0; step != length; ++step)
+        {
+            window_.push_back({cost, step});
+        }
+        numMax_ = length;
+        step_ = length;
+    }
+
+    size_t size() const noexcept { return costs_.size(); }
+
+    ObjValue operator[](size_t index) const { return costs_[index]; }
+
+    /// Entry the next push overwrites: the one written longest ago.
+    ObjValue oldest() const { return costs_[step_ % costs_.size()]; }
+
+    /// Overwrites the oldest entry with ``cost``.
+    void push(ObjValue cost)
+    {
+        // The overwritten entry leaves the window. It is the oldest one
+        // still in the deque, if any later entry has not pushed it out.
+        if (window_.front().step + costs_.size() == step_)
+        {
+            window_.pop_front();
+            if (--numMax_ == 0)
+            {
+                countMax();
+            }
+        }
+
+        // Entries cheaper than ``cost`` can no longer be the maximum before
+        // they leave the window. Those left are no cheaper than ``cost``,
+        // so ``cost`` ties the maximum only if all of them equal it.
+        while (!window_.empty() && window_.back().cost < cost)
+        {
+            window_.pop_back();
+        }
+        if (window_.empty())
+        {
+            numMax_ = 1;
+        }
+        else if (cost == window_.front().cost)
+        {
+            ++numMax_;
+        }
+
+        window_.push_back({cost, step_});
+        costs_[step_ % costs_.size()] = cost;
+        ++step_;
+    }
+
+    /// Largest cost in the history.
+    ObjValue maxCost() const { return window_.front().cost; }
+
+    /// Number of entries holding the largest cost.
+    int maxCostCount() const { return static_cast<int>(numMax_); }
+
+private:
+    struct Entry
+    {
+        ObjValue cost;
+        size_t step;  ///< Push that wrote the entry
+    };
+
+    // Counts the entries equal to the front of the deque, which form its
+    // prefix. An entry is counted here at most once before it leaves, so
+    // the scans are amortized O(1) per push.
+    void countMax()
+    {
+        for (const Entry &entry : window_)
+        {
+            if (entry.cost != window_.front().cost)
+            {
+                break;
+            }
+            ++numMax_;
+        }
+    }
+
+    std::vector<ObjValue> costs_;
+    std::deque<Entry> window_;  ///< Non-increasing costs, oldest first
+    size_t numMax_ = 0;         ///< Deque entries equal to the maximum
+    size_t step_ = 0;           ///< Pushes so far, including the initial fill
+};
+
+#endif  // COST_HISTORY_H
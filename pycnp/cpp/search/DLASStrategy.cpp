@@ -1,8 +1,11 @@
 #include "DLASStrategy.h"
+#include "CostHistory.h"
+#include "SearchBudget.h"
+#include "SearchProgress.h"
 #include "SearchResult.h"
 #include "SearchUtils.h"
-#include <algorithm>
-#include <vector>
+#include "Trace.h"
+#include <utility>
 
 DLASStrategy::DLASStrategy(
     Graph &graph, const std::unordered_map<std::string, std::any> &params)
@@ -16,22 +19,25 @@ DLASStrategy::DLASStrategy(
 
 SearchResult DLASStrategy::execute()
 {
+    PYCNP_TRACE_PHASE(DLAS);
+    SearchBudget budget(params_);
+    SearchProgress progress(params_);
 
     SearchResult result;
 
     Graph &currentGraph = graph_;
     Solution bestSolution = currentGraph.getRemovedNodes();
 
-    int currentObjValue = graph_.getObjectiveValue();
-    int bestObjValue = currentObjValue;
+    ObjValue currentObjValue = graph_.getObjectiveValue();
+    ObjValue bestObjValue = currentObjValue;
     long numSteps = 0;
     long numIdleSteps = 0;
 
-    std::vector<int> historyCost(historyLength_, currentObjValue);
-    int maxCost = currentObjValue;
+    CostHistory historyCost(historyLength_, currentObjValue);
+    ObjValue maxCost = currentObjValue;
     int numMaxCost = historyLength_;
 
-    while (numIdleSteps < maxIdleSteps_)
+    while (numIdleSteps < maxIdleSteps_ && !budget.exhausted(numSteps))
     {
         numSteps++;
 
@@ -47,6 +53,7 @@ SearchResult DLASStrategy::execute()
             // getRemovedNodes now returns a const reference; this creates a copy of the current best solution
             bestSolution = currentGraph.getRemovedNodes();
             bestObjValue = currentObjValue;
+            progress.improved(bestSolution, bestObjValue, numSteps);
             numIdleSteps = 0;
         }
         else
@@ -55,22 +62,24 @@ SearchResult DLASStrategy::execute()
         }
     }
 
-    result.solution = bestSolution;
+    result.solution = std::move(bestSolution);
     result.objValue = bestObjValue;
+    result.numSteps = numSteps;
+    result.interrupted = budget.interrupted();
     return result;
 }
 
 void DLASStrategy::performMove(Graph &currentGraph,
-                               int &currentObjValue,
-                               std::vector<int> &historyCost,
-                               int &maxCost,
+                               ObjValue &currentObjValue,
+                               CostHistory &historyCost,
+                               ObjValue &maxCost,
                                int &numMaxCost,
                                long numSteps)
 {
-
-    // Save a copy of the current removed nodes to allow rollback if needed
-    Solution previousRemovedNodes = currentGraph.getRemovedNodes();
-    int previousObjValue = currentObjValue;
+    // A rejected move is undone through the graph's move log instead of
+    // rebuilding the graph from a copy of the removed set.
+    currentGraph.checkpoint();
+    ObjValue previousObjValue = currentObjValue;
 
     ComponentIndex componentToRemove = currentGraph.selectRemovedComponent();
 
@@ -88,42 +97,40 @@ void DLASStrategy::performMove(Graph &currentGraph,
 
     currentObjValue = currentGraph.getObjectiveValue();
 
-    int historyLength = historyCost.size();
-    int historyIndex = numSteps % historyLength;
-
     if (currentObjValue == previousObjValue || currentObjValue < maxCost)
     {
+        currentGraph.commit();
     }
     else
     {
-
-        currentGraph.updateGraphByRemovedNodes(previousRemovedNodes);
+        currentGraph.rollback();
         currentObjValue = previousObjValue;
     }
 
-    if (currentObjValue > historyCost[historyIndex])
+    // Every step rewrites the oldest history entry, keeping its old cost
+    // unless the rules below replace it.
+    const ObjValue oldestCost = historyCost.oldest();
+    if (currentObjValue > oldestCost)
     {
-
-        historyCost[historyIndex] = currentObjValue;
+        historyCost.push(currentObjValue);
     }
-    else if (currentObjValue < historyCost[historyIndex]
-             && currentObjValue < previousObjValue)
+    else if (currentObjValue < oldestCost && currentObjValue < previousObjValue)
     {
+        historyCost.push(currentObjValue);
 
-        historyCost[historyIndex] = currentObjValue;
-
-        if (historyCost[historyIndex] == maxCost)
+        if (currentObjValue == maxCost)
         {
             numMaxCost--;
         }
 
         if (numMaxCost == 0)
         {
-
-            maxCost = *std::max_element(historyCost.begin(), historyCost.end());
-
-            numMaxCost
-                = std::count(historyCost.begin(), historyCost.end(), maxCost);
+            maxCost = historyCost.maxCost();
+            numMaxCost = historyCost.maxCostCount();
         }
     }
+    else
+    {
+        historyCost.push(oldestCost);
+    }
 }
\ No newline at end of file
@@ -5,7 +5,8 @@
 #include "SearchStrategy.h"
 #include <any>
 #include <unordered_map>
-#include <vector>
+
+class CostHistory;
 
 /**
  * DLASStrategy
@@ -72,9 +73,9 @@ private:
      *     Current step number.
      */
     void performMove(Graph &currentGraph,
-                     int &currentObjValue,
-                     std::vector<int> &historyCost,
-                     int &maxCost,
+                     ObjValue &currentObjValue,
+                     CostHistory &historyCost,
+                     ObjValue &maxCost,
                      int &numMaxCost,
                      long numSteps);
 };
@@ -1,54 +1,82 @@
 #include "Search.h"
+#include "SearchUtils.h"
+#include "ShardedSearch.h"
 #include <stdexcept>
+#include <string_view>
 
-Search::Search(Graph &graph, int seed) : graph_(graph), seed_(seed)
+namespace
 {
-    registerStrategies();
+template <class Strategy>
+std::unique_ptr<SearchStrategy>
+makeStrategy(Graph &graph, const std::unordered_map<std::string, std::any> &params)
+{
+    return std::make_unique<Strategy>(graph, params);
 }
 
-Search::~Search() = default;
-
-void Search::registerStrategies()
+struct StrategyEntry
 {
+    std::string_view name;
+    std::unique_ptr<SearchStrategy> (*factory)(
+        Graph &, const std::unordered_map<std::string, std::any> &);
+};
 
-    strategyFactory_["CBNS"]
-        = [](Graph &g, const std::unordered_map<std::string, std::any> &params)
-    { return std::make_unique<CBNSStrategy>(g, params); };
+constexpr StrategyEntry STRATEGIES[] = {
+    {"CBNS", &makeStrategy<CBNSStrategy>},
+    {"DLAS", &makeStrategy<DLASStrategy>},
+    {"CHNS", &makeStrategy<CHNSStrategy>},
+    {"BCLS", &makeStrategy<BCLSStrategy>},
+};
+}  // namespace
 
-    strategyFactory_["DLAS"]
-        = [](Graph &g, const std::unordered_map<std::string, std::any> &params)
-    { return std::make_unique<DLASStrategy>(g, params); };
+Search::Search(Graph &graph, int seed) : graph_(graph), seed_(seed) {}
 
-    strategyFactory_["CHNS"]
-        = [](Graph &g, const std::unordered_map<std::string, std::any> &params)
-    { return std::make_unique<CHNSStrategy>(g, params); };
+Search::~Search() = default;
 
-    strategyFactory_["BCLS"]
-        = [](Graph &g, const std::unordered_map<std::string, std::any> &params)
-    { return std::make_unique<BCLSStrategy>(g, params); };
+Search::StrategyFactory Search::findStrategy(const std::string &strategyName)
+{
+    for (const StrategyEntry &entry : STRATEGIES)
+    {
+        if (entry.name == strategyName)
+        {
+            return entry.factory;
+        }
+    }
+    return nullptr;
 }
 
 void Search::setStrategy(const std::string &strategyName)
 {
-    auto it = strategyFactory_.find(strategyName);
-    if (it != strategyFactory_.end())
-    {
-
-        auto paramsWithSeed = params_;
-        paramsWithSeed["seed"] = seed_;
-        strategy_ = it->second(graph_, paramsWithSeed);
-    }
-    else
+    StrategyFactory factory = findStrategy(strategyName);
+    if (factory == nullptr)
     {
         throw std::invalid_argument("unknown search strategy: " + strategyName);
     }
+    factory_ = factory;
 }
 
 SearchResult Search::run()
 {
-    if (!strategy_)
+    if (factory_ == nullptr)
     {
         throw std::runtime_error("search strategy is not set");
     }
+
+    if (params_.contains("numThreads"))
+    {
+        graph_.setNumThreads(
+            SearchUtils::getParamOr<int>(params_, "numThreads", 1));
+    }
+
+    // The strategy is created here, so parameters set after setStrategy,
+    // such as a time limit, still apply. The seed always overrides a
+    // "seed" parameter, so it is written into the parameters directly.
+    params_["seed"] = seed_;
+    if (SearchUtils::getParamOr<int>(params_, "numShards", 1) > 1)
+    {
+        strategy_.reset();
+        return ShardedSearch(graph_, params_, factory_).execute();
+    }
+
+    strategy_ = factory_(graph_, params_);
     return strategy_->execute();
-}
\ No newline at end of file
+}
@@ -4,6 +4,7 @@
 // Include necessary dependencies
 #include "Graph/Graph.h"
 #include "RandomNumberGenerator.h"
+#include "SearchBudget.h"
 #include "SearchResult.h"
 #include "SearchStrategy.h"
 
@@ -15,7 +16,6 @@
 
 // Standard library dependencies
 #include <any>
-#include <functional>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -69,6 +69,21 @@ public:
     /**
      * Set search algorithm parameter.
      *
+     * Besides the strategy parameters, ``"numThreads"`` (int) sets the
+     * number of threads the graph uses for parallel work, such as
+     * rebuilding DCNP K-hop trees. Values below one use all hardware
+     * threads.
+     *
+     * Searches also stop early on ``"timeLimit"`` (seconds), ``"deadline"``
+     * (a ``steady_clock`` time point), ``"maxSteps"`` (moves) or a
+     * cancelled ``"cancelToken"``; see :class:`SearchBudget`. With a
+     * ``"progressQueue"`` (``std::shared_ptr<ProgressQueue>``), every new
+     * best solution is published to the queue; see :class:`SearchProgress`.
+     * With ``"numShards"`` (int) above one, independent components of a CNP
+     * graph are searched in parallel, with ``"shardRounds"`` (int) rounds
+     * of budget rebalancing between them; see :class:`ShardedSearch`.
+     * Parameters apply to the next :meth:`run`, whenever they are set.
+     *
      * Parameters
      * ----------
      * name
@@ -89,6 +104,9 @@ public:
     /**
      * Run search algorithm.
      *
+     * From Python the GIL is released while the search runs, so searches on
+     * different graphs can run in concurrent threads.
+     *
      * Returns
      * -------
      * SearchResult
@@ -102,24 +120,28 @@ public:
     SearchResult run();
 
 private:
+    /// Creates a strategy on a graph with the given parameters.
+    using StrategyFactory = std::unique_ptr<SearchStrategy> (*)(
+        Graph &, const std::unordered_map<std::string, std::any> &);
+
     Graph &graph_;                                      ///< Reference to graph object
-    std::unique_ptr<SearchStrategy> strategy_;          ///< Current search strategy
+    StrategyFactory factory_ = nullptr;                 ///< Factory of the selected strategy
+    std::unique_ptr<SearchStrategy> strategy_;          ///< Strategy of the last run
     std::unordered_map<std::string, std::any> params_;  ///< Search parameters
     int seed_ = 0;                                      ///< Random number seed (initialized to 0)
 
     /**
-     * Register all available search strategies.
-     */
-    void registerStrategies();
-
-    /**
-     * Strategy factory for creating search strategy instances.
+     * Looks up a strategy in the table of available strategies.
+     *
+     * The table is static, so constructing a Search, as every offspring
+     * does, costs no registration.
+     *
+     * Returns
+     * -------
+     * StrategyFactory
+     *     Factory of the strategy, or nullptr if no strategy has that name.
      */
-    std::unordered_map<
-        std::string,
-        std::function<std::unique_ptr<SearchStrategy>(
-            Graph &, const std::unordered_map<std::string, std::any> &)>>
-        strategyFactory_;
+    static StrategyFactory findStrategy(const std::string &strategyName);
 };
 
 #endif  // SEARCH_H
@@ -0,0 +1,146 @@
+#ifndef SEARCH_BUDGET_H
+#define SEARCH_BUDGET_H
+
+#include "SearchUtils.h"
+
+#include <algorithm>
+#include <any>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+/**
+ * CancelToken
+ *
+ * Flag that asks running searches to stop.
+ *
+ * A token is shared between the searches it controls and the thread that
+ * cancels them; searches poll it cooperatively, so a cancelled search
+ * returns after at most one check interval of further moves.
+ */
+class CancelToken
+{
+public:
+    /// Asks every search holding the token to stop.
+    void cancel() noexcept { cancelled_.store(true, std::memory_order_relaxed); }
+
+    /// Clears the request, so the token can be reused.
+    void reset() noexcept { cancelled_.store(false, std::memory_order_relaxed); }
+
+    bool isCancelled() const noexcept
+    {
+        return cancelled_.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<bool> cancelled_{false};
+};
+
+/**
+ * SearchBudget
+ *
+ * Time and step limits of one local search, on top of the strategy's own
+ * idle-step criterion.
+ *
+ * The limits are read from the search parameters:
+ *
+ * - ``"timeLimit"`` (double): seconds from the start of the search.
+ * - ``"deadline"`` (``std::chrono::steady_clock::time_point``): absolute
+ *   deadline, for a budget shared by several searches.
+ * - ``"maxSteps"`` (int): maximum number of moves.
+ * - ``"cancelToken"`` (``std::shared_ptr<CancelToken>``): external stop.
+ * - ``"budgetCheckInterval"`` (int, default 16): moves between clock and
+ *   token checks. The step limit is checked on every move.
+ *
+ * Limits that are absent or not positive do not apply. A search that stops
+ * on its budget is marked as interrupted in its result.
+ */
+class SearchBudget
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// Reads the limits; a time limit runs from construction.
+    explicit SearchBudget(const std::unordered_map<std::string, std::any> &params)
+        : maxSteps_(SearchUtils::getParamOr<int>(params, "maxSteps", 0)),
+          checkInterval_(
+              SearchUtils::getParamOr<int>(params, "budgetCheckInterval", 16)),
+          cancel_(SearchUtils::getParamOr<std::shared_ptr<CancelToken>>(
+              params, "cancelToken", nullptr))
+    {
+        if (checkInterval_ < 1)
+        {
+            checkInterval_ = 1;
+        }
+
+        // Python passes whole seconds as int.
+        const double timeLimit = SearchUtils::getParamOr<double>(
+            params,
+            "timeLimit",
+            SearchUtils::getParamOr<int>(params, "timeLimit", 0));
+        if (timeLimit > 0)
+        {
+            hasDeadline_ = true;
+            deadline_ = Clock::now()
+                        + std::chrono::duration_cast<Clock::duration>(
+                            std::chrono::duration<double>(timeLimit));
+        }
+
+        auto it = params.find("deadline");
+        if (it != params.end())
+        {
+            if (const auto *deadline = std::any_cast<Clock::time_point>(&it->second))
+            {
+                deadline_ = hasDeadline_ ? std::min(deadline_, *deadline) : *deadline;
+                hasDeadline_ = true;
+            }
+        }
+    }
+
+    /**
+     * Whether the search must stop before move ``numSteps + 1``.
+     *
+     * Parameters
+     * ----------
+     * numSteps
+     *     Moves made so far.
+     */
+    bool exhausted(long numSteps)
+    {
+        if (interrupted_)
+        {
+            return true;
+        }
+        if (maxSteps_ > 0 && numSteps >= maxSteps_)
+        {
+            interrupted_ = true;
+        }
+        else if ((hasDeadline_ || cancel_) && numSteps % checkInterval_ == 0)
+        {
+            interrupted_ = (cancel_ && cancel_->isCancelled())
+                           || (hasDeadline_ && Clock::now() >= deadline_);
+        }
+        return interrupted_;
+    }
+
+    /// Whether a limit stopped the search.
+    bool interrupted() const noexcept { return interrupted_; }
+
+    /// Whether a time limit or deadline applies.
+    bool hasDeadline() const noexcept { return hasDeadline_; }
+
+    /// Earlier of the time limit and the deadline; see :meth:`hasDeadline`.
+    Clock::time_point deadline() const noexcept { return deadline_; }
+
+private:
+    long maxSteps_;
+    long checkInterval_;
+    std::shared_ptr<CancelToken> cancel_;
+    bool hasDeadline_ = false;
+    Clock::time_point deadline_;
+    bool interrupted_ = false;
+};
+
+#endif  // SEARCH_BUDGET_H
@@ -0,0 +1,128 @@
+#include "SearchCache.h"
+#include "Search.h"
+
+#include <functional>
+
+size_t SearchCache::KeyHash::operator()(const Key &key) const noexcept
+{
+    size_t hash = std::hash<Solution>()(key.start);
+    hash ^= std::hash<std::string>()(key.strategy) + 0x9e3779b9
+            + (hash << 6) + (hash >> 2);
+    hash ^= std::hash<int>()(key.seed) + 0x9e3779b9 + (hash << 6)
+            + (hash >> 2);
+    return hash;
+}
+
+SearchCache::SearchCache(size_t capacity, SeedPolicy policy)
+    : capacity_(capacity), policy_(policy)
+{
+}
+
+SearchCache::Key SearchCache::makeKey(const Solution &start,
+                                      const std::string &strategy,
+                                      int seed) const
+{
+    return {start, strategy, policy_ == SeedPolicy::Match ? seed : 0};
+}
+
+SearchResult SearchCache::run(Graph &graph,
+                              const std::string &strategy,
+                              int seed,
+                              const std::unordered_map<std::string, std::any> &params)
+{
+    if (auto cached = find(graph.getRemovedNodes(), strategy, seed))
+    {
+        cached->numSteps = 0;  // No search ran for this result
+        return std::move(*cached);
+    }
+
+    // The start set is copied first: the search changes the graph. Without
+    // a cache nothing is stored, so the copy is skipped.
+    const Solution start = capacity_ > 0 ? graph.getRemovedNodes() : Solution();
+    Search search(graph, seed);
+    search.setStrategy(strategy);
+    for (const auto &[name, value] : params)
+    {
+        search.setParam(name, value);
+    }
+    SearchResult result = search.run();
+    if (!result.interrupted)
+    {
+        insert(start, strategy, seed, result);
+    }
+    return result;
+}
+
+std::optional<SearchResult>
+SearchCache::find(const Solution &start, const std::string &strategy, int seed)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (capacity_ > 0)
+    {
+        auto it = index_.find(makeKey(start, strategy, seed));
+        if (it != index_.end())
+        {
+            entries_.splice(entries_.begin(), entries_, it->second);
+            hits_++;
+            return it->second->second;
+        }
+    }
+    misses_++;
+    return std::nullopt;
+}
+
+void SearchCache::insert(const Solution &start,
+                         const std::string &strategy,
+                         int seed,
+                         const SearchResult &result)
+{
+    if (capacity_ == 0)
+    {
+        return;
+    }
+
+    Key key = makeKey(start, strategy, seed);
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Another thread may have stored the same start meanwhile.
+    if (auto it = index_.find(key); it != index_.end())
+    {
+        it->second->second = result;
+        entries_.splice(entries_.begin(), entries_, it->second);
+        return;
+    }
+
+    if (entries_.size() == capacity_)
+    {
+        index_.erase(entries_.back().first);
+        entries_.pop_back();
+    }
+
+    entries_.emplace_front(key, result);
+    index_.emplace(std::move(key), entries_.begin());
+}
+
+void SearchCache::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    index_.clear();
+    entries_.clear();
+}
+
+size_t SearchCache::hits() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return hits_;
+}
+
+size_t SearchCache::misses() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return misses_;
+}
+
+size_t SearchCache::size() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
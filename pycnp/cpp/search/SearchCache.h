@@ -0,0 +1,154 @@
+#ifndef SEARCH_CACHE_H
+#define SEARCH_CACHE_H
+
+#include "Graph/Graph.h"
+#include "SearchResult.h"
+
+#include <any>
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * SearchCache
+ *
+ * Bounded least-recently-used cache of local search results.
+ *
+ * Entries are keyed by the removed set a search starts from, found through
+ * its fingerprint, together with the strategy name and, depending on the
+ * seed policy, the search seed. When the memetic loop breeds an offspring
+ * whose start set was searched before, the cached result is reused instead
+ * of running the search again.
+ *
+ * A search also depends on the random state inside the graph, so a cached
+ * result is one valid outcome from the same start, not necessarily the one
+ * a fresh search would find: runs with a cache are not bitwise identical to
+ * runs without one. The cache is only meaningful for graphs derived from a
+ * single original graph, with the same search parameters.
+ *
+ * All methods are thread-safe; searches run outside the lock.
+ */
+class SearchCache
+{
+public:
+    /**
+     * SeedPolicy
+     *
+     * Whether the search seed is part of the key.
+     */
+    enum class SeedPolicy
+    {
+        Ignore,  ///< Any earlier search from the same start matches
+        Match,   ///< Only a search with the same seed matches
+    };
+
+    /**
+     * Creates an empty cache.
+     *
+     * Parameters
+     * ----------
+     * capacity
+     *     Maximum number of results kept; 0 disables caching, so every
+     *     lookup misses.
+     * policy
+     *     Whether lookups must match the search seed.
+     */
+    explicit SearchCache(size_t capacity, SeedPolicy policy = SeedPolicy::Ignore);
+
+    SearchCache(const SearchCache &) = delete;
+    SearchCache &operator=(const SearchCache &) = delete;
+
+    /**
+     * Runs a local search on ``graph``, or returns the cached result of an
+     * earlier search from the same removed set.
+     *
+     * Parameters
+     * ----------
+     * graph
+     *     Start graph; modified by the search on a miss only.
+     * strategy
+     *     Search strategy name.
+     * seed
+     *     Search seed.
+     * params
+     *     Extra search parameters, such as a deadline or cancel token. They
+     *     are not part of the key; a search they interrupt is not cached.
+     *
+     * Returns
+     * -------
+     * SearchResult
+     *     The search result.
+     *
+     * Throws
+     * ------
+     * std::invalid_argument
+     *     If the strategy name does not exist.
+     */
+    SearchResult run(Graph &graph,
+                     const std::string &strategy,
+                     int seed,
+                     const std::unordered_map<std::string, std::any> &params = {});
+
+    /**
+     * Looks up a result and marks it as recently used.
+     *
+     * Returns
+     * -------
+     * Optional[SearchResult]
+     *     The cached result, or nothing on a miss.
+     */
+    std::optional<SearchResult>
+    find(const Solution &start, const std::string &strategy, int seed);
+
+    /// Stores a result, evicting the least recently used one when full.
+    void insert(const Solution &start,
+                const std::string &strategy,
+                int seed,
+                const SearchResult &result);
+
+    /// Removes all results; the counters are kept.
+    void clear();
+
+    size_t hits() const;      ///< Lookups answered from the cache
+    size_t misses() const;    ///< Lookups that were not
+    size_t size() const;      ///< Number of cached results
+    size_t capacity() const noexcept { return capacity_; }
+
+private:
+    struct Key
+    {
+        Solution start;
+        std::string strategy;
+        int seed;
+
+        bool operator==(const Key &other) const
+        {
+            return seed == other.seed && start == other.start
+                   && strategy == other.strategy;
+        }
+    };
+
+    struct KeyHash
+    {
+        size_t operator()(const Key &key) const noexcept;
+    };
+
+    using Entry = std::pair<Key, SearchResult>;
+
+    Key makeKey(const Solution &start, const std::string &strategy, int seed) const;
+
+    const size_t capacity_;
+    const SeedPolicy policy_;
+
+    mutable std::mutex mutex_;
+    std::list<Entry> entries_;  ///< Most recently used first
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index_;
+    size_t hits_ = 0;
+    size_t misses_ = 0;
+};
+
+#endif  // SEARCH_CACHE_H
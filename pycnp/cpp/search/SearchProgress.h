@@ -0,0 +1,65 @@
+#ifndef SEARCH_PROGRESS_H
+#define SEARCH_PROGRESS_H
+
+#include "ProgressQueue.h"
+#include "SearchUtils.h"
+
+#include <any>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+/**
+ * SearchProgress
+ *
+ * Forwards the improvements of one local search to a progress queue.
+ *
+ * The queue is read from the ``"progressQueue"`` search parameter
+ * (``std::shared_ptr<ProgressQueue>``); without one, reporting does nothing.
+ * The search thread is the only producer, so one queue must not be shared
+ * by searches that run at the same time.
+ */
+class SearchProgress
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// Reads the queue; event times run from construction.
+    explicit SearchProgress(const std::unordered_map<std::string, std::any> &params)
+        : queue_(SearchUtils::getParamOr<std::shared_ptr<ProgressQueue>>(
+              params, "progressQueue", nullptr)),
+          start_(Clock::now())
+    {
+    }
+
+    /**
+     * Reports a new best solution.
+     *
+     * Parameters
+     * ----------
+     * solution
+     *     The new best solution.
+     * objValue
+     *     Its objective value.
+     * numSteps
+     *     Moves made so far.
+     */
+    void improved(const Solution &solution, ObjValue objValue, long numSteps)
+    {
+        if (queue_)
+        {
+            ProgressEvent event;
+            event.objValue = objValue;
+            event.time = std::chrono::duration<double>(Clock::now() - start_).count();
+            event.iteration = numSteps;
+            queue_->publish(solution, event);
+        }
+    }
+
+private:
+    std::shared_ptr<ProgressQueue> queue_;
+    Clock::time_point start_;
+};
+
+#endif  // SEARCH_PROGRESS_H
@@ -0,0 +1,257 @@
+#include "ShardedSearch.h"
+#include "SearchBudget.h"
+#include "SearchProgress.h"
+#include "SearchUtils.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <utility>
+
+ShardedSearch::ShardedSearch(
+    Graph &graph,
+    const std::unordered_map<std::string, std::any> &params,
+    StrategyFactory factory)
+    : graph_(graph), params_(params), factory_(factory)
+{
+}
+
+SearchResult ShardedSearch::execute()
+{
+    std::unordered_map<std::string, std::any> shardParams = params_;
+    const int numShards = SearchUtils::getParamOr<int>(params_, "numShards", 1);
+    shardParams.erase("numShards");
+
+    auto partition = [&]() {
+        const CNP_Graph *cnp = graph_.asCNP();
+        return cnp != nullptr && cnp->objective() != ObjectiveKind::LargestComponent
+                   ? cnp->partitionByComponents(numShards)
+                   : std::vector<CNP_Graph::Shard>();
+    };
+
+    std::vector<CNP_Graph::Shard> shards = partition();
+    if (shards.size() < 2)
+    {
+        return factory_(graph_, shardParams)->execute();
+    }
+
+    // The rounds share the time limit and cancel token; step limits are
+    // left to the shard searches.
+    auto limits = params_;
+    limits.erase("maxSteps");
+    limits["budgetCheckInterval"] = 1;
+    SearchBudget budget(limits);
+    if (budget.hasDeadline())
+    {
+        shardParams.erase("timeLimit");
+        shardParams["deadline"] = budget.deadline();
+    }
+
+    SearchProgress progress(params_);
+    shardParams.erase("progressQueue");
+
+    RandomNumberGenerator rng;
+    SearchUtils::applySeed(params_, rng);
+
+    const int numRounds
+        = std::max(1, SearchUtils::getParamOr<int>(params_, "shardRounds", 4));
+
+    SearchResult result;
+    ObjValue objValue = graph_.getObjectiveValue();
+    for (int round = 1;; ++round)
+    {
+        const ObjValue roundStart = objValue;
+        objValue = runRound(shards, shardParams, rng, result);
+        if (objValue < roundStart)
+        {
+            progress.improved(graph_.getRemovedNodes(), objValue, result.numSteps);
+        }
+
+        if (objValue == roundStart || round == numRounds || result.interrupted
+            || budget.exhausted(round))
+        {
+            break;
+        }
+
+        // The searches moved the components, and with them the separators
+        // between the shards; partitioning again frees nodes frozen so far.
+        shards = partition();
+        if (shards.size() < 2)
+        {
+            break;
+        }
+    }
+
+    // Removed nodes between shards stay fixed within a round. An unsharded
+    // pass from the combined solution can still move them, and ends soon
+    // as the solution is close to a local optimum already.
+    result.solution = graph_.getRemovedNodes();
+    if (!result.interrupted && !budget.exhausted(0))
+    {
+        auto params = shardParams;
+        params["seed"] = rng.nextSeed();
+        SearchResult polished = factory_(graph_, params)->execute();
+        result.numSteps += polished.numSteps;
+        result.interrupted = polished.interrupted;
+        if (polished.objValue < objValue)
+        {
+            result.solution = std::move(polished.solution);
+            objValue = polished.objValue;
+            progress.improved(result.solution, objValue, result.numSteps);
+        }
+        graph_.updateGraphByRemovedNodes(result.solution);
+    }
+
+    result.objValue = objValue;
+    result.interrupted = result.interrupted || budget.interrupted();
+    return result;
+}
+
+ObjValue ShardedSearch::runRound(
+    const std::vector<CNP_Graph::Shard> &partition,
+    const std::unordered_map<std::string, std::any> &shardParams,
+    RandomNumberGenerator &rng,
+    SearchResult &result)
+{
+    // Removed nodes owned by no shard stay removed this round.
+    const CNP_Graph &cnp = *graph_.asCNP();
+    Solution solution = cnp.getRemovedNodes();
+    std::vector<ShardState> shards(partition.size());
+    std::vector<int> seeds(shards.size());
+
+    // Seeds are drawn in shard order, so results do not depend on how the
+    // shard searches are scheduled.
+    for (size_t i = 0; i < shards.size(); ++i)
+    {
+        for (Node node : partition[i].removed)
+        {
+            solution.erase(node);
+        }
+        shards[i].graph = std::make_unique<Graph>(
+            cnp.shardGraph(partition[i], rng.nextSeed()));
+        shards[i].objValue = shards[i].graph->getObjectiveValue();
+        shards[i].numNodes = partition[i].nodes.size();
+        seeds[i] = rng.nextSeed();
+    }
+
+    std::vector<SearchResult> results(shards.size());
+    ThreadPool::instance().parallelFor(
+        shards.size(),
+        shards.size(),
+        [&](size_t begin, size_t end, size_t) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                ShardState &shard = shards[i];
+                const size_t numRemoved = shard.graph->getRemovedNodes().size();
+                if (numRemoved == 0 || numRemoved == shard.numNodes)
+                {
+                    continue;  // No node to add back or none to remove
+                }
+
+                auto params = shardParams;
+                params["seed"] = seeds[i];
+                results[i] = factory_(*shard.graph, params)->execute();
+            }
+        });
+
+    for (size_t i = 0; i < shards.size(); ++i)
+    {
+        const SearchResult &shardResult = results[i];
+        if (shardResult.isValid())
+        {
+            result.numSteps += shardResult.numSteps;
+            result.interrupted = result.interrupted || shardResult.interrupted;
+            shards[i].graph->updateGraphByRemovedNodes(shardResult.solution);
+            shards[i].objValue = shardResult.objValue;
+        }
+    }
+
+    rebalance(shards);
+
+    for (const ShardState &shard : shards)
+    {
+        const Solution &removed = shard.graph->getRemovedNodes();
+        solution.insert(removed.begin(), removed.end());
+    }
+    graph_.updateGraphByRemovedNodes(solution);
+    return graph_.getObjectiveValue();
+}
+
+void ShardedSearch::rebalance(std::vector<ShardState> &shards)
+{
+    const size_t numShards = shards.size();
+    std::vector<ObjValue> gains(numShards, 0);
+    std::vector<ObjValue> costs(numShards, 0);
+    std::vector<Node> nodesToRemove(numShards, INVALID_NODE);
+    std::vector<Node> nodesToAdd(numShards, INVALID_NODE);
+
+    // Tries the move a strategy would make in each direction and undoes it.
+    auto evaluate = [&](size_t i) {
+        ShardState &shard = shards[i];
+        Graph &graph = *shard.graph;
+        const size_t numRemoved = graph.getRemovedNodes().size();
+
+        nodesToRemove[i] = INVALID_NODE;
+        if (numRemoved < shard.numNodes)
+        {
+            const Node node = graph.impactSelectNodeFromComponent(
+                graph.selectRemovedComponent());
+            graph.removeNode(node);
+            gains[i] = shard.objValue - graph.getObjectiveValue();
+            graph.addNode(node);
+            nodesToRemove[i] = node;
+        }
+
+        nodesToAdd[i] = INVALID_NODE;
+        if (numRemoved > 0)
+        {
+            const Node node = graph.greedySelectNodeToAdd();
+            graph.addNode(node);
+            costs[i] = graph.getObjectiveValue() - shard.objValue;
+            graph.removeNode(node);
+            nodesToAdd[i] = node;
+        }
+    };
+
+    for (size_t i = 0; i < numShards; ++i)
+    {
+        evaluate(i);
+    }
+
+    // Each move lowers the objective by a positive integer, so this ends.
+    while (true)
+    {
+        size_t taker = 0;
+        size_t giver = 0;
+        ObjValue bestDelta = 0;
+        for (size_t s = 0; s < numShards; ++s)
+        {
+            if (nodesToRemove[s] == INVALID_NODE)
+            {
+                continue;
+            }
+            for (size_t t = 0; t < numShards; ++t)
+            {
+                if (t != s && nodesToAdd[t] != INVALID_NODE
+                    && gains[s] - costs[t] > bestDelta)
+                {
+                    taker = s;
+                    giver = t;
+                    bestDelta = gains[s] - costs[t];
+                }
+            }
+        }
+
+        if (bestDelta <= 0)
+        {
+            return;
+        }
+
+        shards[giver].graph->addNode(nodesToAdd[giver]);
+        shards[giver].objValue += costs[giver];
+        shards[taker].graph->removeNode(nodesToRemove[taker]);
+        shards[taker].objValue -= gains[taker];
+
+        evaluate(giver);
+        evaluate(taker);
+    }
+}
@@ -0,0 +1,98 @@
+#ifndef SHARDED_SEARCH_H
+#define SHARDED_SEARCH_H
+
+#include "Graph/Graph.h"
+#include "RandomNumberGenerator.h"
+#include "SearchResult.h"
+#include "SearchStrategy.h"
+
+#include <any>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * ShardedSearch
+ *
+ * Runs a local search on every shard of a CNP graph in parallel, and moves
+ * removal budget between the shards.
+ *
+ * A round splits the residual graph by
+ * :meth:`CNP_Graph::partitionByComponents` into at most ``"numShards"``
+ * shards and runs the strategy on every shard at once. A coordinator then
+ * moves removed nodes, one at a time, from the shard where adding one back
+ * costs least to the shard where removing one more gains most, as long as
+ * that lowers the objective. The next round partitions the combined
+ * solution again, so removed nodes that joined two shards in one round can
+ * move in the next. The rounds stop after ``"shardRounds"`` rounds
+ * (default 4), after a round that does not improve, or on the budget.
+ * Removed nodes between two shards cannot move within a round, so the
+ * search ends with one unsharded pass of the strategy from the combined
+ * solution, which is short as that solution is nearly a local optimum.
+ *
+ * Shard objectives add up to the graph objective only for additive
+ * objectives, so DCNP graphs, the largest-component objective and residual
+ * graphs with fewer than two shards are searched unsharded.
+ *
+ * The shard searches share the time limit, deadline and cancel token of the
+ * search; step limits apply to each shard search. A progress queue has a
+ * single producer, so the coordinator publishes the combined solution after
+ * each round instead of the shard searches.
+ */
+class ShardedSearch
+{
+public:
+    /// Creates a strategy on a graph with the given parameters.
+    using StrategyFactory = std::unique_ptr<SearchStrategy> (*)(
+        Graph &, const std::unordered_map<std::string, std::any> &);
+
+    /**
+     * Parameters
+     * ----------
+     * graph
+     *     Graph to search; left with the combined solution.
+     * params
+     *     Search parameters, including ``"numShards"`` and ``"seed"``.
+     * factory
+     *     Factory of the strategy run on each shard.
+     */
+    ShardedSearch(Graph &graph,
+                  const std::unordered_map<std::string, std::any> &params,
+                  StrategyFactory factory);
+
+    /**
+     * Runs the sharded search.
+     *
+     * Returns
+     * -------
+     * SearchResult
+     *     Combined solution and its objective on the whole graph, with the
+     *     moves of all shard searches.
+     */
+    SearchResult execute();
+
+private:
+    struct ShardState
+    {
+        std::unique_ptr<Graph> graph;
+        ObjValue objValue = 0;
+        size_t numNodes = 0;  ///< Live and removed nodes of the shard
+    };
+
+    Graph &graph_;
+    std::unordered_map<std::string, std::any> params_;
+    StrategyFactory factory_;
+
+    // Searches every shard of ``partition`` and rebalances them, then
+    // applies the combined solution to the graph. Returns its objective.
+    ObjValue runRound(const std::vector<CNP_Graph::Shard> &partition,
+                      const std::unordered_map<std::string, std::any> &shardParams,
+                      RandomNumberGenerator &rng,
+                      SearchResult &result);
+
+    // Moves removed nodes between shards while a move lowers the objective.
+    static void rebalance(std::vector<ShardState> &shards);
+};
+
+#endif  // SHARDED_SEARCH_H
@@ -23,4 +23,5 @@ def reduce_solve_combine(
     search: str = "CHNS",
     beta: float = 0.9,
     seed: int = ...,
+    time_limit: float = 0.0,
 ) -> Graph: ...
@@ -18,6 +18,7 @@ def reduce_solve_combine(
     search: SEARCH_STRATEGIES = "CHNS",
     beta: float = 0.9,
     seed: int = 0,
+    time_limit: float = 0.0,
 ) -> Graph:
     """
     Performs a Reduce-Solve-Combine (RSC) crossover operation.
@@ -48,6 +49,9 @@ def reduce_solve_combine(
         Defaults to 0.9.
     seed : int, optional
         Random seed for reproducibility. Defaults to 0.
+    time_limit : float, optional
+        Seconds the local search of the subproblem may run; 0 (the
+        default) runs it to completion.
 
     Returns
     -------
@@ -65,4 +69,4 @@ def reduce_solve_combine(
         reduce_solve_combine as _rsc,
     )
 
-    return _rsc(orig_graph, parents, search, beta, seed)
\ No newline at end of file
+    return _rsc(orig_graph, parents, search, beta, seed, time_limit)
\ No newline at end of file
@@ -22,7 +22,8 @@ class InvalidProblemTypeError(ValueError):
     Exception raised when an unsupported problem type is provided.
 
     This error is typically raised by :func:`pycnp.validation.validate_problem_type`
-    when the provided problem type is not ``"CNP"`` or ``"DCNP"``.
+    when the provided problem type is not ``"DCNP"`` or one of the CNP
+    variants (``"CNP"``, ``"WCNP"``, ``"MINMAXC"``, ``"MAXNUM"``).
 
     Examples
     --------
@@ -39,6 +39,9 @@ class MemeticSearchParams:
         is_pop_variable: bool = True,
         initial_pop_size: int = 5,
         reduce_params: Optional[Dict[str, Any]] = None,
+        num_offspring: int = 1,
+        search_cache_size: int = 0,
+        kernelize: bool = False,
     ) -> None:
         """
         Parameters
@@ -61,12 +64,29 @@ class MemeticSearchParams:
             Parameters for RSC crossover. Contains ``"search"`` (search strategy)
             and ``"beta"`` (fraction of common nodes to preserve). Defaults to
             ``{"search": "CHNS", "beta": 0.9}``.
+        num_offspring : int, default=1
+            Offspring bred per generation. Their crossovers and local searches
+            run on parallel threads, followed by one batched population
+            update. With 1, each generation breeds a single offspring.
+        search_cache_size : int, default=0
+            Number of local search results kept in a
+            :class:`~pycnp._pycnp.SearchCache`. Offspring whose crossover
+            result was searched before reuse that result. 0 disables the
+            cache, which keeps runs reproducible across versions.
+        kernelize : bool, default=False
+            Whether to search a reduced graph without nodes that never
+            improve a solution: isolated nodes, and for CNP leaves, whose
+            pairs are counted through their neighbour. Solutions and
+            objective values are those of the full graph.
         """
         self.search = search
         self.crossover = crossover
         self.is_problem_reduction = is_problem_reduction
         self.is_pop_variable = is_pop_variable
         self.initial_pop_size = initial_pop_size
+        self.num_offspring = num_offspring
+        self.search_cache_size = search_cache_size
+        self.kernelize = kernelize
         if reduce_params is None:
             self.reduce_params = {
                 "search": _DEFAULT_RSC_SEARCH,
@@ -86,6 +106,9 @@ class MemeticSearchParams:
             "beta": _DEFAULT_RSC_BETA
         }
     )
+    num_offspring: int = 1
+    search_cache_size: int = 0
+    kernelize: bool = False
 
 
 @dataclass
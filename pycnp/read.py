@@ -10,8 +10,10 @@ def read(graph_file: str) -> "ProblemData":
     """
     Read graph file and return a ProblemData object.
 
-    Automatically detects graph file format (adjacency list or edge list)
-    and reads data accordingly.
+    The format (adjacency list, DIMACS edge list or plain ``u v`` edge
+    list, each optionally gzip-compressed, or a binary file written by
+    ``ProblemData.save_binary``) is detected by the C++ loader, which
+    memory-maps the file and builds the adjacency directly.
 
     Parameters
     ----------
@@ -42,19 +44,10 @@ def read(graph_file: str) -> "ProblemData":
     if not os.path.exists(graph_file):
         raise FileNotFoundError(f"Graph file not found: {graph_file}")
 
-    # Determine file format (adjacency list or edge list)
-    with open(graph_file, "r", encoding="utf-8") as f:
-        first_line = f.readline().strip()
-
-        # Check if first line contains 'p', which is characteristic of edge list format
-        if first_line.startswith("p") or "p" in first_line.split():
-            # Edge list format
-            problem_data = read_edge_list_format(graph_file)
-        else:
-            # Adjacency list format
-            problem_data = read_adjacency_list_format(graph_file)
-
-    return problem_data
+    try:
+        return ProblemData.read_from_file(graph_file)
+    except Exception as e:
+        raise RuntimeError(f"Failed to read graph file: {e}") from e
 
 
 def read_adjacency_list_format(filename: str) -> "ProblemData":
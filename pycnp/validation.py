@@ -24,7 +24,7 @@ from __future__ import annotations
 from typing import TYPE_CHECKING, Any, Dict, Union
 
 from .constants import (
-    PROBLEM_TYPE_CNP,
+    CNP_PROBLEM_TYPES,
     PROBLEM_TYPE_DCNP,
     SEARCH_STRATEGY_BCLS,
     SEARCH_STRATEGY_CBNS,
@@ -47,8 +47,8 @@ def validate_problem_type(problem_type: Union[str, int]) -> str:
     Parameters
     ----------
     problem_type : Union[str, int]
-        The problem type to validate. Can be a string (``"CNP"`` or ``"DCNP"``)
-        or an integer constant.
+        The problem type to validate: a string such as ``"CNP"``, ``"WCNP"``,
+        ``"MINMAXC"``, ``"MAXNUM"`` or ``"DCNP"``, or an integer constant.
 
     Returns
     -------
@@ -70,15 +70,15 @@ def validate_problem_type(problem_type: Union[str, int]) -> str:
     """
     if isinstance(problem_type, str):
         normalized_type = problem_type.upper()
-        if normalized_type in (PROBLEM_TYPE_CNP, PROBLEM_TYPE_DCNP):
+        if normalized_type in (*CNP_PROBLEM_TYPES, PROBLEM_TYPE_DCNP):
             return normalized_type
         raise InvalidProblemTypeError(
             f"Unsupported problem type string: {problem_type}. "
-            f"Valid options are: {PROBLEM_TYPE_CNP}, {PROBLEM_TYPE_DCNP}"
+            f"Valid options are: {', '.join(CNP_PROBLEM_TYPES)}, {PROBLEM_TYPE_DCNP}"
         )
     raise InvalidProblemTypeError(
         f"Unsupported problem type: {problem_type}. Must be one of "
-        f"'{PROBLEM_TYPE_CNP}' or '{PROBLEM_TYPE_DCNP}'."
+        f"{', '.join(repr(t) for t in (*CNP_PROBLEM_TYPES, PROBLEM_TYPE_DCNP))}."
     )
 
 
@@ -146,8 +146,10 @@ def validate_search_strategy(search: Union[int, str], problem_type: str) -> str:
         raise ValueError(
             "DCNP problem type currently only supports BCLS search strategy"
         )
-    if problem_type == PROBLEM_TYPE_CNP and search_strategy == SEARCH_STRATEGY_BCLS:
-        raise ValueError("CNP problem type does not support BCLS search strategy")
+    if problem_type in CNP_PROBLEM_TYPES and search_strategy == SEARCH_STRATEGY_BCLS:
+        raise ValueError(
+            f"{problem_type} problem type does not support BCLS search strategy"
+        )
 
     return search_strategy
 
@@ -334,7 +336,7 @@ def validate_reduce_params(reduce_params_in: Any, problem_type: str) -> Dict[str
         raise ValueError(
             "For DCNP, reduce_params['search'] must be 'BCLS' when using RSC crossover."
         )
-    if problem_type == PROBLEM_TYPE_CNP and reduce_search_name == SEARCH_STRATEGY_BCLS:
+    if problem_type in CNP_PROBLEM_TYPES and reduce_search_name == SEARCH_STRATEGY_BCLS:
         raise ValueError(
             "reduce_params['search']='BCLS' is only supported for DCNP "
             "in RSC crossover."
@@ -0,0 +1,105 @@
+"""
+Graph builders, objective recounts and searches shared by the tests, as
+fixtures.
+"""
+
+import pytest
+
+from pycnp import double_backbone_based_crossover
+from pycnp._pycnp import ProblemData, Search
+
+
+def _ring_with_chords(num_nodes, chord=7, num_rings=1):
+    data = ProblemData(num_rings * num_nodes)
+    for node in range(num_rings * num_nodes):
+        data.add_node(node)
+    for ring in range(num_rings):
+        offset = ring * num_nodes
+        for node in range(num_nodes):
+            data.add_edge(offset + node, offset + (node + 1) % num_nodes)
+            data.add_edge(offset + node, offset + (node + chord) % num_nodes)
+    return data
+
+
+def _component_weights(data, removed):
+    adj = data.get_adj_list()
+    seen = set(removed)
+    components = []
+    for start in data.get_nodes_set():
+        if start in seen:
+            continue
+        seen.add(start)
+        stack, weights = [start], []
+        while stack:
+            node = stack.pop()
+            weights.append(data.get_node_weight(node))
+            for neighbor in adj[node]:
+                if neighbor not in seen:
+                    seen.add(neighbor)
+                    stack.append(neighbor)
+        components.append(weights)
+    return components
+
+
+def _connected_pairs(data, removed):
+    sizes = (len(weights) for weights in _component_weights(data, removed))
+    return sum(size * (size - 1) // 2 for size in sizes)
+
+
+@pytest.fixture
+def ring_with_chords():
+    """
+    Builds ``num_rings`` disjoint rings of ``num_nodes`` nodes each, where
+    every node is also joined to the node ``chord`` steps ahead. Call as
+    ``ring_with_chords(num_nodes, chord=7, num_rings=1)``.
+    """
+    return _ring_with_chords
+
+
+@pytest.fixture
+def component_weights():
+    """
+    Returns the node weights of every connected component left after
+    removing ``removed``, one list per component. Call as
+    ``component_weights(data, removed)``.
+    """
+    return _component_weights
+
+
+@pytest.fixture
+def connected_pairs():
+    """
+    Returns the number of node pairs still connected after removing
+    ``removed``: the CNP objective, recounted from scratch. Call as
+    ``connected_pairs(data, removed)``.
+    """
+    return _connected_pairs
+
+
+@pytest.fixture
+def offspring_search():
+    """
+    Builds a CHNS search, with seed 3, on the DBX offspring of two parents
+    spread evenly over the nodes of ``data``. Call as
+    ``offspring_search(data, budget, **params)``; each keyword is passed to
+    ``Search.set_param``.
+    """
+    graphs = []  # A Search does not own its graph; keep them for the test
+
+    def make(data, budget, **params):
+        num_nodes = data.num_nodes()
+        step = num_nodes // budget
+        parents = [
+            set(range(0, num_nodes, step)),
+            set(range(step // 2, num_nodes, step)),
+        ]
+        original = data.create_original_graph("CNP", budget, 3)
+        graphs.append(double_backbone_based_crossover(original, parents, 3))
+
+        search = Search(graphs[-1], 3)
+        search.set_strategy("CHNS")
+        for name, value in params.items():
+            search.set_param(name, value)
+        return search
+
+    return make
@@ -0,0 +1,40 @@
+import pytest
+
+from pycnp import MemeticSearch
+from pycnp._pycnp import Checkpoint
+from pycnp.stop import MaxIterations
+
+
+def test_resumed_search_matches_uninterrupted_run(tmp_path, ring_with_chords):
+    """
+    Test that a run resumed from a checkpoint continues exactly.
+    """
+    data = ring_with_chords(60)
+    path = str(tmp_path / "run.ckpt")
+
+    expected = MemeticSearch(data, "CNP", 6, 3).run(MaxIterations(9))
+
+    first = MemeticSearch(data, "CNP", 6, 3).run(
+        MaxIterations(5), checkpoint_path=path, checkpoint_interval=2
+    )
+    checkpoint = Checkpoint.load(path)
+    assert checkpoint.num_generations == first.num_iterations == 4
+    assert checkpoint.best_obj_value == first.best_obj_value
+    assert checkpoint.best_solution == first.best_solution
+
+    resumed = MemeticSearch(data, "CNP", 6, 3).run(
+        MaxIterations(5), checkpoint_path=path, resume=True
+    )
+    assert resumed.num_iterations == expected.num_iterations
+    assert resumed.best_obj_value == expected.best_obj_value
+    assert resumed.best_solution == expected.best_solution
+
+    with pytest.raises(ValueError):
+        MemeticSearch(data, "CNP", 7, 3).run(
+            MaxIterations(5), checkpoint_path=path, resume=True
+        )
+
+    with open(path, "r+b") as file:
+        file.truncate(48)
+    with pytest.raises(RuntimeError):
+        Checkpoint.load(path)
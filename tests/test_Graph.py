@@ -0,0 +1,47 @@
+import pytest
+
+from pycnp import double_backbone_based_crossover
+
+
+@pytest.mark.parametrize("gain_cache", [True, False])
+@pytest.mark.parametrize("impact_cache", [True, False])
+def test_rollback_restores_checkpoint_state(
+    gain_cache, impact_cache, ring_with_chords, connected_pairs
+):
+    """
+    Test that rolling back several moves returns the removed set and the
+    objective value to their checkpoint state, and leaves the selection
+    caches usable for later moves.
+    """
+    data = ring_with_chords(40)
+    original = data.create_original_graph("CNP", 5, 1)
+    parents = [{0, 8, 16, 24, 32}, {4, 12, 20, 28, 36}]
+    graph = double_backbone_based_crossover(original, parents, 1)
+    graph.set_gain_cache_enabled(gain_cache)
+    graph.set_impact_cache_enabled(impact_cache)
+
+    graph.greedy_select_node_to_add()  # Fills the gain cache
+    removed = graph.get_removed_nodes()
+    obj_value = graph.get_objective_value()
+    assert obj_value == connected_pairs(data, removed)
+
+    graph.checkpoint()
+    for _ in range(4):
+        graph.add_node(graph.greedy_select_node_to_add())
+        graph.remove_node(graph.random_select_node_to_remove())
+    graph.remove_node(graph.random_select_node_to_remove())
+    assert len(graph.get_removed_nodes()) == 6
+    graph.rollback()
+
+    assert graph.get_removed_nodes() == removed
+    assert graph.get_objective_value() == obj_value
+
+    graph.checkpoint()
+    graph.add_node(graph.greedy_select_node_to_add())
+    graph.remove_node(graph.random_select_node_to_remove())
+    graph.commit()
+
+    assert len(graph.get_removed_nodes()) == 5
+    assert graph.get_objective_value() == connected_pairs(
+        data, graph.get_removed_nodes()
+    )
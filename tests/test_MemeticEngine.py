@@ -0,0 +1,207 @@
+import pytest
+
+from pycnp import MemeticSearch, MemeticSearchParams
+from pycnp._pycnp import MemeticEngine
+from pycnp.stop import MaxIterations, MaxRuntime, NoImprovement
+
+
+def test_single_island_matches_memetic_search(ring_with_chords):
+    """
+    Test that one island reproduces the Python generation loop.
+    """
+    data = ring_with_chords(60)
+
+    expected = MemeticSearch(data, "CNP", 6, 3).run(MaxIterations(6))
+    result = MemeticEngine(data, "CNP", 6, 3).run(MaxIterations(6))
+
+    assert result.best_obj_value == expected.best_obj_value
+    assert result.best_solution == expected.best_solution
+    assert result.num_generations == expected.num_iterations
+    assert expected.num_search_steps > 0
+
+
+def test_offspring_batches_match_memetic_search(ring_with_chords):
+    """
+    Test that batched generations agree between Python and C++.
+    """
+    data = ring_with_chords(60)
+    params = MemeticSearchParams(num_offspring=3)
+
+    expected = MemeticSearch(data, "CNP", 6, 3, params).run(MaxIterations(5))
+    engine = MemeticEngine(data, "CNP", 6, 3, num_offspring=3)
+    result = engine.run(MaxIterations(5))
+
+    assert result.best_obj_value == expected.best_obj_value
+    assert result.best_solution == expected.best_solution
+
+
+def test_islands_return_feasible_solution(ring_with_chords):
+    """
+    Test that several migrating islands return a solution within budget.
+    """
+    data = ring_with_chords(60)
+    engine = MemeticEngine(
+        data, "CNP", 6, 3, num_islands=3, migration_interval=2
+    )
+
+    result = engine.run(MaxIterations(20))
+
+    assert len(result.best_solution) == 6
+    assert result.num_generations == 19
+
+
+def test_invalid_island_count_raises(ring_with_chords):
+    """
+    Test error handling for a non-positive number of islands.
+    """
+    data = ring_with_chords(10)
+
+    with pytest.raises(ValueError):
+        MemeticEngine(data, "CNP", 2, 1, num_islands=0)
+
+
+@pytest.mark.parametrize(
+    "problem_type, kwargs",
+    [
+        ("CNP", dict(crossover="DBX", initial_pop_size=1)),
+        ("CNP", dict(crossover="RSC", initial_pop_size=1)),
+        ("CNP", dict(crossover="IRR", initial_pop_size=3, is_pop_variable=False)),
+        ("DCNP", dict(search="BCLS", crossover="IRR", initial_pop_size=3)),
+        (
+            "DCNP",
+            dict(
+                search="BCLS",
+                crossover="IRR",
+                initial_pop_size=4,
+                is_pop_variable=False,
+            ),
+        ),
+    ],
+)
+def test_invalid_population_for_crossover_raises(
+    problem_type, kwargs, ring_with_chords
+):
+    """
+    Test that population sizes the crossover cannot select from are
+    rejected up front, as in MemeticSearch.
+    """
+    data = ring_with_chords(10)
+
+    with pytest.raises(ValueError):
+        MemeticEngine(data, problem_type, 2, 1, **kwargs)
+
+
+@pytest.mark.parametrize(
+    "problem_type, kwargs",
+    [
+        ("DCNP", dict()),
+        ("DCNP", dict(search="BCLS", reduce_search="CHNS")),
+        ("CNP", dict(search="BCLS")),
+        ("WCNP", dict(reduce_search="BCLS")),
+    ],
+)
+def test_search_unsupported_by_problem_type_raises(
+    problem_type, kwargs, ring_with_chords
+):
+    """
+    Test that a search the problem type cannot run is rejected up front,
+    rather than failing once the islands start searching.
+    """
+    data = ring_with_chords(10)
+
+    with pytest.raises(ValueError):
+        MemeticEngine(data, problem_type, 2, 1, **kwargs)
+
+
+def test_dcnp_engine_with_bcls_returns_feasible_solution(ring_with_chords):
+    """
+    Test that a DCNP engine configured with BCLS runs.
+    """
+    data = ring_with_chords(30)
+    engine = MemeticEngine(
+        data, "DCNP", 3, 3, search="BCLS", reduce_search="BCLS", hop_distance=2
+    )
+
+    result = engine.run(MaxIterations(3))
+
+    assert len(result.best_solution) == 3
+
+
+def test_tabu_archive_returns_feasible_solution(ring_with_chords):
+    """
+    Test that skipping archived offspring still yields a valid solution.
+    """
+    data = ring_with_chords(60)
+    engine = MemeticEngine(
+        data, "CNP", 6, 3, num_offspring=3, tabu_archive_size=50
+    )
+
+    result = engine.run(MaxIterations(6))
+
+    assert len(result.best_solution) == 6
+
+
+def test_search_cache_counts_offspring_searches(ring_with_chords):
+    """
+    Test that every offspring search is counted as a cache hit or miss.
+    """
+    data = ring_with_chords(60)
+    engine = MemeticEngine(data, "CNP", 6, 3, search_cache_size=50)
+
+    result = engine.run(MaxIterations(6))
+
+    assert result.search_cache_hits + result.search_cache_misses == 5
+    assert len(result.best_solution) == 6
+
+
+def test_time_limit_stops_engine(ring_with_chords):
+    """
+    Test that the engine time limit ends a run the criterion would not stop.
+    """
+    data = ring_with_chords(60)
+    engine = MemeticEngine(data, "CNP", 6, 3, time_limit=0.2)
+
+    result = engine.run(NoImprovement(10**9))
+
+    assert result.runtime < 5
+    assert len(result.best_solution) == 6
+
+
+def test_time_limit_bounds_population_initialization(ring_with_chords):
+    """
+    Test that the time limit also stops the searches of the initial
+    population, when initializing alone takes longer than the limit.
+    Runs are compared to a full initialization rather than to a fixed
+    wall-clock bound, so that slow machines do not fail the test.
+    """
+    data = ring_with_chords(2000)
+    params = MemeticSearchParams(initial_pop_size=10)
+
+    # MaxIterations(1) stops right after the initial population is built.
+    unbounded = MemeticEngine(data, "CNP", 200, 3, initial_pop_size=10)
+    full = unbounded.run(MaxIterations(1))
+
+    engine = MemeticEngine(data, "CNP", 200, 3, initial_pop_size=10, time_limit=0.05)
+    result = engine.run(NoImprovement(10**9))
+    assert result.runtime < full.runtime / 2
+    assert len(result.best_solution) == 200
+
+    full = MemeticSearch(data, "CNP", 200, 3, params).run(MaxIterations(1))
+    result = MemeticSearch(data, "CNP", 200, 3, params).run(MaxRuntime(0.05))
+    assert result.runtime < full.runtime / 2
+    assert len(result.best_solution) == 200
+
+
+def test_sharded_engine_returns_feasible_solution(ring_with_chords, connected_pairs):
+    """
+    Test that an engine searching offspring in shards returns a feasible
+    solution with its exact objective value.
+    """
+    budget = 12
+    data = ring_with_chords(30, num_rings=4)
+
+    engine = MemeticEngine(data, "CNP", budget, 3, num_shards=4)
+    result = engine.run(MaxIterations(4))
+
+    assert len(result.best_solution) == budget
+    assert result.best_obj_value == connected_pairs(data, result.best_solution)
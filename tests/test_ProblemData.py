@@ -0,0 +1,130 @@
+from concurrent.futures import ThreadPoolExecutor
+
+import pytest
+
+from pycnp._pycnp import ProblemData, Search
+
+
+@pytest.mark.parametrize("storage", ["dense", "bitset", "sparse"])
+def test_tree_storage_matches_auto(storage, ring_with_chords):
+    """
+    Test that every K-hop tree storage yields the same DCNP search result.
+    """
+    data = ring_with_chords(30, chord=5)
+
+    results = []
+    for tree_storage in ("auto", storage):
+        graph = data.create_original_graph("DCNP", 3, 1, 2, tree_storage)
+        search = Search(graph, 1)
+        search.set_strategy("BCLS")
+        results.append(search.run())
+
+    assert results[0].obj_value == results[1].obj_value
+    assert results[0].solution == results[1].solution
+
+
+def test_invalid_tree_storage_raises(ring_with_chords):
+    """
+    Test error handling for an unknown K-hop tree storage name.
+    """
+    data = ring_with_chords(10, chord=5)
+
+    with pytest.raises(ValueError):
+        data.create_original_graph("DCNP", 2, 1, 2, "compressed")
+
+
+def test_concurrent_searches_match_serial(ring_with_chords):
+    """
+    Test that searches run from several Python threads on graphs of one
+    ProblemData give the same results as running them one after another.
+    """
+    data = ring_with_chords(40, chord=5)
+
+    def solve(seed):
+        graph = data.create_original_graph("CNP", 5, seed)
+        search = Search(graph, seed)
+        search.set_strategy("CHNS")
+        result = search.run()
+        return result.obj_value, result.solution
+
+    seeds = range(1, 9)
+    serial = [solve(seed) for seed in seeds]
+    with ThreadPoolExecutor(max_workers=4) as executor:
+        concurrent = list(executor.map(solve, seeds))
+
+    assert concurrent == serial
+
+
+@pytest.mark.parametrize("strategy", ["CBNS", "CHNS", "DLAS"])
+def test_kernelized_search_objective_is_exact(strategy, connected_pairs):
+    """
+    Test that a CNP search on the kernel reports the objective value of its
+    solution on the full graph, and never removes a folded leaf.
+    """
+    data = ProblemData(45)
+    for node in range(45):
+        data.add_node(node)
+    for node in range(30):
+        data.add_edge(node, (node + 1) % 30)
+        data.add_edge(node, (node + 5) % 30)
+    for leaf in range(30, 45):
+        data.add_edge(leaf, leaf - 30)
+
+    graph = data.create_original_graph("CNP", 5, 1, kernelize=True)
+    search = Search(graph, 1)
+    search.set_strategy(strategy)
+    result = search.run()
+
+    assert len(result.solution) == 5
+    assert all(node < 30 for node in result.solution)
+    assert result.obj_value == connected_pairs(data, result.solution)
+
+
+_OBJECTIVES = {
+    "WCNP": lambda comps: sum(
+        (sum(w) ** 2 - sum(x * x for x in w)) // 2 for w in comps
+    ),
+    "MINMAXC": lambda comps: max((len(w) for w in comps), default=0),
+    "MAXNUM": lambda comps: 40 - len(comps),
+}
+
+
+@pytest.mark.parametrize("problem_type", sorted(_OBJECTIVES))
+@pytest.mark.parametrize("strategy", ["CBNS", "CHNS", "DLAS"])
+def test_objective_variants_match_recount(
+    problem_type, strategy, ring_with_chords, component_weights
+):
+    """
+    Test that searches on the CNP objective variants report the objective of
+    their solution, recounted from its components.
+    """
+    data = ring_with_chords(40, chord=5)
+    for node in range(40):
+        data.add_node_weight(node, 1 + node % 4)
+
+    graph = data.create_original_graph(problem_type, 5, 1)
+    search = Search(graph, 1)
+    search.set_strategy(strategy)
+    result = search.run()
+
+    components = component_weights(data, result.solution)
+    assert len(result.solution) == 5
+    assert result.obj_value == _OBJECTIVES[problem_type](components)
+
+
+def test_node_weights_default_to_one(ring_with_chords):
+    """
+    Test that unset node weights read as one and invalid weights are
+    rejected.
+    """
+    data = ring_with_chords(10, chord=5)
+    assert data.get_node_weight(3) == 1
+
+    data.add_node_weight(3, 7)
+    assert data.get_node_weight(3) == 7
+    assert data.get_node_weight(4) == 1
+
+    with pytest.raises(ValueError):
+        data.add_node_weight(3, -1)
+    with pytest.raises(ValueError):
+        data.add_node_weight(10, 1)
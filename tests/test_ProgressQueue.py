@@ -0,0 +1,40 @@
+from pycnp._pycnp import MemeticEngine, ProgressQueue
+from pycnp.stop import MaxIterations
+
+
+def test_engine_streams_improvements(ring_with_chords):
+    """
+    Test that an engine run publishes every new best solution in order.
+    """
+    data = ring_with_chords(60)
+    queue = ProgressQueue()
+    result = MemeticEngine(data, "CNP", 6, 3).run(MaxIterations(6), queue)
+
+    events = queue.drain()
+    values = [event.obj_value for event in events]
+    assert values == sorted(values, reverse=True)
+    assert len(set(values)) == len(values)
+    assert values[-1] == result.best_obj_value
+    assert queue.best() == (result.best_solution, result.best_obj_value)
+    assert queue.drain() == []
+
+
+def test_search_keeps_best_when_queue_is_full(ring_with_chords, offspring_search):
+    """
+    Test that a search publishes improvements in order into a small queue,
+    and that the best solution survives dropped events.
+    """
+    data = ring_with_chords(60)
+    queue = ProgressQueue(capacity=2)
+    result = offspring_search(data, 6, progressQueue=queue).run()
+
+    events = queue.drain(max_events=1)
+    events += queue.drain()
+    values = [event.obj_value for event in events]
+    assert len(events) <= 2
+    assert values == sorted(values, reverse=True)
+    if queue.best() is None:
+        assert not events and queue.dropped == 0
+    else:
+        # The best solution is kept even when its event was dropped.
+        assert queue.best() == (result.solution, result.obj_value)
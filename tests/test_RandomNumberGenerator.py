@@ -0,0 +1,17 @@
+from pycnp._pycnp import RandomNumberGenerator
+
+
+def test_seed_streams_are_deterministic_and_distinct():
+    """
+    Test that split streams repeat for a seed and differ from each other
+    and from their parent.
+    """
+    first, second = RandomNumberGenerator(5), RandomNumberGenerator(5)
+    streams = [first.split(), first.split()]
+    replay = [second.split(), second.split()]
+
+    draws = [[stream.next_seed() for _ in range(20)] for stream in streams]
+    assert draws == [[stream.next_seed() for _ in range(20)] for stream in replay]
+    assert draws[0] != draws[1]
+    assert draws[0] != [first.next_seed() for _ in range(20)]
+    assert all(seed > 0 for seed in draws[0] + draws[1])
@@ -12,6 +12,7 @@ def test_result_init():
     assert res.best_obj_value == math.inf
     assert res.num_iterations == 0
     assert res.runtime == 0.0
+    assert res.num_search_steps == 0
 
 
 def test_result_valid_values():
@@ -0,0 +1,36 @@
+from pycnp._pycnp import CancelToken
+
+
+def test_search_budget_interrupts_search(ring_with_chords, offspring_search):
+    """
+    Test that step limits and cancel tokens stop a local search early.
+    """
+    data = ring_with_chords(60)
+
+    result = offspring_search(data, 6, maxSteps=5).run()
+
+    assert result.interrupted
+    assert result.num_steps == 5
+
+    token = CancelToken()
+    token.cancel()
+    result = offspring_search(data, 6, cancelToken=token).run()
+
+    assert result.interrupted
+    assert result.num_steps == 0
+
+
+def test_sharded_search_returns_feasible_solution(
+    ring_with_chords, connected_pairs, offspring_search
+):
+    """
+    Test that a search split over the components of a disconnected graph
+    returns a feasible solution with its exact objective value.
+    """
+    budget = 12
+    data = ring_with_chords(30, num_rings=4)
+
+    result = offspring_search(data, budget, numShards=4).run()
+
+    assert len(result.solution) == budget
+    assert result.obj_value == connected_pairs(data, result.solution)
@@ -0,0 +1,22 @@
+from pycnp._pycnp import TRACING_ENABLED, MemeticEngine, get_metrics, reset_metrics
+from pycnp.stop import MaxIterations
+
+
+def test_metrics_follow_tracing_build_option(ring_with_chords):
+    """
+    Test that metrics count engine work only when tracing is compiled in.
+    """
+    data = ring_with_chords(60)
+    reset_metrics()
+
+    MemeticEngine(data, "CNP", 6, 3).run(MaxIterations(4))
+    metrics = get_metrics()
+
+    assert metrics["enabled"] == TRACING_ENABLED
+    assert set(metrics["phases"]["CHNS"]) == {"calls", "seconds"}
+    if TRACING_ENABLED:
+        assert metrics["counters"]["node_removals"] > 0
+        assert metrics["phases"]["crossover"]["calls"] > 0
+    else:
+        assert not any(metrics["counters"].values())
+        assert metrics["events"] == []
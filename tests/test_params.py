@@ -13,6 +13,8 @@ class TestMemeticSearchParams:
         assert params.is_problem_reduction is True
         assert params.is_pop_variable is True
         assert params.initial_pop_size == 5
+        assert params.num_offspring == 1
+        assert params.search_cache_size == 0
         assert params.reduce_params == {"search": "CHNS", "beta": 0.9}
 
     def test_custom_search(self):
@@ -1,7 +1,9 @@
+import gzip
+
 import pytest
 
 from pycnp import read
-from pycnp._pycnp import ProblemData
+from pycnp._pycnp import ProblemData, Search
 
 
 def test_read_adjacency_list(tmp_path):
@@ -37,6 +39,47 @@ def test_read_edge_list(tmp_path):
     assert isinstance(data, ProblemData)
 
 
+def test_read_plain_edge_list(tmp_path):
+    """
+    Test reading a SNAP-style whitespace edge list with comments.
+    """
+    content = "# comment\n0\t1\n1 2 0.5\n2 0\n"
+    graph_file = tmp_path / "graph.txt"
+    graph_file.write_text(content, encoding="utf-8")
+
+    data = read(str(graph_file.resolve()))
+    assert data.num_nodes() == 3
+    assert data.get_adj_list() == [{1, 2}, {0, 2}, {0, 1}]
+
+
+def test_read_gzip_matches_plain(tmp_path):
+    """
+    Test that a gzip-compressed file loads like the uncompressed one.
+    """
+    content = "p edge 3 2\ne 0 1\ne 1 2\n"
+    graph_file = tmp_path / "graph.txt.gz"
+    graph_file.write_bytes(gzip.compress(content.encode("utf-8")))
+
+    try:
+        data = read(str(graph_file.resolve()))
+    except RuntimeError as e:
+        if "gzip support" in str(e):
+            pytest.skip("built without zlib")
+        raise
+    assert data.get_adj_list() == [{1}, {0, 2}, {1}]
+
+
+def test_read_out_of_range_node_raises(tmp_path):
+    """
+    Test error handling for node ids outside the declared range.
+    """
+    graph_file = tmp_path / "graph.txt"
+    graph_file.write_text("p edge 2 1\ne 0 5\n", encoding="utf-8")
+
+    with pytest.raises(RuntimeError):
+        read(str(graph_file.resolve()))
+
+
 def test_file_not_found():
     """
     Test error handling for missing file.
@@ -44,3 +87,77 @@ def test_file_not_found():
     # Use a clearly non-existent absolute path
     with pytest.raises(FileNotFoundError):
         read("/non/existent/file.txt")
+
+
+def test_binary_round_trip(tmp_path):
+    """
+    Test that a binary file reloads the same graph, through read as well.
+    """
+    data = ProblemData(4)
+    for node in range(4):
+        data.add_node(node)
+    for u, v in [(0, 1), (1, 2), (2, 3)]:
+        data.add_edge(u, v)
+
+    binary_file = tmp_path / "graph.pycnp"
+    data.save_binary(str(binary_file), hop_distance=2)
+
+    for loaded in (ProblemData.load_binary(str(binary_file)),
+                   read(str(binary_file.resolve()))):
+        assert loaded.num_nodes() == 4
+        assert loaded.get_nodes_set() == {0, 1, 2, 3}
+        assert loaded.get_adj_list() == data.get_adj_list()
+
+        results = []
+        for problem_data in (loaded, data):
+            graph = problem_data.create_original_graph("DCNP", 1, 0, 2)
+            search = Search(graph, 1)
+            search.set_strategy("BCLS")
+            results.append(search.run())
+        assert results[0].obj_value == results[1].obj_value
+        assert results[0].solution == results[1].solution
+
+
+def test_binary_round_trip_keeps_node_weights(tmp_path):
+    """
+    Test that a binary file keeps the node weights of the WCNP objective.
+    """
+    data = ProblemData(4)
+    for node in range(4):
+        data.add_node(node)
+    for u, v in [(0, 1), (1, 2), (2, 3)]:
+        data.add_edge(u, v)
+    data.add_node_weight(0, 5)
+    data.add_node_weight(3, 2)
+
+    binary_file = tmp_path / "graph.pycnp"
+    data.save_binary(str(binary_file))
+    loaded = ProblemData.load_binary(str(binary_file))
+
+    assert [loaded.get_node_weight(node) for node in range(4)] == [5, 1, 1, 2]
+
+    results = []
+    for problem_data in (loaded, data):
+        graph = problem_data.create_original_graph("WCNP", 1, 0)
+        search = Search(graph, 1)
+        search.set_strategy("CHNS")
+        results.append(search.run())
+    assert results[0].obj_value == results[1].obj_value
+    assert results[0].solution == results[1].solution
+
+
+def test_binary_truncated_raises(tmp_path):
+    """
+    Test that a truncated binary file is rejected.
+    """
+    data = ProblemData(2)
+    data.add_node(0)
+    data.add_node(1)
+    data.add_edge(0, 1)
+
+    binary_file = tmp_path / "graph.pycnp"
+    data.save_binary(str(binary_file))
+    binary_file.write_bytes(binary_file.read_bytes()[:40])
+
+    with pytest.raises(RuntimeError):
+        ProblemData.load_binary(str(binary_file))